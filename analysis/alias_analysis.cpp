@@ -0,0 +1,143 @@
+#include "analysis/alias_analysis.h"
+#include "ir/graph.h"
+#include "ir/instructions.h"
+
+#include <cstdlib>
+
+namespace compiler {
+
+[[maybe_unused]] static bool IsArrayAccess(const Instruction *insn)
+{
+    return insn->GetOpcode() == Opcode::LOADARRAY || insn->GetOpcode() == Opcode::STOREARRAY;
+}
+
+// Checks return their input, so the checked value is the same array or index.
+static const Instruction *SkipChecks(const Instruction *insn)
+{
+    while (insn->GetOpcode() == Opcode::NULLCHECK || insn->GetOpcode() == Opcode::BOUNDSCHECK) {
+        insn = insn->GetInput(insn->GetOpcode() == Opcode::NULLCHECK ? 0 : 1);
+    }
+    return insn;
+}
+
+// Narrow values wrap around after small offsets.
+static bool IsWideInteger(DataType type)
+{
+    return type == DataType::I32 || type == DataType::U32 || type == DataType::I64 || type == DataType::U64;
+}
+
+static bool GetIntConstant(const Instruction *insn, int64_t *value)
+{
+    if (!insn->IsConst() || (!insn->AsConst()->IsSignedInt() && !insn->AsConst()->IsUnsignedInt())) {
+        return false;
+    }
+    *value = insn->AsConst()->GetAsI64();
+    return true;
+}
+
+AliasResult AliasAnalysis::CheckAlias(const Instruction *lhs, const Instruction *rhs) const
+{
+    assert(IsArrayAccess(lhs) && IsArrayAccess(rhs));
+    if (lhs->GetResultType() != rhs->GetResultType()) {
+        return AliasResult::NO_ALIAS;
+    }
+    auto arrays = CheckArrays(lhs->GetInput(0), rhs->GetInput(0));
+    if (arrays == AliasResult::NO_ALIAS) {
+        return AliasResult::NO_ALIAS;
+    }
+    auto indices = CheckIndices(lhs, rhs);
+    if (indices == AliasResult::NO_ALIAS) {
+        return AliasResult::NO_ALIAS;
+    }
+    return (arrays == AliasResult::MUST_ALIAS && indices == AliasResult::MUST_ALIAS) ? AliasResult::MUST_ALIAS
+                                                                                    : AliasResult::MAY_ALIAS;
+}
+
+// A fresh array may still be stored somewhere and loaded back, so it differs only from other allocations
+// and from parameters.
+AliasResult AliasAnalysis::CheckArrays(const Instruction *lhs, const Instruction *rhs) const
+{
+    lhs = SkipChecks(lhs);
+    rhs = SkipChecks(rhs);
+    if (lhs == rhs) {
+        return AliasResult::MUST_ALIAS;
+    }
+    auto isParameter = [](const Instruction *insn) { return insn->GetOpcode() == Opcode::PARAMETER; };
+    auto isAllocation = [](const Instruction *insn) { return insn->GetOpcode() == Opcode::NEWARR; };
+    if ((isAllocation(lhs) || isParameter(lhs)) && (isAllocation(rhs) || isParameter(rhs))) {
+        return AliasResult::NO_ALIAS;
+    }
+    return AliasResult::MAY_ALIAS;
+}
+
+// Relations between induction variables hold only within an iteration, so they are used for accesses in the loop.
+AliasAnalysis::AffineIndex AliasAnalysis::DecomposeIndex(const Instruction *access) const
+{
+    const auto *index = access->GetInput(1);
+    int64_t offset = 0;
+    for (index = SkipChecks(index);; index = SkipChecks(index)) {
+        int64_t constant = 0;
+        if (GetIntConstant(index, &constant)) {
+            if (__builtin_add_overflow(offset, constant, &constant)) {
+                break;
+            }
+            return {nullptr, 0, constant};
+        }
+
+        if (!IsWideInteger(index->GetResultType())) {
+            break;
+        }
+        const auto *loop = index->GetParentBB()->GetLoop();
+        const auto *variable = (loop == nullptr) ? nullptr : loop->GetInductionVariable(index);
+        if (variable != nullptr && loop->Contains(access->GetParentBB())) {
+            int64_t variableOffset = 0;
+            if (__builtin_add_overflow(offset, variable->offset, &variableOffset)) {
+                break;
+            }
+            return {variable->basis, variable->scale, variableOffset};
+        }
+
+        auto opcode = index->GetOpcode();
+        if (opcode != Opcode::ADD && opcode != Opcode::SUB) {
+            break;
+        }
+        bool isFirstConstant = opcode == Opcode::ADD && GetIntConstant(index->GetInput(0), &constant);
+        if (!isFirstConstant && !GetIntConstant(index->GetInput(1), &constant)) {
+            break;
+        }
+        // After leaving a loop its values may be one iteration ahead of the sums computed from them.
+        const auto *input = index->GetInput(isFirstConstant ? 1 : 0);
+        const auto *inputLoop = input->GetParentBB()->GetLoop();
+        if (inputLoop != nullptr && !inputLoop->Contains(access->GetParentBB())) {
+            break;
+        }
+        if (opcode == Opcode::SUB ? __builtin_sub_overflow(offset, constant, &offset)
+                                  : __builtin_add_overflow(offset, constant, &offset)) {
+            break;
+        }
+        index = input;
+    }
+    return {index, 1, offset};
+}
+
+// Values of different offsets stay different after wrapping around in 32 or 64 bits.
+AliasResult AliasAnalysis::CheckIndices(const Instruction *lhsAccess, const Instruction *rhsAccess) const
+{
+    constexpr int64_t MAX_DISTANCE = INT32_MAX;
+
+    auto lhsIndex = DecomposeIndex(lhsAccess);
+    auto rhsIndex = DecomposeIndex(rhsAccess);
+    if (lhsIndex.basis != rhsIndex.basis || lhsIndex.scale != rhsIndex.scale) {
+        return AliasResult::MAY_ALIAS;
+    }
+    if (lhsIndex.offset == rhsIndex.offset) {
+        return AliasResult::MUST_ALIAS;
+    }
+    int64_t distance = 0;
+    if (__builtin_sub_overflow(lhsIndex.offset, rhsIndex.offset, &distance) || std::abs(distance) > MAX_DISTANCE) {
+        return AliasResult::MAY_ALIAS;
+    }
+    return AliasResult::NO_ALIAS;
+}
+
+}  // namespace compiler
@@ -0,0 +1,47 @@
+#ifndef ANALYSIS_ALIAS_ANALYSIS_H
+#define ANALYSIS_ALIAS_ANALYSIS_H
+
+#include "utils/macros.h"
+
+#include <cstdint>
+
+namespace compiler {
+
+class Instruction;
+
+enum class AliasResult : uint8_t { NO_ALIAS, MAY_ALIAS, MUST_ALIAS };
+
+// Disambiguates pairs of LoadArray and StoreArray accesses executed with the same values of their operands,
+// e.g. in one iteration of a loop; dependences between iterations are not answered.
+//
+// Accesses of different element types touch different arrays. Distinct allocation sites are distinct arrays,
+// and a fresh array differs from the parameters; reference parameters are assumed not to alias each other.
+// Indices are compared as `scale * basis + offset` with constant scale and offset, found through
+// additions of constants and induction variables.
+class AliasAnalysis final {
+public:
+    NO_COPY_SEMANTIC(AliasAnalysis);
+    NO_MOVE_SEMANTIC(AliasAnalysis);
+
+    AliasAnalysis() = default;
+    ~AliasAnalysis() = default;
+
+    // Induction variables of the graph must be valid.
+    AliasResult CheckAlias(const Instruction *lhs, const Instruction *rhs) const;
+
+private:
+    struct AffineIndex {
+        // Null for constant indices.
+        const Instruction *basis {nullptr};
+        int64_t scale {0};
+        int64_t offset {0};
+    };
+
+    AffineIndex DecomposeIndex(const Instruction *access) const;
+    AliasResult CheckArrays(const Instruction *lhs, const Instruction *rhs) const;
+    AliasResult CheckIndices(const Instruction *lhsAccess, const Instruction *rhsAccess) const;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_ALIAS_ANALYSIS_H
@@ -0,0 +1,145 @@
+#include "analysis/analysis_manager.h"
+#include "analysis/alias_analysis.h"
+#include "analysis/block_frequency.h"
+#include "analysis/control_dependence.h"
+#include "analysis/dominator_tree.h"
+#include "analysis/escape_analysis.h"
+#include "analysis/induction_analysis.h"
+#include "analysis/liveness.h"
+#include "analysis/loop_analyzer.h"
+#include "analysis/post_dominator_tree.h"
+#include "analysis/range_analysis.h"
+#include "ir/graph.h"
+
+namespace compiler {
+
+AnalysisManager::AnalysisManager(Graph *graph) : graph_(graph) {}
+
+AnalysisManager::~AnalysisManager() = default;
+
+void AnalysisManager::Run(AnalysisType type)
+{
+    if (IsValid(type)) {
+        return;
+    }
+
+    auto &dependencies = DEPENDENCIES[static_cast<size_t>(type)];
+    for (size_t idx = 0; idx < static_cast<size_t>(type); ++idx) {
+        auto dependency = static_cast<AnalysisType>(idx);
+        if (dependencies.Contains(dependency)) {
+            Run(dependency);
+        }
+    }
+
+    Compute(type);
+    valid_.Add(type);
+    ++runsCount_[static_cast<size_t>(type)];
+}
+
+const PostDominatorTree &AnalysisManager::GetPostDominatorTree()
+{
+    Run(AnalysisType::POST_DOMINATOR_TREE);
+    return *postDomTree_;
+}
+
+const ControlDependence &AnalysisManager::GetControlDependence()
+{
+    Run(AnalysisType::CONTROL_DEPENDENCE);
+    return *controlDependence_;
+}
+
+const Liveness &AnalysisManager::GetLiveness()
+{
+    Run(AnalysisType::LIVENESS);
+    return *liveness_;
+}
+
+const RangeAnalysis &AnalysisManager::GetRangeAnalysis()
+{
+    Run(AnalysisType::VALUE_RANGES);
+    return *rangeAnalysis_;
+}
+
+const AliasAnalysis &AnalysisManager::GetAliasAnalysis()
+{
+    Run(AnalysisType::INDUCTION_VARIABLES);
+    if (aliasAnalysis_ == nullptr) {
+        aliasAnalysis_ = std::make_unique<AliasAnalysis>();
+    }
+    return *aliasAnalysis_;
+}
+
+const EscapeAnalysis &AnalysisManager::GetEscapeAnalysis()
+{
+    Run(AnalysisType::ESCAPE_STATES);
+    return *escapeAnalysis_;
+}
+
+const BlockFrequency &AnalysisManager::GetBlockFrequency()
+{
+    Run(AnalysisType::BLOCK_FREQUENCY);
+    return *blockFrequency_;
+}
+
+void AnalysisManager::Invalidate(AnalysisSet preserved)
+{
+    // Dependencies precede dependent analyses, so one pass in order of types is enough.
+    for (size_t idx = 0; idx < ANALYSES_COUNT; ++idx) {
+        auto type = static_cast<AnalysisType>(idx);
+        if (!preserved.Contains(type) || !valid_.Contains(DEPENDENCIES[idx])) {
+            valid_.Remove(type);
+        }
+    }
+}
+
+void AnalysisManager::Compute(AnalysisType type)
+{
+    switch (type) {
+        case AnalysisType::RPO:
+            graph_->RunRpo();
+            break;
+        case AnalysisType::DOMINATOR_TREE: {
+            DominatorTree tree(graph_);
+            tree.Build();
+            break;
+        }
+        case AnalysisType::LOOP_TREE: {
+            LoopAnalyzer loopAnalyzer(graph_);
+            loopAnalyzer.Run();
+            break;
+        }
+        case AnalysisType::POST_DOMINATOR_TREE:
+            postDomTree_ = std::make_unique<PostDominatorTree>(graph_);
+            postDomTree_->Build();
+            break;
+        case AnalysisType::CONTROL_DEPENDENCE:
+            controlDependence_ = std::make_unique<ControlDependence>(graph_, postDomTree_.get());
+            controlDependence_->Build();
+            break;
+        case AnalysisType::LIVENESS:
+            liveness_ = std::make_unique<Liveness>(graph_);
+            liveness_->Run();
+            break;
+        case AnalysisType::VALUE_RANGES:
+            rangeAnalysis_ = std::make_unique<RangeAnalysis>(graph_);
+            rangeAnalysis_->Run();
+            break;
+        case AnalysisType::INDUCTION_VARIABLES: {
+            InductionAnalysis inductionAnalysis(graph_);
+            inductionAnalysis.Run();
+            break;
+        }
+        case AnalysisType::ESCAPE_STATES:
+            escapeAnalysis_ = std::make_unique<EscapeAnalysis>(graph_);
+            escapeAnalysis_->Run();
+            break;
+        case AnalysisType::BLOCK_FREQUENCY:
+            blockFrequency_ = std::make_unique<BlockFrequency>(graph_);
+            blockFrequency_->Run();
+            break;
+        default:
+            UNREACHABLE();
+    }
+}
+
+}  // namespace compiler
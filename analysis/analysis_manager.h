@@ -0,0 +1,164 @@
+#ifndef ANALYSIS_ANALYSIS_MANAGER_H
+#define ANALYSIS_ANALYSIS_MANAGER_H
+
+#include "utils/macros.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+
+namespace compiler {
+
+class Graph;
+class PostDominatorTree;
+class ControlDependence;
+class Liveness;
+class RangeAnalysis;
+class AliasAnalysis;
+class EscapeAnalysis;
+class BlockFrequency;
+
+// Analyses cached by the graph. An analysis must follow all analyses it depends on.
+enum class AnalysisType : uint8_t {
+    RPO,
+    DOMINATOR_TREE,
+    LOOP_TREE,
+    POST_DOMINATOR_TREE,
+    CONTROL_DEPENDENCE,
+    LIVENESS,
+    VALUE_RANGES,
+    INDUCTION_VARIABLES,
+    ESCAPE_STATES,
+    BLOCK_FREQUENCY,
+    COUNT
+};
+
+constexpr size_t ANALYSES_COUNT = static_cast<size_t>(AnalysisType::COUNT);
+
+class AnalysisSet final {
+public:
+    constexpr AnalysisSet() = default;
+    constexpr AnalysisSet(std::initializer_list<AnalysisType> analyses)
+    {
+        for (auto type : analyses) {
+            Add(type);
+        }
+    }
+
+    static constexpr AnalysisSet All()
+    {
+        AnalysisSet set;
+        set.mask_ = (1U << ANALYSES_COUNT) - 1U;
+        return set;
+    }
+
+    constexpr void Add(AnalysisType type)
+    {
+        mask_ |= GetBit(type);
+    }
+
+    constexpr void Remove(AnalysisType type)
+    {
+        mask_ &= ~GetBit(type);
+    }
+
+    constexpr bool Contains(AnalysisType type) const
+    {
+        return (mask_ & GetBit(type)) != 0;
+    }
+
+    // Whether all analyses of `other` are in this set.
+    constexpr bool Contains(AnalysisSet other) const
+    {
+        return (mask_ & other.mask_) == other.mask_;
+    }
+
+private:
+    static constexpr uint32_t GetBit(AnalysisType type)
+    {
+        return 1U << static_cast<uint32_t>(type);
+    }
+
+private:
+    uint32_t mask_ {0};
+};
+
+// Analyses which depend only on CFG, passes which don't change it preserve them.
+constexpr AnalysisSet CFG_ANALYSES {AnalysisType::RPO, AnalysisType::DOMINATOR_TREE, AnalysisType::LOOP_TREE,
+                                    AnalysisType::POST_DOMINATOR_TREE, AnalysisType::CONTROL_DEPENDENCE,
+                                    AnalysisType::BLOCK_FREQUENCY};
+
+// Lazily computes analyses of the graph and keeps them until a pass invalidates them.
+// Passes declare analyses they preserve, everything else (and whatever depends on it) is recomputed on demand.
+// Direct CFG modifications outside of passes must be followed by Invalidate().
+class AnalysisManager final {
+public:
+    NO_COPY_SEMANTIC(AnalysisManager);
+    NO_MOVE_SEMANTIC(AnalysisManager);
+
+    explicit AnalysisManager(Graph *graph);
+    ~AnalysisManager();
+
+    // Computes the analysis and its dependencies unless they are valid.
+    void Run(AnalysisType type);
+
+    bool IsValid(AnalysisType type) const
+    {
+        return valid_.Contains(type);
+    }
+
+    // Analyses kept outside of IR objects, the result is computed on demand.
+    const PostDominatorTree &GetPostDominatorTree();
+    const ControlDependence &GetControlDependence();
+    const Liveness &GetLiveness();
+    const RangeAnalysis &GetRangeAnalysis();
+    // Stateless queries which read induction variables, the getter makes them valid.
+    const AliasAnalysis &GetAliasAnalysis();
+    const EscapeAnalysis &GetEscapeAnalysis();
+    const BlockFrequency &GetBlockFrequency();
+
+    // Drops all analyses which are not preserved.
+    void Invalidate(AnalysisSet preserved = {});
+
+    // How many times the analysis was computed, for statistics.
+    size_t GetRunsCount(AnalysisType type) const
+    {
+        return runsCount_[static_cast<size_t>(type)];
+    }
+
+private:
+    void Compute(AnalysisType type);
+
+    static constexpr std::array<AnalysisSet, ANALYSES_COUNT> DEPENDENCIES {
+        AnalysisSet {},
+        AnalysisSet {AnalysisType::RPO},
+        AnalysisSet {AnalysisType::RPO, AnalysisType::DOMINATOR_TREE},
+        AnalysisSet {},
+        AnalysisSet {AnalysisType::POST_DOMINATOR_TREE},
+        AnalysisSet {AnalysisType::RPO, AnalysisType::DOMINATOR_TREE, AnalysisType::LOOP_TREE},
+        AnalysisSet {AnalysisType::RPO, AnalysisType::DOMINATOR_TREE},
+        AnalysisSet {AnalysisType::RPO, AnalysisType::DOMINATOR_TREE, AnalysisType::LOOP_TREE},
+        AnalysisSet {AnalysisType::RPO},
+        AnalysisSet {AnalysisType::RPO, AnalysisType::DOMINATOR_TREE, AnalysisType::LOOP_TREE},
+    };
+
+private:
+    Graph *graph_ {nullptr};
+
+    AnalysisSet valid_;
+    std::array<size_t, ANALYSES_COUNT> runsCount_ {};
+
+    std::unique_ptr<PostDominatorTree> postDomTree_;
+    std::unique_ptr<ControlDependence> controlDependence_;
+    std::unique_ptr<Liveness> liveness_;
+    std::unique_ptr<RangeAnalysis> rangeAnalysis_;
+    std::unique_ptr<AliasAnalysis> aliasAnalysis_;
+    std::unique_ptr<EscapeAnalysis> escapeAnalysis_;
+    std::unique_ptr<BlockFrequency> blockFrequency_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_ANALYSIS_MANAGER_H
@@ -0,0 +1,145 @@
+#include "analysis/block_frequency.h"
+#include "ir/graph.h"
+
+#include <algorithm>
+
+namespace compiler {
+
+void BlockFrequency::Run()
+{
+    const auto &rpo = graph_->GetRpoVector();
+    probabilities_ = BlockSideTable<std::array<double, 2U>>(graph_);
+    frequencies_ = BlockSideTable<double>(graph_, 0.0);
+    loopScales_ = BlockSideTable<double>(graph_, 1.0);
+    rpoIndices_ = BlockSideTable<uint32_t>(graph_, NO_INDEX);
+    for (size_t idx = 0; idx < rpo.size(); ++idx) {
+        rpoIndices_[rpo[idx]] = static_cast<uint32_t>(idx);
+        EstimateProbabilities(rpo[idx]);
+    }
+
+    // Post-order over the loop tree, so inner loops are scaled before the outer ones are propagated.
+    std::vector<std::pair<const Loop *, size_t>> stack {{graph_->GetRootLoop(), 0}};
+    while (!stack.empty()) {
+        auto &[loop, nextInner] = stack.back();
+        if (nextInner < loop->GetInnerLoops().size()) {
+            const auto *inner = loop->GetInnerLoops()[nextInner++];
+            stack.emplace_back(inner, 0);
+            continue;
+        }
+        if (!loop->IsRoot()) {
+            ComputeLoopScale(loop);
+        }
+        stack.pop_back();
+    }
+
+    PropagateFrequencies(rpo);
+}
+
+double BlockFrequency::GetProbability(const BasicBlock *from, const BasicBlock *to) const
+{
+    if (from->GetId() >= probabilities_.size()) {
+        return 0.0;
+    }
+    const auto &succs = from->GetSuccessors();
+    double probability = 0.0;
+    for (size_t idx = 0; idx < succs.size(); ++idx) {
+        if (succs[idx] == to) {
+            probability += probabilities_[from][idx];
+        }
+    }
+    return probability;
+}
+
+void BlockFrequency::EstimateProbabilities(const BasicBlock *block)
+{
+    auto &probabilities = probabilities_[block];
+    const auto &succs = block->GetSuccessors();
+    if (succs.size() == 1U) {
+        probabilities = {1.0, 0.0};
+        return;
+    }
+    if (succs.size() != 2U) {
+        return;
+    }
+
+    if (block->HasEdgeCounts()) {
+        auto firstCount = static_cast<double>(block->GetEdgeCount(0));
+        auto total = firstCount + static_cast<double>(block->GetEdgeCount(1));
+        if (total > 0.0) {
+            probabilities = {firstCount / total, 1.0 - firstCount / total};
+            return;
+        }
+    }
+
+    auto isBackEdge = [block](const BasicBlock *succ) {
+        const auto *loop = succ->GetLoop();
+        return loop != nullptr && loop->GetHeader() == succ && loop->Contains(block);
+    };
+    auto isExit = [block](const BasicBlock *succ) {
+        return block->GetLoop() != nullptr && !block->GetLoop()->Contains(succ);
+    };
+
+    if (isBackEdge(succs[0]) != isBackEdge(succs[1])) {
+        auto first = isBackEdge(succs[0]) ? LOOP_BRANCH_PROBABILITY : 1.0 - LOOP_BRANCH_PROBABILITY;
+        probabilities = {first, 1.0 - first};
+    } else if (isExit(succs[0]) != isExit(succs[1])) {
+        auto first = isExit(succs[0]) ? LOOP_EXIT_PROBABILITY : 1.0 - LOOP_EXIT_PROBABILITY;
+        probabilities = {first, 1.0 - first};
+    } else {
+        probabilities = {0.5, 0.5};
+    }
+}
+
+// Frequencies of the loop blocks are computed for one entry into the header, then the back edges give
+// the probability of the next iteration. Irreducible loops have no single header and aren't scaled.
+void BlockFrequency::ComputeLoopScale(const Loop *loop)
+{
+    if (!loop->IsReducible()) {
+        return;
+    }
+    std::vector<BasicBlock *> blocks;
+    std::vector<const Loop *> loops {loop};
+    while (!loops.empty()) {
+        const auto *curr = loops.back();
+        loops.pop_back();
+        const auto &loopBlocks = curr->GetBlocks();
+        blocks.insert(blocks.end(), loopBlocks.begin(), loopBlocks.end());
+        loops.insert(loops.end(), curr->GetInnerLoops().begin(), curr->GetInnerLoops().end());
+    }
+    std::sort(blocks.begin(), blocks.end(),
+              [this](const BasicBlock *lhs, const BasicBlock *rhs) { return rpoIndices_[lhs] < rpoIndices_[rhs]; });
+
+    auto *header = loop->GetHeader();
+    assert(blocks.front() == header);
+    PropagateFrequencies(blocks);
+
+    double cyclicProbability = 0.0;
+    for (const auto *latch : loop->GetLatches()) {
+        cyclicProbability += GetEdgeFrequency(latch, header);
+    }
+    cyclicProbability = std::min(cyclicProbability, 1.0 - 1.0 / MAX_LOOP_SCALE);
+    loopScales_[header] = 1.0 / (1.0 - cyclicProbability);
+}
+
+// Retreating edges come from blocks which are not computed yet, they are accounted by scales of headers.
+// The first block runs once, or as many times as its loop iterates.
+void BlockFrequency::PropagateFrequencies(const std::vector<BasicBlock *> &blocks)
+{
+    if (blocks.empty()) {
+        return;
+    }
+    // Scale of a loop header is still 1 while its own loop is propagated.
+    frequencies_[blocks.front()] = loopScales_[blocks.front()];
+    for (size_t idx = 1; idx < blocks.size(); ++idx) {
+        auto *block = blocks[idx];
+        double frequency = 0.0;
+        for (const auto *pred : block->GetPredecessors()) {
+            if (rpoIndices_[pred] < rpoIndices_[block]) {
+                frequency += GetEdgeFrequency(pred, block);
+            }
+        }
+        frequencies_[block] = frequency * loopScales_[block];
+    }
+}
+
+}  // namespace compiler
@@ -0,0 +1,67 @@
+#ifndef ANALYSIS_BLOCK_FREQUENCY_H
+#define ANALYSIS_BLOCK_FREQUENCY_H
+
+#include "utils/macros.h"
+#include "ir/side_table.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace compiler {
+
+// Static estimation of branch probabilities and of block frequencies relative to the start block.
+// Branches with measured edge counts take probabilities from them, the others follow the loop heuristics
+// of Wu and Larus: a back edge is likely taken and a loop exit is likely not taken.
+// Frequencies are propagated in RPO, a loop header is scaled by 1 / (1 - p), where p is the probability
+// to come back to the header from its own iteration; it is computed for inner loops first.
+class BlockFrequency final {
+public:
+    NO_COPY_SEMANTIC(BlockFrequency);
+    NO_MOVE_SEMANTIC(BlockFrequency);
+
+    static constexpr double LOOP_BRANCH_PROBABILITY = 0.88;
+    static constexpr double LOOP_EXIT_PROBABILITY = 0.2;
+    // Bound of the scale of a loop header, for loops which almost never exit.
+    static constexpr double MAX_LOOP_SCALE = 1e6;
+
+    explicit BlockFrequency(Graph *graph) : graph_(graph) {}
+    ~BlockFrequency() = default;
+
+    void Run();
+
+    // Probability to go from the block to its successor `to`.
+    double GetProbability(const BasicBlock *from, const BasicBlock *to) const;
+
+    // How many times the block runs per run of the start block, zero for unreachable blocks.
+    double GetFrequency(const BasicBlock *block) const
+    {
+        return block->GetId() < frequencies_.size() ? frequencies_[block] : 0.0;
+    }
+
+    double GetEdgeFrequency(const BasicBlock *from, const BasicBlock *to) const
+    {
+        return GetFrequency(from) * GetProbability(from, to);
+    }
+
+private:
+    void EstimateProbabilities(const BasicBlock *block);
+    void ComputeLoopScale(const Loop *loop);
+    // Blocks must be in RPO, the first one gets frequency 1.
+    void PropagateFrequencies(const std::vector<BasicBlock *> &blocks);
+
+private:
+    static constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+    Graph *graph_ {nullptr};
+
+    BlockSideTable<std::array<double, 2U>> probabilities_;
+    BlockSideTable<double> frequencies_;
+    // Scale of loop headers, 1 for other blocks.
+    BlockSideTable<double> loopScales_;
+    BlockSideTable<uint32_t> rpoIndices_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_BLOCK_FREQUENCY_H
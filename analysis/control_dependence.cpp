@@ -0,0 +1,63 @@
+#include "analysis/control_dependence.h"
+#include "analysis/post_dominator_tree.h"
+#include "ir/graph.h"
+
+namespace compiler {
+
+void ControlDependence::Build()
+{
+    // Pairs of {key block, listed block}.
+    std::vector<std::pair<BasicBlock *, BasicBlock *>> controllingPairs;
+    std::vector<std::pair<BasicBlock *, BasicBlock *>> dependentPairs;
+
+    for (auto *block : graph_->GetBlocks()) {
+        // A single successor is the immediate post-dominator, so only branches produce dependences.
+        if (block->GetSuccessors().size() < 2 || !postDomTree_->IsInTree(block)) {
+            continue;
+        }
+
+        auto *ipdom = postDomTree_->GetImmediatePostDominator(block);
+        for (auto *succ : block->GetSuccessors()) {
+            if (!postDomTree_->IsInTree(succ)) {
+                continue;
+            }
+            // Blocks from the successor up to the immediate post-dominator of the branch, excluding the latter.
+            for (auto *runner = succ; runner != ipdom && runner != nullptr;
+                 runner = postDomTree_->GetImmediatePostDominator(runner)) {
+                controllingPairs.emplace_back(runner, block);
+                dependentPairs.emplace_back(block, runner);
+            }
+        }
+    }
+
+    auto blocksCount = graph_->GetBlocks().size();
+    controlling_.Build(blocksCount, controllingPairs);
+    dependent_.Build(blocksCount, dependentPairs);
+}
+
+std::span<BasicBlock *const> ControlDependence::BlockLists::Get(const BasicBlock *block) const
+{
+    auto id = block->GetId();
+    assert(id + 1 < begin.size());
+    return {blocks.data() + begin[id], blocks.data() + begin[id + 1]};
+}
+
+void ControlDependence::BlockLists::Build(size_t blocksCount,
+                                          const std::vector<std::pair<BasicBlock *, BasicBlock *>> &pairs)
+{
+    begin.assign(blocksCount + 1, 0);
+    for (auto &[key, value] : pairs) {
+        ++begin[key->GetId() + 1];
+    }
+    for (size_t idx = 1; idx < begin.size(); ++idx) {
+        begin[idx] += begin[idx - 1];
+    }
+
+    blocks.resize(pairs.size());
+    std::vector<uint32_t> filled(begin.begin(), begin.end() - 1);
+    for (auto &[key, value] : pairs) {
+        blocks[filled[key->GetId()]++] = value;
+    }
+}
+
+}  // namespace compiler
@@ -0,0 +1,64 @@
+#ifndef ANALYSIS_CONTROL_DEPENDENCE_H
+#define ANALYSIS_CONTROL_DEPENDENCE_H
+
+#include "utils/macros.h"
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace compiler {
+
+class Graph;
+class BasicBlock;
+class PostDominatorTree;
+
+// Block B is control dependent on block A if A has a successor S such that B post-dominates S,
+// but B doesn't strictly post-dominate A (Ferrante, Ottenstein and Warren).
+// Blocks out of the post-dominator tree have no dependences.
+class ControlDependence final {
+public:
+    NO_COPY_SEMANTIC(ControlDependence);
+    NO_MOVE_SEMANTIC(ControlDependence);
+
+    ControlDependence(Graph *graph, const PostDominatorTree *postDomTree) : graph_(graph), postDomTree_(postDomTree)
+    {
+    }
+    ~ControlDependence() = default;
+
+    void Build();
+
+    // Blocks whose branches decide whether `block` is executed.
+    std::span<BasicBlock *const> GetControllingBlocks(const BasicBlock *block) const
+    {
+        return controlling_.Get(block);
+    }
+
+    // Blocks whose execution is decided by the branch at the end of `block`.
+    std::span<BasicBlock *const> GetDependentBlocks(const BasicBlock *block) const
+    {
+        return dependent_.Get(block);
+    }
+
+private:
+    // Lists of blocks for every block in one flat array.
+    struct BlockLists {
+        std::span<BasicBlock *const> Get(const BasicBlock *block) const;
+        void Build(size_t blocksCount, const std::vector<std::pair<BasicBlock *, BasicBlock *>> &pairs);
+
+        std::vector<uint32_t> begin;
+        std::vector<BasicBlock *> blocks;
+    };
+
+private:
+    Graph *graph_ {nullptr};
+    const PostDominatorTree *postDomTree_ {nullptr};
+
+    BlockLists controlling_;
+    BlockLists dependent_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_CONTROL_DEPENDENCE_H
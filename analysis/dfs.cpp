@@ -1,4 +1,5 @@
 #include "analysis/dfs.h"
+#include "analysis/graph_traversal.h"
 #include "ir/graph.h"
 
 namespace compiler {
@@ -7,24 +8,19 @@ std::vector<BasicBlock *> DFS::Run()
 {
     std::vector<BasicBlock *> dfsVector;
 
-    DFSImpl(dfsVector, graph_->GetStartBlock());
-
-    return dfsVector;
-}
-
-void DFS::DFSImpl(std::vector<BasicBlock *> &dfsVector, BasicBlock *block)
-{
-    assert(block);
+    struct Visitor {
+        void PreOrder(BasicBlock *block)
+        {
+            dfsVector.push_back(block);
+        }
 
-    block->SetMarker(marker_);
+        std::vector<BasicBlock *> &dfsVector;
+    };
 
-    dfsVector.push_back(block);
+    GraphTraversal traversal(graph_);
+    traversal.Run(graph_->GetStartBlock(), marker_, Visitor {dfsVector});
 
-    for (auto succBlock : block->GetSuccessors()) {
-        if (!succBlock->IsMarked(marker_)) {
-            DFSImpl(dfsVector, succBlock);
-        }
-    }
+    return dfsVector;
 }
 
 }  // namespace compiler
@@ -25,9 +25,6 @@ public:
         marker_ = marker;
     }
 
-private:
-    void DFSImpl(std::vector<BasicBlock *> &dfsVector, BasicBlock *block);
-
 private:
     Graph *graph_ {nullptr};
 
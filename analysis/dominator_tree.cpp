@@ -1,85 +1,138 @@
 #include "analysis/dominator_tree.h"
-#include "analysis/dfs.h"
 #include "ir/graph.h"
 
-#include <algorithm>
-#include <iostream>
+#include <utility>
 
 namespace compiler {
 
 void DominatorTree::Build()
 {
-    graph_->RunRpo();
+    graph_->GetAnalysisManager()->Run(AnalysisType::RPO);
     auto &rpoVec = graph_->GetRpoVector();
 
-    auto *rootBlock = graph_->GetStartBlock();
-    rootBlock->SetDominatedBlocks(rpoVec);
-
-    for (auto it = rpoVec.begin() + 1; it < rpoVec.end(); ++it) {
-        dominatorsMap_.emplace(*it, std::vector<BasicBlock *> {rootBlock});
+    rpoIdx_ = BlockSideTable<uint32_t>(graph_, UNDEF_IDX);
+    for (size_t idx = 0; idx < rpoVec.size(); ++idx) {
+        rpoIdx_[rpoVec[idx]] = static_cast<uint32_t>(idx);
     }
 
-    DFS dfs(graph_);
+    CollectPredecessors();
+    CalculateImmediateDominators();
 
-    for (auto blockIt = rpoVec.begin() + 1; blockIt < rpoVec.end(); ++blockIt) {
-        auto *block = *blockIt;
-        auto marker = graph_->CreateNewMarker();
-        dfs.SetMarker(marker);
-        block->SetMarker(marker);  // mark block to remove it from DFS bypass.
+    // Blocks which became unreachable since the previous build keep nothing of it.
+    for (auto *block : graph_->GetBlocks()) {
+        block->SetImmediateDominator(nullptr);
+        block->ClearDominatedBlocks();
+        block->SetDomTreeInterval(0, 0);
+    }
+    for (size_t idx = 1; idx < rpoVec.size(); ++idx) {
+        rpoVec[idx]->SetImmediateDominator(rpoVec[idoms_[idx]]);
+    }
 
-        auto reachableBlocks = dfs.Run();
+    BuildTree();
+}
 
-        CalculateDominatedBlocks(block, rpoVec, reachableBlocks);
+// Predecessors are derived from successors, since only the latter are required to be set in CFG.
+// They are kept as RPO indices in one flat array,
+// predecessors of block `idx` occupy [predsBegin_[idx], predsBegin_[idx + 1]).
+void DominatorTree::CollectPredecessors()
+{
+    auto &rpoVec = graph_->GetRpoVector();
 
-        graph_->EraseMarker(marker);
+    predsBegin_.assign(rpoVec.size() + 1, 0);
+    for (auto *block : rpoVec) {
+        for (auto *succ : block->GetSuccessors()) {
+            ++predsBegin_[rpoIdx_[succ] + 1];
+        }
+    }
+    for (size_t idx = 1; idx < predsBegin_.size(); ++idx) {
+        predsBegin_[idx] += predsBegin_[idx - 1];
     }
 
-    for (auto blockIt = rpoVec.begin(); blockIt < rpoVec.end(); ++blockIt) {
-        CalculateImmediateDominators(*blockIt);
+    preds_.resize(predsBegin_.back());
+    std::vector<uint32_t> filled(predsBegin_.begin(), predsBegin_.end() - 1);
+    for (uint32_t blockIdx = 0; blockIdx < rpoVec.size(); ++blockIdx) {
+        for (auto *succ : rpoVec[blockIdx]->GetSuccessors()) {
+            preds_[filled[rpoIdx_[succ]]++] = blockIdx;
+        }
     }
 }
 
-void DominatorTree::CalculateDominatedBlocks(BasicBlock *block, const std::vector<BasicBlock *> &originalVec,
-                                             const std::vector<BasicBlock *> &reachableBlocks)
+void DominatorTree::CalculateImmediateDominators()
 {
-    assert(block);
-
-    std::vector<BasicBlock *> dominatedBlocks;
-
-    for (auto originalVecIt = originalVec.begin(); originalVecIt < originalVec.end(); ++originalVecIt) {
-        auto dominatedBlock = std::find_if(
-            reachableBlocks.begin(), reachableBlocks.end(),
-            [&originalVecIt](auto reachableBlocksIt) -> bool { return reachableBlocksIt == *originalVecIt; });
-
-        if (dominatedBlock == reachableBlocks.end() && *originalVecIt != block) {
-            dominatedBlocks.push_back(*originalVecIt);
-            auto mapIt = dominatorsMap_.find(*originalVecIt);
-            if (mapIt != dominatorsMap_.end()) {
-                mapIt->second.push_back(block);
-            } else {
-                UNREACHABLE();
+    auto &rpoVec = graph_->GetRpoVector();
+
+    idoms_.assign(rpoVec.size(), UNDEF_IDX);
+    idoms_[0] = 0;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (uint32_t blockIdx = 1; blockIdx < rpoVec.size(); ++blockIdx) {
+            uint32_t newIdom = UNDEF_IDX;
+            for (auto predPos = predsBegin_[blockIdx]; predPos < predsBegin_[blockIdx + 1]; ++predPos) {
+                auto predIdx = preds_[predPos];
+                // Skip not yet processed predecessors.
+                if (idoms_[predIdx] == UNDEF_IDX) {
+                    continue;
+                }
+                newIdom = (newIdom == UNDEF_IDX) ? predIdx : Intersect(predIdx, newIdom);
+            }
+
+            assert(newIdom != UNDEF_IDX);
+            if (idoms_[blockIdx] != newIdom) {
+                idoms_[blockIdx] = newIdom;
+                changed = true;
             }
         }
     }
+}
+
+uint32_t DominatorTree::Intersect(uint32_t lhs, uint32_t rhs) const
+{
+    while (lhs != rhs) {
+        while (lhs > rhs) {
+            lhs = idoms_[lhs];
+        }
+        while (rhs > lhs) {
+            rhs = idoms_[rhs];
+        }
+    }
+    return lhs;
+}
+
+void DominatorTree::BuildTree()
+{
+    auto &rpoVec = graph_->GetRpoVector();
+    for (auto blockIt = rpoVec.begin() + 1; blockIt < rpoVec.end(); ++blockIt) {
+        auto *block = *blockIt;
+        block->GetImmediateDominator()->AddDominatedBlock(block);
+    }
 
-    block->SetDominatedBlocks(std::move(dominatedBlocks));
+    NumberTree(graph_->GetStartBlock());
 }
 
-void DominatorTree::CalculateImmediateDominators(BasicBlock *block)
+// Iterative DFS over the dominator tree, a block is entered before and left after all blocks it dominates.
+void DominatorTree::NumberTree(BasicBlock *root)
 {
-    assert(block);
-
-    for (auto dominatedBlockIt : block->GetDominatedBlocks()) {
-        auto mapIt = dominatorsMap_.find(dominatedBlockIt);
-        if (mapIt != dominatorsMap_.end()) {
-            auto blocksDominatesOverCurrent = mapIt->second;
-            auto it = std::find_if_not(blocksDominatesOverCurrent.begin(), blocksDominatesOverCurrent.end(),
-                                       [block](auto domIt) { return domIt->IsDominatesOver(block); });
-            if (it == blocksDominatesOverCurrent.end()) {
-                dominatedBlockIt->SetImmediateDominator(block);
-            }
+    uint32_t counter = 0;
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+
+    root->SetDomTreeInterval(++counter, 0);
+    stack.emplace_back(root, 0);
+
+    while (!stack.empty()) {
+        auto *block = stack.back().first;
+        auto childIdx = stack.back().second++;
+
+        auto &children = block->GetDominatedBlocks();
+        if (childIdx < children.size()) {
+            auto *child = children[childIdx];
+            child->SetDomTreeInterval(++counter, 0);
+            stack.emplace_back(child, 0);
         } else {
-            UNREACHABLE();
+            block->SetDomTreeInterval(block->GetDomTreeIn(), ++counter);
+            stack.pop_back();
         }
     }
 }
@@ -2,15 +2,16 @@
 #define ANALYSIS_DOMINATOR_TREE_H
 
 #include "utils/macros.h"
+#include "ir/side_table.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
-#include <unordered_map>
 
 namespace compiler {
 
-class Graph;
-class BasicBlock;
-
+// Iterative algorithm by Cooper, Harvey and Kennedy ("A Simple, Fast Dominance Algorithm").
+// Immediate dominators are refined over RPO until a fixed point, which takes a few passes on real CFGs.
 class DominatorTree final {
 public:
     NO_COPY_SEMANTIC(DominatorTree);
@@ -21,16 +22,28 @@ public:
     void Build();
 
 private:
-    void CalculateDominatedBlocks(BasicBlock *block, const std::vector<BasicBlock *> &originalVec,
-                                  const std::vector<BasicBlock *> &reachableBlocks);
+    static constexpr uint32_t UNDEF_IDX = UINT32_MAX;
+
+    void CollectPredecessors();
+    void CalculateImmediateDominators();
+
+    // Common dominator of two blocks given by their RPO indices.
+    uint32_t Intersect(uint32_t lhs, uint32_t rhs) const;
 
-    void CalculateImmediateDominators(BasicBlock *block);
+    // Link blocks to their immediate dominators and number the resulting tree.
+    void BuildTree();
+    void NumberTree(BasicBlock *root);
 
 private:
     Graph *graph_ {nullptr};
 
-    // <block, blocks that dominated on key block>
-    std::unordered_map<BasicBlock *, std::vector<BasicBlock *>> dominatorsMap_;
+    // UNDEF_IDX for unreachable blocks.
+    BlockSideTable<uint32_t> rpoIdx_;
+    // Reachable predecessors in RPO indices, see CollectPredecessors.
+    std::vector<uint32_t> predsBegin_;
+    std::vector<uint32_t> preds_;
+    // Indexed by RPO index of the block.
+    std::vector<uint32_t> idoms_;
 };
 
 }  // namespace compiler
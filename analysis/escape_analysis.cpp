@@ -0,0 +1,178 @@
+#include "analysis/escape_analysis.h"
+#include "ir/graph.h"
+#include "ir/instructions.h"
+
+#include <algorithm>
+
+namespace compiler {
+
+static bool IsReference(const Instruction *insn)
+{
+    return insn->HasResult() && (insn->GetResultType() == DataType::REF || insn->DoesProduceReference());
+}
+
+void EscapeAnalysis::Run()
+{
+    insnNodes_ = InsnSideTable<uint32_t>(graph_, NO_NODE);
+    nodes_.clear();
+
+    for (auto *block : graph_->GetRpoVector()) {
+        for (const auto *insn = block->GetFirstInsn(); insn != nullptr; insn = insn->GetNext()) {
+            VisitDefinition(insn);
+            VisitUses(insn);
+        }
+    }
+    PropagateStates();
+}
+
+EscapeState EscapeAnalysis::GetEscapeState(const Instruction *ref) const
+{
+    if (ref->GetId() >= insnNodes_.size() || insnNodes_[ref] == NO_NODE) {
+        return EscapeState::GLOBAL_ESCAPE;
+    }
+    return states_[insnNodes_[ref]];
+}
+
+uint32_t EscapeAnalysis::GetNode(const Instruction *ref)
+{
+    auto &node = insnNodes_[ref];
+    if (node == NO_NODE) {
+        node = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back({node, NO_NODE, EscapeState::NO_ESCAPE});
+    }
+    return node;
+}
+
+// Node of the elements is created on demand, references loaded from arrays of the node belong to it.
+uint32_t EscapeAnalysis::GetElements(uint32_t node)
+{
+    auto root = Find(node);
+    if (nodes_[root].elements == NO_NODE) {
+        auto elements = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back({elements, NO_NODE, EscapeState::NO_ESCAPE});
+        nodes_[root].elements = elements;
+    }
+    return nodes_[root].elements;
+}
+
+uint32_t EscapeAnalysis::Find(uint32_t node)
+{
+    while (nodes_[node].parent != node) {
+        nodes_[node].parent = nodes_[nodes_[node].parent].parent;
+        node = nodes_[node].parent;
+    }
+    return node;
+}
+
+// Elements of unified nodes are unified as well, the pending pairs avoid deep recursion.
+void EscapeAnalysis::Unify(uint32_t lhs, uint32_t rhs)
+{
+    pendingUnions_.emplace_back(lhs, rhs);
+    while (!pendingUnions_.empty()) {
+        auto root = Find(pendingUnions_.back().first);
+        auto other = Find(pendingUnions_.back().second);
+        pendingUnions_.pop_back();
+        if (root == other) {
+            continue;
+        }
+        nodes_[other].parent = root;
+        nodes_[root].state = std::max(nodes_[root].state, nodes_[other].state);
+        if (nodes_[root].elements == NO_NODE) {
+            nodes_[root].elements = nodes_[other].elements;
+        } else if (nodes_[other].elements != NO_NODE) {
+            pendingUnions_.emplace_back(nodes_[root].elements, nodes_[other].elements);
+        }
+    }
+}
+
+void EscapeAnalysis::Escape(uint32_t node, EscapeState state)
+{
+    auto root = Find(node);
+    nodes_[root].state = std::max(nodes_[root].state, state);
+}
+
+// References which come from outside of the method are visible to everybody.
+void EscapeAnalysis::VisitDefinition(const Instruction *insn)
+{
+    if (!IsReference(insn)) {
+        return;
+    }
+    auto node = GetNode(insn);
+    switch (insn->GetOpcode()) {
+        case Opcode::NEWARR:
+        case Opcode::NULLCHECK:
+        case Opcode::PHI:
+            break;
+        case Opcode::LOADARRAY:
+            Unify(node, GetElements(GetNode(insn->GetInput(0))));
+            break;
+        default:
+            Escape(node, EscapeState::GLOBAL_ESCAPE);
+            break;
+    }
+}
+
+// Uses which only read the array or its length don't let it escape.
+void EscapeAnalysis::VisitUses(const Instruction *insn)
+{
+    auto inputs = insn->GetInputs();
+    for (size_t idx = 0; idx < inputs.size(); ++idx) {
+        const auto *input = inputs[idx].GetValue();
+        if (!IsReference(input)) {
+            continue;
+        }
+        auto node = GetNode(input);
+        switch (insn->GetOpcode()) {
+            case Opcode::NULLCHECK:
+            case Opcode::PHI:
+                Unify(GetNode(insn), node);
+                break;
+            case Opcode::BOUNDSCHECK:
+            case Opcode::LOADARRAY:
+            case Opcode::BEQ:
+            case Opcode::BNE:
+            case Opcode::BGT:
+                break;
+            case Opcode::STOREARRAY:
+                if (idx == 2U) {
+                    Unify(GetElements(GetNode(insn->GetInput(0))), node);
+                }
+                break;
+            case Opcode::CALLSTATIC:
+                Escape(node, EscapeState::ARG_ESCAPE);
+                break;
+            default:
+                Escape(node, EscapeState::GLOBAL_ESCAPE);
+                break;
+        }
+    }
+}
+
+// Elements are reachable through the array, so they escape at least as far as it does.
+void EscapeAnalysis::PropagateStates()
+{
+    std::vector<uint32_t> worklist;
+    for (uint32_t node = 0; node < nodes_.size(); ++node) {
+        if (Find(node) == node && nodes_[node].elements != NO_NODE) {
+            worklist.push_back(node);
+        }
+    }
+    while (!worklist.empty()) {
+        auto node = worklist.back();
+        worklist.pop_back();
+        auto elements = Find(nodes_[node].elements);
+        if (nodes_[elements].state < nodes_[node].state) {
+            nodes_[elements].state = nodes_[node].state;
+            if (nodes_[elements].elements != NO_NODE) {
+                worklist.push_back(elements);
+            }
+        }
+    }
+
+    states_.resize(nodes_.size());
+    for (uint32_t node = 0; node < nodes_.size(); ++node) {
+        states_[node] = nodes_[Find(node)].state;
+    }
+}
+
+}  // namespace compiler
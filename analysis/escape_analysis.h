@@ -0,0 +1,65 @@
+#ifndef ANALYSIS_ESCAPE_ANALYSIS_H
+#define ANALYSIS_ESCAPE_ANALYSIS_H
+
+#include "utils/macros.h"
+#include "ir/side_table.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace compiler {
+
+// Ordered from the most local state.
+enum class EscapeState : uint8_t { NO_ESCAPE, ARG_ESCAPE, GLOBAL_ESCAPE };
+
+// Flow-insensitive escape analysis of NewArr allocations.
+// References which may point to the same object are unified into one node, and so are the elements of
+// all arrays of a node; an array stored into another one becomes an element of its node.
+// Returned references, parameters and results of calls escape globally, arguments of calls escape to the callee,
+// and elements of an array escape at least as far as the array.
+class EscapeAnalysis final {
+public:
+    NO_COPY_SEMANTIC(EscapeAnalysis);
+    NO_MOVE_SEMANTIC(EscapeAnalysis);
+
+    explicit EscapeAnalysis(Graph *graph) : graph_(graph) {}
+    ~EscapeAnalysis() = default;
+
+    void Run();
+
+    // State of a reference, values which are not references of the graph are assumed to escape globally.
+    EscapeState GetEscapeState(const Instruction *ref) const;
+
+private:
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+    struct Node {
+        uint32_t parent {NO_NODE};
+        uint32_t elements {NO_NODE};
+        EscapeState state {EscapeState::NO_ESCAPE};
+    };
+
+    uint32_t GetNode(const Instruction *ref);
+    uint32_t GetElements(uint32_t node);
+    uint32_t Find(uint32_t node);
+    void Unify(uint32_t lhs, uint32_t rhs);
+    void Escape(uint32_t node, EscapeState state);
+
+    void VisitDefinition(const Instruction *insn);
+    void VisitUses(const Instruction *insn);
+    void PropagateStates();
+
+private:
+    Graph *graph_ {nullptr};
+
+    InsnSideTable<uint32_t> insnNodes_;
+    std::vector<Node> nodes_;
+    std::vector<std::pair<uint32_t, uint32_t>> pendingUnions_;
+    // Final state of every node.
+    std::vector<EscapeState> states_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_ESCAPE_ANALYSIS_H
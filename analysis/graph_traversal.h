@@ -0,0 +1,104 @@
+#ifndef ANALYSIS_GRAPH_TRAVERSAL_H
+#define ANALYSIS_GRAPH_TRAVERSAL_H
+
+#include "utils/macros.h"
+#include "ir/basic_block.h"
+#include "ir/graph.h"
+#include "ir/marker.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace compiler {
+
+enum class TraversalDirection { FORWARD, BACKWARD };
+
+// Depth-first traversal over CFG with an explicit stack, so the depth of CFG is limited only by memory.
+// Forward traversal follows successors, backward one follows predecessors.
+//
+// Visitor may define any of the callbacks:
+//   void PreOrder(BasicBlock *block)                     -- block is visited for the first time;
+//   void PostOrder(BasicBlock *block)                    -- all blocks reachable from `block` are visited;
+//   void VisitedEdge(BasicBlock *from, BasicBlock *to)   -- edge to an already visited block.
+//
+// Blocks marked with the marker passed to `Run` are considered visited, the traversal marks every block it enters.
+template <TraversalDirection DIRECTION = TraversalDirection::FORWARD>
+class GraphTraversal final {
+public:
+    NO_COPY_SEMANTIC(GraphTraversal);
+    NO_MOVE_SEMANTIC(GraphTraversal);
+
+    explicit GraphTraversal(const Graph *graph)
+    {
+        stack_.reserve(graph->GetBlocks().size());
+    }
+    ~GraphTraversal() = default;
+
+    template <typename Visitor>
+    void Run(BasicBlock *root, Marker marker, Visitor &&visitor)
+    {
+        assert(root != nullptr);
+        assert(stack_.empty());
+
+        if (root->IsMarked(marker)) {
+            return;
+        }
+        Enter(root, marker, visitor);
+
+        while (!stack_.empty()) {
+            auto &frame = stack_.back();
+            auto &nextBlocks = GetNextBlocks(frame.block);
+
+            if (frame.nextIdx < nextBlocks.size()) {
+                auto *from = frame.block;
+                auto *to = nextBlocks[frame.nextIdx++];
+                if (!to->IsMarked(marker)) {
+                    // Invalidates `frame`.
+                    Enter(to, marker, visitor);
+                } else if constexpr (requires { visitor.VisitedEdge(from, to); }) {
+                    visitor.VisitedEdge(from, to);
+                }
+                continue;
+            }
+
+            auto *block = frame.block;
+            stack_.pop_back();
+            if constexpr (requires { visitor.PostOrder(block); }) {
+                visitor.PostOrder(block);
+            }
+        }
+    }
+
+private:
+    struct Frame {
+        BasicBlock *block {nullptr};
+        size_t nextIdx {0};
+    };
+
+    static const utils::ArenaVector<BasicBlock *> &GetNextBlocks(const BasicBlock *block)
+    {
+        if constexpr (DIRECTION == TraversalDirection::FORWARD) {
+            return block->GetSuccessors();
+        } else {
+            return block->GetPredecessors();
+        }
+    }
+
+    template <typename Visitor>
+    void Enter(BasicBlock *block, Marker marker, Visitor &visitor)
+    {
+        block->SetMarker(marker);
+        if constexpr (requires { visitor.PreOrder(block); }) {
+            visitor.PreOrder(block);
+        }
+        stack_.push_back({block, 0});
+    }
+
+private:
+    std::vector<Frame> stack_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_GRAPH_TRAVERSAL_H
@@ -0,0 +1,349 @@
+#include "analysis/induction_analysis.h"
+#include "analysis/range_analysis.h"
+#include "ir/graph.h"
+#include "ir/instructions.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace compiler {
+
+// Values of U64 don't fit the signed domain of steps and offsets.
+static bool IsCountable(const Instruction *insn)
+{
+    return insn->HasResult() && insn->IsIntResultType() && insn->GetResultType() != DataType::U64;
+}
+
+static std::optional<int64_t> GetIntConstant(const Instruction *insn)
+{
+    if (!insn->IsConst()) {
+        return std::nullopt;
+    }
+    const auto *constant = insn->AsConst();
+    if (!constant->IsSignedInt() && !constant->IsUnsignedInt()) {
+        return std::nullopt;
+    }
+    return constant->GetAsI64();
+}
+
+// Step of `update` over `phi`, if it adds a constant to the phi.
+static std::optional<int64_t> GetStep(const Instruction *update, const Instruction *phi)
+{
+    if (update->GetOpcode() == Opcode::ADD) {
+        if (update->GetInput(0) == phi) {
+            return GetIntConstant(update->GetInput(1));
+        }
+        if (update->GetInput(1) == phi) {
+            return GetIntConstant(update->GetInput(0));
+        }
+    } else if (update->GetOpcode() == Opcode::SUB && update->GetInput(0) == phi) {
+        auto step = GetIntConstant(update->GetInput(1));
+        if (step.has_value() && *step != ValueRange::MIN) {
+            return -*step;
+        }
+    }
+    return std::nullopt;
+}
+
+// Variable `insn` if it is an affine function of `variable` with a constant coefficient.
+static std::optional<InductionVariable> Derive(Instruction *insn, const InductionVariable &variable,
+                                               int64_t basisStep)
+{
+    bool isFirst = insn->GetInput(0) == variable.value;
+    auto constant = GetIntConstant(insn->GetInput(isFirst ? 1 : 0));
+    if (!constant.has_value()) {
+        return std::nullopt;
+    }
+
+    InductionVariable derived = variable;
+    derived.value = insn;
+    bool overflow = false;
+    switch (insn->GetOpcode()) {
+        case Opcode::ADD:
+            overflow = __builtin_add_overflow(variable.offset, *constant, &derived.offset);
+            break;
+        case Opcode::SUB:
+            if (isFirst) {
+                overflow = __builtin_sub_overflow(variable.offset, *constant, &derived.offset);
+            } else {
+                overflow = __builtin_sub_overflow(*constant, variable.offset, &derived.offset) ||
+                           __builtin_sub_overflow(int64_t {0}, variable.scale, &derived.scale);
+            }
+            break;
+        case Opcode::MUL:
+            overflow = __builtin_mul_overflow(variable.offset, *constant, &derived.offset) ||
+                       __builtin_mul_overflow(variable.scale, *constant, &derived.scale);
+            break;
+        default:
+            return std::nullopt;
+    }
+    if (overflow || __builtin_mul_overflow(derived.scale, basisStep, &derived.step) || derived.step == 0) {
+        return std::nullopt;
+    }
+    return derived;
+}
+
+void InductionAnalysis::Run()
+{
+    variableIndices_ = InsnSideTable<uint32_t>(graph_, NO_VARIABLE);
+
+    std::vector<Loop *> loops {graph_->GetRootLoop()};
+    for (size_t idx = 0; idx < loops.size(); ++idx) {
+        const auto &innerLoops = loops[idx]->GetInnerLoops();
+        loops.insert(loops.end(), innerLoops.begin(), innerLoops.end());
+    }
+    loops.erase(loops.begin());
+
+    for (auto *loop : loops) {
+        CollectBasicVariables(loop);
+    }
+    CollectDerivedVariables();
+    for (auto *loop : loops) {
+        AnalyzeBound(loop);
+    }
+}
+
+void InductionAnalysis::AddVariable(Loop *loop, const InductionVariable &variable)
+{
+    variableIndices_[variable.value] = static_cast<uint32_t>(loop->GetInductionVariables().size());
+    loop->GetInductionVariables().push_back(variable);
+}
+
+// Variables are kept in the innermost loop of their definition.
+const InductionVariable *InductionAnalysis::GetVariable(const Loop *loop, const Instruction *value) const
+{
+    if (value->GetId() >= variableIndices_.size() || variableIndices_[value] == NO_VARIABLE ||
+        value->GetParentBB()->GetLoop() != loop) {
+        return nullptr;
+    }
+    return &loop->GetInductionVariables()[variableIndices_[value]];
+}
+
+void InductionAnalysis::CollectBasicVariables(Loop *loop)
+{
+    loop->GetInductionVariables().clear();
+    loop->SetBound(std::nullopt);
+    loop->SetTripCount(std::nullopt);
+    if (!loop->IsReducible()) {
+        return;
+    }
+
+    auto *header = loop->GetHeader();
+    for (auto *insn = header->GetFirstInsn(); insn != nullptr && insn->IsPhi(); insn = insn->GetNext()) {
+        if (!IsCountable(insn)) {
+            continue;
+        }
+        Instruction *init = nullptr;
+        Instruction *update = nullptr;
+        bool isUniform = true;
+        for (const auto &dependency : static_cast<PhiInsn *>(insn)->GetDependencies()) {
+            auto *&value = loop->Contains(dependency.block) ? update : init;
+            isUniform &= (value == nullptr || value == dependency.value);
+            value = dependency.value;
+        }
+        if (!isUniform || init == nullptr || update == nullptr) {
+            continue;
+        }
+        auto step = GetStep(update, insn);
+        if (step.has_value() && *step != 0) {
+            AddVariable(loop, {insn, insn, init, 1, 0, *step});
+        }
+    }
+}
+
+// Definitions precede uses in RPO, so variables derived from derived ones are found in one pass.
+void InductionAnalysis::CollectDerivedVariables()
+{
+    for (auto *block : graph_->GetRpoVector()) {
+        auto *loop = block->GetLoop();
+        if (loop == nullptr || loop->GetInductionVariables().empty()) {
+            continue;
+        }
+        for (auto *insn = block->GetFirstInsn(); insn != nullptr; insn = insn->GetNext()) {
+            auto opcode = insn->GetOpcode();
+            if ((opcode != Opcode::ADD && opcode != Opcode::SUB && opcode != Opcode::MUL) || !IsCountable(insn)) {
+                continue;
+            }
+            const auto *variable = GetVariable(loop, insn->GetInput(0));
+            if (variable == nullptr) {
+                variable = GetVariable(loop, insn->GetInput(1));
+            }
+            if (variable == nullptr) {
+                continue;
+            }
+            const auto *basis = GetVariable(loop, variable->basis);
+            auto derived = Derive(insn, *variable, basis->step);
+            if (derived.has_value()) {
+                AddVariable(loop, *derived);
+            }
+        }
+    }
+}
+
+static ConditionCode GetConditionCode(Opcode opcode)
+{
+    switch (opcode) {
+        case Opcode::BEQ:
+            return ConditionCode::EQ;
+        case Opcode::BNE:
+            return ConditionCode::NE;
+        case Opcode::BGT:
+            return ConditionCode::GT;
+        default:
+            UNREACHABLE();
+    }
+}
+
+// Condition with swapped operands.
+static ConditionCode SwapConditionCode(ConditionCode cc)
+{
+    switch (cc) {
+        case ConditionCode::LT:
+            return ConditionCode::GT;
+        case ConditionCode::LE:
+            return ConditionCode::GE;
+        case ConditionCode::GT:
+            return ConditionCode::LT;
+        case ConditionCode::GE:
+            return ConditionCode::LE;
+        default:
+            return cc;
+    }
+}
+
+static ConditionCode InvertConditionCode(ConditionCode cc)
+{
+    switch (cc) {
+        case ConditionCode::EQ:
+            return ConditionCode::NE;
+        case ConditionCode::NE:
+            return ConditionCode::EQ;
+        case ConditionCode::LT:
+            return ConditionCode::GE;
+        case ConditionCode::LE:
+            return ConditionCode::GT;
+        case ConditionCode::GT:
+            return ConditionCode::LE;
+        case ConditionCode::GE:
+            return ConditionCode::LT;
+        default:
+            UNREACHABLE();
+    }
+}
+
+void InductionAnalysis::AnalyzeBound(Loop *loop)
+{
+    const auto &exitEdges = loop->GetExitEdges();
+    if (loop->GetInductionVariables().empty() || exitEdges.size() != 1U) {
+        return;
+    }
+    auto *exitingBlock = exitEdges.front().from;
+    // The test must run on every iteration.
+    const auto &latches = loop->GetLatches();
+    if (!std::all_of(latches.begin(), latches.end(),
+                     [exitingBlock](const BasicBlock *latch) { return exitingBlock->IsDominatesOver(latch); })) {
+        return;
+    }
+    auto *lastInsn = exitingBlock->GetLastInsn();
+    if (lastInsn == nullptr || !lastInsn->IsBranch()) {
+        return;
+    }
+
+    auto *branch = static_cast<BranchInsn *>(lastInsn);
+    auto cc = GetConditionCode(branch->GetOpcode());
+    const auto *counter = GetVariable(loop, branch->GetInput(0));
+    auto *bound = branch->GetInput(1);
+    if (counter == nullptr) {
+        counter = GetVariable(loop, branch->GetInput(1));
+        bound = branch->GetInput(0);
+        cc = SwapConditionCode(cc);
+    }
+    if (counter == nullptr || loop->Contains(bound->GetParentBB())) {
+        return;
+    }
+    if (!loop->Contains(branch->GetTrueBranchBB())) {
+        cc = InvertConditionCode(cc);
+    }
+
+    LoopBound loopBound {counter->value, bound, cc, exitingBlock};
+    loop->SetBound(loopBound);
+    loop->SetTripCount(ComputeTripCount(loop, loopBound));
+}
+
+// Number of iterations k = 0, 1, ... before `start + k * step <cc> bound` becomes false.
+static std::optional<int64_t> CountIterations(int64_t start, int64_t step, int64_t bound, ConditionCode cc)
+{
+    int64_t distance = 0;
+    switch (cc) {
+        case ConditionCode::EQ:
+            return (start == bound) ? 1 : 0;
+        case ConditionCode::NE:
+            if (__builtin_sub_overflow(bound, start, &distance) || (distance == ValueRange::MIN && step == -1) ||
+                distance % step != 0 || distance / step < 0) {
+                return std::nullopt;
+            }
+            return distance / step;
+        case ConditionCode::LT:
+        case ConditionCode::LE:
+            if (start > bound || (start == bound && cc == ConditionCode::LT)) {
+                return 0;
+            }
+            if (step < 0 || __builtin_sub_overflow(bound, start, &distance)) {
+                return std::nullopt;
+            }
+            if (cc == ConditionCode::LT) {
+                return distance / step + ((distance % step != 0) ? 1 : 0);
+            }
+            return distance / step + 1;
+        case ConditionCode::GT:
+        case ConditionCode::GE:
+            if (start < bound || (start == bound && cc == ConditionCode::GT)) {
+                return 0;
+            }
+            if (step > 0 || step == ValueRange::MIN || __builtin_sub_overflow(start, bound, &distance)) {
+                return std::nullopt;
+            }
+            if (cc == ConditionCode::GT) {
+                return distance / -step + ((distance % -step != 0) ? 1 : 0);
+            }
+            return distance / -step + 1;
+        default:
+            UNREACHABLE();
+    }
+}
+
+// Whether `start + count * step` is computed without wrapping around in the type.
+static bool IsInType(int64_t start, int64_t count, int64_t step, DataType type)
+{
+    int64_t value = 0;
+    if (__builtin_mul_overflow(count, step, &value) || __builtin_add_overflow(start, value, &value)) {
+        return false;
+    }
+    return ValueRange::ForType(type).Contains({start, start}) && ValueRange::ForType(type).Contains({value, value});
+}
+
+// The variables reach the value of iteration `count`, it must be computed without overflow for the count to hold.
+std::optional<uint64_t> InductionAnalysis::ComputeTripCount(const Loop *loop, const LoopBound &bound) const
+{
+    const auto *counter = GetVariable(loop, bound.counter);
+    auto init = GetIntConstant(counter->init);
+    auto boundValue = GetIntConstant(bound.bound);
+    if (!init.has_value() || !boundValue.has_value()) {
+        return std::nullopt;
+    }
+
+    const auto *basis = GetVariable(loop, counter->basis);
+    int64_t start = 0;
+    if (__builtin_mul_overflow(counter->scale, *init, &start) ||
+        __builtin_add_overflow(start, counter->offset, &start)) {
+        return std::nullopt;
+    }
+    auto count = CountIterations(start, counter->step, *boundValue, bound.cc);
+    if (!count.has_value() || !IsInType(start, *count, counter->step, counter->value->GetResultType()) ||
+        !IsInType(*init, *count, basis->step, basis->value->GetResultType())) {
+        return std::nullopt;
+    }
+    return static_cast<uint64_t>(*count);
+}
+
+}  // namespace compiler
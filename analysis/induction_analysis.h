@@ -0,0 +1,49 @@
+#ifndef ANALYSIS_INDUCTION_ANALYSIS_H
+#define ANALYSIS_INDUCTION_ANALYSIS_H
+
+#include "utils/macros.h"
+#include "ir/side_table.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace compiler {
+
+// Finds induction variables of reducible loops and bounds of loops with a single exit,
+// the results are stored in the loops.
+//
+// A basic variable is a header phi which takes one value on entry and `phi + c` on all back edges,
+// derived variables are additions, subtractions and multiplications of them by constants in the loop body.
+// The trip count is computed when the exit test compares a variable with constant initial value to a constant.
+class InductionAnalysis final {
+public:
+    NO_COPY_SEMANTIC(InductionAnalysis);
+    NO_MOVE_SEMANTIC(InductionAnalysis);
+
+    explicit InductionAnalysis(Graph *graph) : graph_(graph) {}
+    ~InductionAnalysis() = default;
+
+    void Run();
+
+private:
+    void CollectBasicVariables(Loop *loop);
+    void CollectDerivedVariables();
+    void AnalyzeBound(Loop *loop);
+    std::optional<uint64_t> ComputeTripCount(const Loop *loop, const LoopBound &bound) const;
+
+    void AddVariable(Loop *loop, const InductionVariable &variable);
+    const InductionVariable *GetVariable(const Loop *loop, const Instruction *value) const;
+
+private:
+    static constexpr uint32_t NO_VARIABLE = UINT32_MAX;
+
+    Graph *graph_ {nullptr};
+
+    // Index of the value in the list of variables of its loop.
+    InsnSideTable<uint32_t> variableIndices_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_INDUCTION_ANALYSIS_H
@@ -0,0 +1,249 @@
+#include "analysis/liveness.h"
+#include "analysis/loop.h"
+#include "ir/graph.h"
+#include "ir/instructions.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace compiler {
+
+bool LiveInterval::IsLiveAt(uint32_t pos) const
+{
+    auto rangeIt = std::upper_bound(ranges_.begin(), ranges_.end(), pos,
+                                    [](uint32_t value, const LiveRange &range) { return value < range.begin; });
+    return rangeIt != ranges_.begin() && pos < std::prev(rangeIt)->end;
+}
+
+// New range never begins after the existing ones, it absorbs all ranges it overlaps or touches.
+void LiveInterval::AddRange(uint32_t begin, uint32_t end)
+{
+    while (!ranges_.empty() && ranges_.back().begin <= end) {
+        assert(begin <= ranges_.back().begin);
+        end = std::max(end, ranges_.back().end);
+        ranges_.pop_back();
+    }
+    ranges_.push_back({begin, end});
+}
+
+// Cuts the first range at the definition, a value without uses gets a minimal range.
+void LiveInterval::SetBegin(uint32_t begin)
+{
+    if (ranges_.empty()) {
+        ranges_.push_back({begin, begin + 1});
+        return;
+    }
+    ranges_.back().begin = begin;
+}
+
+void LiveInterval::Finalize()
+{
+    std::reverse(ranges_.begin(), ranges_.end());
+}
+
+void Liveness::Run()
+{
+    auto *analyses = graph_->GetAnalysisManager();
+    analyses->Run(AnalysisType::RPO);
+    analyses->Run(AnalysisType::LOOP_TREE);
+
+    BuildLinearOrder();
+    NumberInsns();
+    CollectGlobalValues();
+    BuildIntervals();
+}
+
+// Every loop gets the list of its blocks and immediate inner loops in RPO, an inner loop stands at its header.
+// Unrolling the lists from the root loop keeps every loop contiguous, and forward edges still go forward,
+// since a reducible loop is entered only through its header.
+void Liveness::BuildLinearOrder()
+{
+    struct Item {
+        BasicBlock *block {nullptr};
+        Loop *loop {nullptr};
+    };
+
+    auto loopsCount = graph_->GetLoops().size();
+    std::vector<std::vector<Item>> loopItems(loopsCount);
+
+    auto *rootLoop = graph_->GetRootLoop();
+    for (auto *block : graph_->GetRpoVector()) {
+        auto *loop = block->GetLoop();
+        if (loop == nullptr) {
+            loop = rootLoop;
+        } else if (block->IsHeader()) {
+            loopItems[loop->GetOuterLoop()->GetId()].push_back({nullptr, loop});
+        }
+        loopItems[loop->GetId()].push_back({block, nullptr});
+    }
+
+    linearOrder_.clear();
+    loopEnds_.assign(loopsCount, nullptr);
+
+    std::vector<std::pair<Loop *, size_t>> stack;
+    stack.emplace_back(rootLoop, 0);
+    while (!stack.empty()) {
+        auto &[loop, itemIdx] = stack.back();
+        auto &items = loopItems[loop->GetId()];
+        if (itemIdx == items.size()) {
+            loopEnds_[loop->GetId()] = linearOrder_.empty() ? nullptr : linearOrder_.back();
+            stack.pop_back();
+            continue;
+        }
+
+        auto item = items[itemIdx++];
+        if (item.block != nullptr) {
+            linearOrder_.push_back(item.block);
+        } else {
+            stack.emplace_back(item.loop, 0);
+        }
+    }
+}
+
+void Liveness::NumberInsns()
+{
+    linearIdx_ = BlockSideTable<uint32_t>(graph_, UNDEF_IDX);
+    linearNumbers_ = InsnSideTable<uint32_t>(graph_, 0);
+    blockRanges_ = BlockSideTable<LiveRange>(graph_);
+    linearInsns_.clear();
+
+    uint32_t pos = 0;
+    for (uint32_t idx = 0; idx < linearOrder_.size(); ++idx) {
+        auto *block = linearOrder_[idx];
+        linearIdx_[block] = idx;
+
+        auto begin = pos;
+        block->EnumerateInsns([this, &pos](Instruction *insn) {
+            linearNumbers_[insn] = pos;
+            linearInsns_.push_back(insn);
+            pos += LINEAR_STEP;
+            return false;
+        });
+        blockRanges_[block] = {begin, pos};
+    }
+}
+
+// Values used only in their own blocks never appear in live sets, which keeps the bit vectors short.
+void Liveness::CollectGlobalValues()
+{
+    globalIdx_ = InsnSideTable<uint32_t>(graph_, UNDEF_IDX);
+    globalValues_.clear();
+
+    for (auto *insn : linearInsns_) {
+        for (auto &input : insn->GetInputs()) {
+            auto *value = input.GetValue();
+            if (value == nullptr || globalIdx_[value] != UNDEF_IDX) {
+                continue;
+            }
+            // Phi inputs are used at the end of predecessors.
+            if (insn->IsPhi() || value->GetParentBB() != insn->GetParentBB()) {
+                globalIdx_[value] = static_cast<uint32_t>(globalValues_.size());
+                globalValues_.push_back(value);
+            }
+        }
+    }
+}
+
+void Liveness::BuildIntervals()
+{
+    intervals_.assign(linearInsns_.size(), LiveInterval());
+    liveIn_ = BlockSideTable<std::vector<Instruction *>>(graph_);
+
+    LiveSet live(globalValues_.size());
+    LiveSet scratch(globalValues_.size());
+    for (auto blockIt = linearOrder_.rbegin(); blockIt != linearOrder_.rend(); ++blockIt) {
+        ProcessBlock(*blockIt, &live, &scratch);
+    }
+
+    for (auto &interval : intervals_) {
+        interval.Finalize();
+    }
+}
+
+void Liveness::ProcessBlock(BasicBlock *block, LiveSet *live, LiveSet *scratch)
+{
+    auto blockRange = blockRanges_[block];
+
+    // Live-out values: live-in of successors and inputs of their phis coming from this block.
+    live->Clear();
+    for (auto *succ : block->GetSuccessors()) {
+        for (auto *value : liveIn_[succ]) {
+            live->Add(globalIdx_[value]);
+        }
+        for (auto *insn = succ->GetFirstInsn(); insn != nullptr && insn->IsPhi(); insn = insn->GetNext()) {
+            for (auto &dependency : static_cast<PhiInsn *>(insn)->GetDependencies()) {
+                if (dependency.block == block) {
+                    live->Add(globalIdx_[dependency.value]);
+                }
+            }
+        }
+    }
+    for (auto idx : live->GetMembers()) {
+        GetMutableInterval(globalValues_[idx]).AddRange(blockRange.begin, blockRange.end);
+    }
+
+    for (auto *insn = block->GetLastInsn(); insn != nullptr && !insn->IsPhi(); insn = insn->GetPrev()) {
+        auto pos = GetLinearNumber(insn);
+        if (insn->HasResult()) {
+            GetMutableInterval(insn).SetBegin(pos);
+            if (globalIdx_[insn] != UNDEF_IDX) {
+                live->Remove(globalIdx_[insn]);
+            }
+        }
+        for (auto &input : insn->GetInputs()) {
+            auto *value = input.GetValue();
+            if (value == nullptr) {
+                continue;
+            }
+            GetMutableInterval(value).AddRange(blockRange.begin, pos + 1);
+            if (globalIdx_[value] != UNDEF_IDX) {
+                live->Add(globalIdx_[value]);
+            }
+        }
+    }
+
+    // Phis are defined at the beginning of the block.
+    for (auto *insn = block->GetFirstInsn(); insn != nullptr && insn->IsPhi(); insn = insn->GetNext()) {
+        GetMutableInterval(insn).SetBegin(blockRange.begin);
+        if (globalIdx_[insn] != UNDEF_IDX) {
+            live->Remove(globalIdx_[insn]);
+        }
+    }
+
+    if (block->GetLoop() != nullptr && block->IsHeader()) {
+        AddLoopLiveIn(block, *live, scratch);
+    }
+
+    auto &liveIn = liveIn_[block];
+    liveIn.clear();
+    for (auto idx : live->GetMembers()) {
+        liveIn.push_back(globalValues_[idx]);
+    }
+}
+
+// Values live at the header are live through the whole loop, including the back edges,
+// but the blocks of the loop were processed before the header was.
+void Liveness::AddLoopLiveIn(BasicBlock *header, const LiveSet &live, LiveSet *scratch)
+{
+    auto *loopEnd = loopEnds_[header->GetLoop()->GetId()];
+    auto headerBegin = blockRanges_[header].begin;
+    auto loopEndPos = blockRanges_[loopEnd].end;
+    for (auto idx : live.GetMembers()) {
+        GetMutableInterval(globalValues_[idx]).AddRange(headerBegin, loopEndPos);
+    }
+
+    for (auto blockIdx = linearIdx_[header] + 1; blockIdx <= linearIdx_[loopEnd]; ++blockIdx) {
+        auto &liveIn = liveIn_[linearOrder_[blockIdx]];
+        for (auto *value : liveIn) {
+            scratch->Add(globalIdx_[value]);
+        }
+        for (auto idx : live.GetMembers()) {
+            if (scratch->Add(idx)) {
+                liveIn.push_back(globalValues_[idx]);
+            }
+        }
+        scratch->Clear();
+    }
+}
+
+}  // namespace compiler
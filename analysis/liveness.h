@@ -0,0 +1,191 @@
+#ifndef ANALYSIS_LIVENESS_H
+#define ANALYSIS_LIVENESS_H
+
+#include "utils/bit_vector.h"
+#include "utils/macros.h"
+#include "ir/side_table.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace compiler {
+
+class Loop;
+
+// Half-open range of linear numbers.
+struct LiveRange {
+    uint32_t begin {0};
+    uint32_t end {0};
+};
+
+// Ranges where the value is live, sorted and disjoint, the gaps between them are holes.
+// A value is live from its definition up to and including the position of its last use.
+class LiveInterval final {
+public:
+    const std::vector<LiveRange> &GetRanges() const
+    {
+        return ranges_;
+    }
+
+    bool IsEmpty() const
+    {
+        return ranges_.empty();
+    }
+
+    uint32_t GetBegin() const
+    {
+        assert(!IsEmpty());
+        return ranges_.front().begin;
+    }
+
+    uint32_t GetEnd() const
+    {
+        assert(!IsEmpty());
+        return ranges_.back().end;
+    }
+
+    bool IsLiveAt(uint32_t pos) const;
+
+private:
+    // While building, ranges are kept in decreasing order, since blocks are processed from the end.
+    void AddRange(uint32_t begin, uint32_t end);
+    void SetBegin(uint32_t begin);
+    void Finalize();
+
+private:
+    std::vector<LiveRange> ranges_;
+
+    friend class Liveness;
+};
+
+// Set of global values with membership in a bit vector and members in a list,
+// so clearing and iteration cost the size of the set rather than the number of global values.
+class LiveSet final {
+public:
+    explicit LiveSet(size_t valuesCount) : bits_(valuesCount), positions_(valuesCount, 0) {}
+
+    // Returns whether the value was added.
+    bool Add(uint32_t idx)
+    {
+        if (bits_.Test(idx)) {
+            return false;
+        }
+        bits_.Set(idx);
+        positions_[idx] = static_cast<uint32_t>(members_.size());
+        members_.push_back(idx);
+        return true;
+    }
+
+    void Remove(uint32_t idx)
+    {
+        if (bits_.Test(idx)) {
+            bits_.Reset(idx);
+            auto last = members_.back();
+            members_[positions_[idx]] = last;
+            positions_[last] = positions_[idx];
+            members_.pop_back();
+        }
+    }
+
+    void Clear()
+    {
+        for (auto idx : members_) {
+            bits_.Reset(idx);
+        }
+        members_.clear();
+    }
+
+    const std::vector<uint32_t> &GetMembers() const
+    {
+        return members_;
+    }
+
+private:
+    utils::BitVector bits_;
+    // Position of every member in members_.
+    std::vector<uint32_t> positions_;
+    std::vector<uint32_t> members_;
+};
+
+// Linear order of blocks where every loop occupies a contiguous range, live-in sets and live intervals over it (Wimmer and Franz, "Linear Scan Register Allocation on SSA Form").
+// Instructions are numbered in the linear order with LINEAR_STEP, which leaves room for moves inserted later.
+// Irreducible loops are not guaranteed to be contiguous, so the intervals of values live around them are approximate.
+class Liveness final {
+public:
+    NO_COPY_SEMANTIC(Liveness);
+    NO_MOVE_SEMANTIC(Liveness);
+
+    static constexpr uint32_t LINEAR_STEP = 2U;
+
+    explicit Liveness(Graph *graph) : graph_(graph) {}
+    ~Liveness() = default;
+
+    void Run();
+
+    const std::vector<BasicBlock *> &GetLinearOrder() const
+    {
+        return linearOrder_;
+    }
+
+    uint32_t GetLinearNumber(const Instruction *insn) const
+    {
+        return linearNumbers_[insn];
+    }
+
+    // Positions of the first instruction and after the last one.
+    LiveRange GetBlockRange(const BasicBlock *block) const
+    {
+        return blockRanges_[block];
+    }
+
+    // Values used out of their blocks (including phi inputs) which are live at the beginning of the block.
+    const std::vector<Instruction *> &GetLiveIn(const BasicBlock *block) const
+    {
+        return liveIn_[block];
+    }
+
+    const LiveInterval &GetInterval(const Instruction *insn) const
+    {
+        return intervals_[GetLinearNumber(insn) / LINEAR_STEP];
+    }
+
+private:
+    static constexpr uint32_t UNDEF_IDX = UINT32_MAX;
+
+    void BuildLinearOrder();
+    void NumberInsns();
+    void CollectGlobalValues();
+    void BuildIntervals();
+    void ProcessBlock(BasicBlock *block, LiveSet *live, LiveSet *scratch);
+    void AddLoopLiveIn(BasicBlock *header, const LiveSet &live, LiveSet *scratch);
+
+    LiveInterval &GetMutableInterval(const Instruction *insn)
+    {
+        return intervals_[GetLinearNumber(insn) / LINEAR_STEP];
+    }
+
+private:
+    Graph *graph_ {nullptr};
+
+    std::vector<BasicBlock *> linearOrder_;
+    // Indexed by loop id, the last block of the loop in the linear order.
+    std::vector<BasicBlock *> loopEnds_;
+
+    BlockSideTable<uint32_t> linearIdx_;
+
+    InsnSideTable<uint32_t> linearNumbers_;
+    BlockSideTable<LiveRange> blockRanges_;
+    std::vector<Instruction *> linearInsns_;
+
+    InsnSideTable<uint32_t> globalIdx_;
+    std::vector<Instruction *> globalValues_;
+
+    BlockSideTable<std::vector<Instruction *>> liveIn_;
+    // Indexed by linear number divided by LINEAR_STEP.
+    std::vector<LiveInterval> intervals_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_LIVENESS_H
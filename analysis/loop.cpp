@@ -0,0 +1,15 @@
+#include "analysis/loop.h"
+#include "ir/basic_block.h"
+
+namespace compiler {
+
+bool Loop::Contains(const BasicBlock *block) const
+{
+    if (isRoot_) {
+        return true;
+    }
+    const auto *blockLoop = block->GetLoop();
+    return blockLoop != nullptr && Contains(blockLoop);
+}
+
+}  // namespace compiler
@@ -1,21 +1,88 @@
 #ifndef ANALYSIS_LOOP_H
 #define ANALYSIS_LOOP_H
 
-#include <vector>
+#include "utils/arena_allocator.h"
+
+#include <cstdint>
+#include <optional>
 
 namespace compiler {
 
 class BasicBlock;
+class Instruction;
+
+// Integer value which changes by a constant step on every iteration of the loop:
+// on iteration k it equals `scale * (init + k * basisStep) + offset`, i.e. `start + k * step`.
+// Basic variables are header phis with scale 1 and offset 0, derived ones are affine functions of them.
+struct InductionVariable {
+    Instruction *value {nullptr};
+    // Header phi of the basic variable.
+    Instruction *basis {nullptr};
+    // Value of the basis on entry to the loop.
+    Instruction *init {nullptr};
+    int64_t scale {1};
+    int64_t offset {0};
+    int64_t step {0};
+
+    bool IsBasic() const
+    {
+        return value == basis;
+    }
+};
+
+enum class ConditionCode : uint8_t { EQ, NE, LT, LE, GT, GE };
+
+// The only exit test of the loop: iterations go on while `counter <cc> bound` holds.
+struct LoopBound {
+    // Induction variable of the loop.
+    Instruction *counter {nullptr};
+    Instruction *bound {nullptr};
+    ConditionCode cc {ConditionCode::NE};
+    // Block with the exit branch, it dominates all latches.
+    BasicBlock *exitingBlock {nullptr};
+};
+
+// Edge from a block of the loop to a block outside of it.
+struct LoopEdge {
+    BasicBlock *from {nullptr};
+    BasicBlock *to {nullptr};
+};
 
 class Loop final {
 public:
-    Loop(BasicBlock *header) : header_(header) {}
+    Loop(utils::ArenaAllocator *allocator, BasicBlock *header)
+        : header_(header),
+          latches_(allocator->Adapter<BasicBlock *>()),
+          blocks_(allocator->Adapter<BasicBlock *>()),
+          innerLoops_(allocator->Adapter<Loop *>()),
+          exitEdges_(allocator->Adapter<LoopEdge>()),
+          exitBlocks_(allocator->Adapter<BasicBlock *>()),
+          inductionVariables_(allocator->Adapter<InductionVariable>())
+    {
+    }
+
+    void SetId(size_t id)
+    {
+        id_ = id;
+    }
+
+    // Index in the list of all loops of the graph.
+    size_t GetId() const
+    {
+        return id_;
+    }
 
     void MarkAsRoot()
     {
         isRoot_ = true;
     }
 
+    // The root loop holds blocks which are not in any loop.
+    bool IsRoot() const
+    {
+        return isRoot_;
+    }
+
     void AddLatch(BasicBlock *latch)
     {
         latches_.push_back(latch);
@@ -26,11 +93,71 @@ public:
         blocks_.push_back(block);
     }
 
-    const std::vector<BasicBlock *> GetBlocks() const
+    // Whether the block belongs to the loop or to one of its inner loops, the root loop contains all blocks.
+    // Inner loops have nested intervals in DFS over the loop tree, so the check takes constant time.
+    bool Contains(const BasicBlock *block) const;
+
+    bool Contains(const Loop *loop) const
+    {
+        return treeIn_ <= loop->treeIn_ && loop->treeOut_ <= treeOut_;
+    }
+
+    void SetTreeInterval(uint32_t in, uint32_t out)
+    {
+        treeIn_ = in;
+        treeOut_ = out;
+    }
+
+    // Blocks whose innermost loop is this one, blocks of inner loops are not included.
+    const utils::ArenaVector<BasicBlock *> &GetBlocks() const
     {
         return blocks_;
     }
 
+    // The root loop has depth 0, outermost loops have depth 1.
+    uint32_t GetDepth() const
+    {
+        return depth_;
+    }
+
+    void SetDepth(uint32_t depth)
+    {
+        depth_ = depth;
+    }
+
+    // The only predecessor of the header outside of the loop if it has no other successors, otherwise null.
+    BasicBlock *GetPreheader() const
+    {
+        return preheader_;
+    }
+
+    void SetPreheader(BasicBlock *preheader)
+    {
+        preheader_ = preheader;
+    }
+
+    // Edges leaving the loop, including edges from inner loops which leave this one too.
+    const utils::ArenaVector<LoopEdge> &GetExitEdges() const
+    {
+        return exitEdges_;
+    }
+
+    void AddExitEdge(BasicBlock *from, BasicBlock *to)
+    {
+        exitEdges_.push_back({from, to});
+    }
+
+    // Distinct targets of the exit edges.
+    const utils::ArenaVector<BasicBlock *> &GetExitBlocks() const
+    {
+        return exitBlocks_;
+    }
+
+    void AddExitBlock(BasicBlock *block)
+    {
+        exitBlocks_.push_back(block);
+    }
+
     void SetReducible(bool reducible)
     {
         isReducible_ = reducible;
@@ -46,7 +173,7 @@ public:
         return header_;
     }
 
-    const std::vector<BasicBlock *> &GetLatches() const
+    const utils::ArenaVector<BasicBlock *> &GetLatches() const
     {
         return latches_;
     }
@@ -61,7 +188,7 @@ public:
         outerLoop_ = outerLoop;
     }
 
-    const std::vector<Loop *> &GetInnerLoops() const
+    const utils::ArenaVector<Loop *> &GetInnerLoops() const
     {
         return innerLoops_;
     }
@@ -71,13 +198,67 @@ public:
         innerLoops_.push_back(loop);
     }
 
+    // Induction variables, the bound and the trip count are valid along with AnalysisType::INDUCTION_VARIABLES.
+    const utils::ArenaVector<InductionVariable> &GetInductionVariables() const
+    {
+        return inductionVariables_;
+    }
+
+    const InductionVariable *GetInductionVariable(const Instruction *value) const
+    {
+        for (const auto &variable : inductionVariables_) {
+            if (variable.value == value) {
+                return &variable;
+            }
+        }
+        return nullptr;
+    }
+
+    utils::ArenaVector<InductionVariable> &GetInductionVariables()
+    {
+        return inductionVariables_;
+    }
+
+    const std::optional<LoopBound> &GetBound() const
+    {
+        return bound_;
+    }
+
+    void SetBound(const std::optional<LoopBound> &bound)
+    {
+        bound_ = bound;
+    }
+
+    // How many times the back edge is taken, when it is known at compile time.
+    std::optional<uint64_t> GetTripCount() const
+    {
+        return tripCount_;
+    }
+
+    void SetTripCount(std::optional<uint64_t> tripCount)
+    {
+        tripCount_ = tripCount;
+    }
+
 private:
+    size_t id_ {0};
     BasicBlock *header_ {nullptr};
-    std::vector<BasicBlock *> latches_;
-    std::vector<BasicBlock *> blocks_;
+    utils::ArenaVector<BasicBlock *> latches_;
+    utils::ArenaVector<BasicBlock *> blocks_;
 
     Loop *outerLoop_ {nullptr};
-    std::vector<Loop *> innerLoops_;
+    utils::ArenaVector<Loop *> innerLoops_;
+    uint32_t depth_ {0};
+    uint32_t treeIn_ {0};
+    uint32_t treeOut_ {0};
+
+    BasicBlock *preheader_ {nullptr};
+    utils::ArenaVector<LoopEdge> exitEdges_;
+    utils::ArenaVector<BasicBlock *> exitBlocks_;
+
+    utils::ArenaVector<InductionVariable> inductionVariables_;
+    std::optional<LoopBound> bound_;
+    std::optional<uint64_t> tripCount_;
 
     bool isReducible_ {false};
     bool isRoot_ {false};
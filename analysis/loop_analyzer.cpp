@@ -1,26 +1,36 @@
 #include "analysis/loop_analyzer.h"
 #include "analysis/loop.h"
+#include "analysis/graph_traversal.h"
 
 #include "ir/graph.h"
 #include "ir/basic_block.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace compiler {
 
 void LoopAnalyzer::Run()
 {
-    graph_->BuildDominatorTree();
+    graph_->GetAnalysisManager()->Run(AnalysisType::DOMINATOR_TREE);
     CreateRootLoop();
     CollectLatches();
     PopulateLoops();
     BuildLoopTree();
+    NumberLoops();
+    CollectExits();
 }
 
 void LoopAnalyzer::CreateRootLoop()
 {
-    auto rootLoop = std::make_unique<Loop>(nullptr);
-    rootLoop->MarkAsRoot();
-    rootLoop_ = rootLoop.get();
-    graph_->SetRootLoop(std::move(rootLoop));
+    // Forget loops of the previous run.
+    for (auto *block : graph_->GetBlocks()) {
+        block->SetLoop(nullptr);
+    }
+
+    rootLoop_ = graph_->CreateNewLoop(nullptr);
+    rootLoop_->MarkAsRoot();
+    graph_->SetRootLoop(rootLoop_);
 }
 
 void LoopAnalyzer::CollectLatches()
@@ -28,29 +38,33 @@ void LoopAnalyzer::CollectLatches()
     blackMrk_ = graph_->CreateNewMarker();
     grayMrk_ = graph_->CreateNewMarker();
 
-    auto *root = graph_->GetStartBlock();
-    SearchLatchDFS(root);
+    // Gray blocks are on the DFS stack, an edge to a gray block is a back edge.
+    struct Visitor {
+        void PreOrder(BasicBlock *block)
+        {
+            block->SetMarker(analyzer->grayMrk_);
+        }
 
-    graph_->EraseMarker(blackMrk_);
-    graph_->EraseMarker(grayMrk_);
-}
+        void PostOrder(BasicBlock *block)
+        {
+            block->EraseMarker(analyzer->grayMrk_);
+        }
 
-void LoopAnalyzer::SearchLatchDFS(BasicBlock *block)
-{
-    assert(block);
+        void VisitedEdge(BasicBlock *from, BasicBlock *to)
+        {
+            if (to->IsMarked(analyzer->grayMrk_)) {
+                analyzer->ProcessNewLatch(to, from);
+            }
+        }
 
-    block->SetMarker(blackMrk_);
-    block->SetMarker(grayMrk_);
+        LoopAnalyzer *analyzer;
+    };
 
-    for (auto *succBlock : block->GetSuccessors()) {
-        if (succBlock->IsMarked(grayMrk_)) {
-            ProcessNewLatch(succBlock, block);
-        } else if (!succBlock->IsMarked(blackMrk_)) {
-            SearchLatchDFS(succBlock);
-        }
-    }
+    GraphTraversal traversal(graph_);
+    traversal.Run(graph_->GetStartBlock(), blackMrk_, Visitor {this});
 
-    block->EraseMarker(grayMrk_);
+    graph_->EraseMarker(blackMrk_);
+    graph_->EraseMarker(grayMrk_);
 }
 
 void LoopAnalyzer::ProcessNewLatch(BasicBlock *header, BasicBlock *latch)
@@ -101,28 +115,102 @@ void LoopAnalyzer::BuildLoopTree()
     }
 }
 
+// Depth and DFS intervals of loops in the loop tree, the interval of a loop encloses intervals of its inner loops.
+void LoopAnalyzer::NumberLoops()
+{
+    struct Entry {
+        Loop *loop;
+        size_t nextInner;
+        uint32_t in;
+    };
+
+    uint32_t counter = 0;
+    std::vector<Entry> stack {{rootLoop_, 0, counter++}};
+    rootLoop_->SetDepth(0);
+    while (!stack.empty()) {
+        auto &entry = stack.back();
+        if (entry.nextInner == entry.loop->GetInnerLoops().size()) {
+            entry.loop->SetTreeInterval(entry.in, counter - 1);
+            stack.pop_back();
+            continue;
+        }
+        auto *inner = entry.loop->GetInnerLoops()[entry.nextInner++];
+        inner->SetDepth(entry.loop->GetDepth() + 1);
+        stack.push_back({inner, 0, counter++});
+    }
+}
+
+void LoopAnalyzer::CollectExits()
+{
+    for (auto *block : graph_->GetRpoVector()) {
+        for (auto *succ : block->GetSuccessors()) {
+            for (auto *loop = block->GetLoop(); loop != nullptr && !loop->Contains(succ); loop = loop->GetOuterLoop()) {
+                loop->AddExitEdge(block, succ);
+            }
+        }
+    }
+
+    std::vector<Loop *> loops(rootLoop_->GetInnerLoops().begin(), rootLoop_->GetInnerLoops().end());
+    std::vector<BasicBlock *> exitBlocks;
+    while (!loops.empty()) {
+        auto *loop = loops.back();
+        loops.pop_back();
+        loops.insert(loops.end(), loop->GetInnerLoops().begin(), loop->GetInnerLoops().end());
+
+        exitBlocks.clear();
+        for (const auto &edge : loop->GetExitEdges()) {
+            exitBlocks.push_back(edge.to);
+        }
+        std::sort(exitBlocks.begin(), exitBlocks.end(),
+                  [](const BasicBlock *lhs, const BasicBlock *rhs) { return lhs->GetId() < rhs->GetId(); });
+        exitBlocks.erase(std::unique(exitBlocks.begin(), exitBlocks.end()), exitBlocks.end());
+        for (auto *exitBlock : exitBlocks) {
+            loop->AddExitBlock(exitBlock);
+        }
+
+        BasicBlock *preheader = nullptr;
+        size_t outsidePredsCount = 0;
+        for (auto *pred : loop->GetHeader()->GetPredecessors()) {
+            if (!loop->Contains(pred)) {
+                preheader = pred;
+                ++outsidePredsCount;
+            }
+        }
+        if (outsidePredsCount == 1U && preheader->GetSuccessors().size() == 1U) {
+            loop->SetPreheader(preheader);
+        }
+    }
+}
+
 void LoopAnalyzer::ProcessReducibleLoopHeader(Loop *loop, BasicBlock *header)
 {
     blackMrk_ = graph_->CreateNewMarker();
 
+    // Walk backwards from the latches, the marked header stops the walk.
+    struct Visitor {
+        void PreOrder(BasicBlock *block)
+        {
+            analyzer->AddBlockToLoop(loop, block);
+        }
+
+        LoopAnalyzer *analyzer;
+        Loop *loop;
+    };
+
     header->SetMarker(blackMrk_);
+    GraphTraversal<TraversalDirection::BACKWARD> traversal(graph_);
     for (auto *latch : loop->GetLatches()) {
-        LoopSearchDFS(loop, latch);
+        traversal.Run(latch, blackMrk_, Visitor {this, loop});
     }
 
     graph_->EraseMarker(blackMrk_);
 }
 
-void LoopAnalyzer::LoopSearchDFS(Loop *loop, BasicBlock *block)
+void LoopAnalyzer::AddBlockToLoop(Loop *loop, BasicBlock *block)
 {
     assert(loop);
     assert(block);
 
-    if (block->IsMarked(blackMrk_)) {
-        return;
-    }
-    block->SetMarker(blackMrk_);
-
     auto *blockLoop = block->GetLoop();
     if (blockLoop == nullptr) {
         loop->PushBlock(block);
@@ -134,10 +222,6 @@ void LoopAnalyzer::LoopSearchDFS(Loop *loop, BasicBlock *block)
             loop->AddInnerLoop(blockLoop);
         }
     }
-
-    for (auto *predecessor : block->GetPredecessors()) {
-        LoopSearchDFS(loop, predecessor);
-    }
 }
 
 void LoopAnalyzer::ProcessIrreducibleLoopHeader(Loop *loop)
@@ -26,14 +26,15 @@ private:
     void CollectLatches();
     void PopulateLoops();
     void BuildLoopTree();
+    void NumberLoops();
+    void CollectExits();
 
-    void SearchLatchDFS(BasicBlock *block);
     void ProcessNewLatch(BasicBlock *header, BasicBlock *latch);
 
     void ProcessReducibleLoopHeader(Loop *loop, BasicBlock *header);
     void ProcessIrreducibleLoopHeader(Loop *loop);
 
-    void LoopSearchDFS(Loop *loop, BasicBlock *block);
+    void AddBlockToLoop(Loop *loop, BasicBlock *block);
 
 private:
     Graph *graph_ {nullptr};
@@ -0,0 +1,176 @@
+#include "analysis/post_dominator_tree.h"
+#include "ir/graph.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace compiler {
+
+void PostDominatorTree::Build()
+{
+    CollectReverseCfg();
+    ComputeReversePostOrder();
+    CalculateImmediatePostDominators();
+    BuildTree();
+}
+
+// Predecessors are derived from successors, since only the latter are required to be set in CFG.
+void PostDominatorTree::CollectReverseCfg()
+{
+    auto &blocks = graph_->GetBlocks();
+    auto exitNode = static_cast<uint32_t>(blocks.size());
+
+    revSuccsBegin_.assign(blocks.size() + 2, 0);
+    for (auto *block : blocks) {
+        for (auto *succ : block->GetSuccessors()) {
+            ++revSuccsBegin_[succ->GetId() + 1];
+        }
+        if (block->GetSuccessors().empty()) {
+            ++revSuccsBegin_[exitNode + 1];
+        }
+    }
+    for (size_t idx = 1; idx < revSuccsBegin_.size(); ++idx) {
+        revSuccsBegin_[idx] += revSuccsBegin_[idx - 1];
+    }
+
+    revSuccs_.resize(revSuccsBegin_.back());
+    std::vector<uint32_t> filled(revSuccsBegin_.begin(), revSuccsBegin_.end() - 1);
+    for (auto *block : blocks) {
+        auto node = static_cast<uint32_t>(block->GetId());
+        for (auto *succ : block->GetSuccessors()) {
+            revSuccs_[filled[succ->GetId()]++] = node;
+        }
+        if (block->GetSuccessors().empty()) {
+            revSuccs_[filled[exitNode]++] = node;
+        }
+    }
+}
+
+// Iterative DFS over the reverse CFG from the virtual exit.
+void PostDominatorTree::ComputeReversePostOrder()
+{
+    auto exitNode = static_cast<uint32_t>(graph_->GetBlocks().size());
+
+    order_.clear();
+    orderIdx_.assign(exitNode + 1, UNDEF_IDX);
+
+    // Any value other than UNDEF_IDX marks a visited node until the final positions are assigned.
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    orderIdx_[exitNode] = 0;
+    stack.emplace_back(exitNode, revSuccsBegin_[exitNode]);
+    while (!stack.empty()) {
+        auto &[node, succPos] = stack.back();
+        if (succPos < revSuccsBegin_[node + 1]) {
+            auto succ = revSuccs_[succPos++];
+            if (orderIdx_[succ] == UNDEF_IDX) {
+                orderIdx_[succ] = 0;
+                stack.emplace_back(succ, revSuccsBegin_[succ]);
+            }
+            continue;
+        }
+        order_.push_back(node);
+        stack.pop_back();
+    }
+
+    std::reverse(order_.begin(), order_.end());
+    for (uint32_t pos = 0; pos < order_.size(); ++pos) {
+        orderIdx_[order_[pos]] = pos;
+    }
+}
+
+void PostDominatorTree::CalculateImmediatePostDominators()
+{
+    auto &blocks = graph_->GetBlocks();
+
+    ipdomIdx_.assign(order_.size(), UNDEF_IDX);
+    ipdomIdx_[0] = 0;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (uint32_t pos = 1; pos < order_.size(); ++pos) {
+            auto *block = blocks[order_[pos]];
+            // Predecessors in reverse CFG are successors, blocks without them go to the virtual exit.
+            uint32_t newIpdom = block->GetSuccessors().empty() ? 0 : UNDEF_IDX;
+            for (auto *succ : block->GetSuccessors()) {
+                auto succPos = orderIdx_[succ->GetId()];
+                // Skip successors which can't reach the exit or are not processed yet.
+                if (succPos == UNDEF_IDX || ipdomIdx_[succPos] == UNDEF_IDX) {
+                    continue;
+                }
+                newIpdom = (newIpdom == UNDEF_IDX) ? succPos : Intersect(succPos, newIpdom);
+            }
+
+            assert(newIpdom != UNDEF_IDX);
+            if (ipdomIdx_[pos] != newIpdom) {
+                ipdomIdx_[pos] = newIpdom;
+                changed = true;
+            }
+        }
+    }
+}
+
+uint32_t PostDominatorTree::Intersect(uint32_t lhs, uint32_t rhs) const
+{
+    while (lhs != rhs) {
+        while (lhs > rhs) {
+            lhs = ipdomIdx_[lhs];
+        }
+        while (rhs > lhs) {
+            rhs = ipdomIdx_[rhs];
+        }
+    }
+    return lhs;
+}
+
+// Links blocks to their immediate post-dominators and numbers the tree with an iterative DFS,
+// a block is entered before and left after all blocks it post-dominates.
+void PostDominatorTree::BuildTree()
+{
+    auto &blocks = graph_->GetBlocks();
+    auto exitNode = static_cast<uint32_t>(blocks.size());
+
+    ipdoms_ = BlockSideTable<BasicBlock *>(graph_, nullptr);
+    treeIn_ = BlockSideTable<uint32_t>(graph_, 0);
+    treeOut_ = BlockSideTable<uint32_t>(graph_, 0);
+
+    childrenBegin_.assign(exitNode + 2, 0);
+    for (uint32_t pos = 1; pos < order_.size(); ++pos) {
+        ++childrenBegin_[order_[ipdomIdx_[pos]] + 1];
+    }
+    for (size_t idx = 1; idx < childrenBegin_.size(); ++idx) {
+        childrenBegin_[idx] += childrenBegin_[idx - 1];
+    }
+
+    children_.resize(childrenBegin_.back());
+    std::vector<uint32_t> filled(childrenBegin_.begin(), childrenBegin_.end() - 1);
+    for (uint32_t pos = 1; pos < order_.size(); ++pos) {
+        auto *block = blocks[order_[pos]];
+        auto parent = order_[ipdomIdx_[pos]];
+        if (parent != exitNode) {
+            ipdoms_[block] = blocks[parent];
+        }
+        children_[filled[parent]++] = block;
+    }
+
+    // The virtual exit takes number 1, so 0 means that a block is out of the tree.
+    uint32_t counter = 1;
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    stack.emplace_back(exitNode, childrenBegin_[exitNode]);
+    while (!stack.empty()) {
+        auto &[node, childPos] = stack.back();
+        if (childPos < childrenBegin_[node + 1]) {
+            auto *child = children_[childPos++];
+            treeIn_[child] = ++counter;
+            stack.emplace_back(child->GetId(), childrenBegin_[child->GetId()]);
+            continue;
+        }
+        if (node != exitNode) {
+            treeOut_[blocks[node]] = ++counter;
+        }
+        stack.pop_back();
+    }
+}
+
+}  // namespace compiler
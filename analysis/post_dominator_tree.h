@@ -0,0 +1,88 @@
+#ifndef ANALYSIS_POST_DOMINATOR_TREE_H
+#define ANALYSIS_POST_DOMINATOR_TREE_H
+
+#include "utils/macros.h"
+#include "ir/side_table.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace compiler {
+
+// Post-dominators over the reverse CFG rooted at a virtual exit, whose predecessors are all blocks without successors
+// (i.e. ending with Ret). Built with the same Cooper-Harvey-Kennedy iteration as DominatorTree.
+// Blocks which cannot reach any exit (e.g. infinite loops) are not in the tree.
+class PostDominatorTree final {
+public:
+    NO_COPY_SEMANTIC(PostDominatorTree);
+    NO_MOVE_SEMANTIC(PostDominatorTree);
+
+    explicit PostDominatorTree(Graph *graph) : graph_(graph) {}
+    ~PostDominatorTree() = default;
+
+    void Build();
+
+    // nullptr for blocks post-dominated only by the virtual exit and for blocks out of the tree.
+    BasicBlock *GetImmediatePostDominator(const BasicBlock *block) const
+    {
+        return ipdoms_[block];
+    }
+
+    bool IsInTree(const BasicBlock *block) const
+    {
+        return treeIn_[block] != 0;
+    }
+
+    // Whether all paths from `block` to the exit go through `postDominator`, every block post-dominates itself.
+    bool IsPostDominatesOver(const BasicBlock *postDominator, const BasicBlock *block) const
+    {
+        if (postDominator == block) {
+            return true;
+        }
+        return IsInTree(postDominator) && treeIn_[postDominator] <= treeIn_[block] &&
+               treeOut_[block] <= treeOut_[postDominator];
+    }
+
+    // Blocks whose immediate post-dominator is `block`.
+    std::span<BasicBlock *const> GetPostDominatedBlocks(const BasicBlock *block) const
+    {
+        auto id = block->GetId();
+        return {children_.data() + childrenBegin_[id], children_.data() + childrenBegin_[id + 1]};
+    }
+
+private:
+    static constexpr uint32_t UNDEF_IDX = UINT32_MAX;
+
+    void CollectReverseCfg();
+    void ComputeReversePostOrder();
+    void CalculateImmediatePostDominators();
+    uint32_t Intersect(uint32_t lhs, uint32_t rhs) const;
+    void BuildTree();
+
+private:
+    Graph *graph_ {nullptr};
+
+    // Nodes of the reverse CFG are block ids, the virtual exit is the last node.
+    // Successors in reverse CFG (i.e. predecessors) of node `n` occupy [revSuccsBegin_[n], revSuccsBegin_[n + 1]).
+    std::vector<uint32_t> revSuccsBegin_;
+    std::vector<uint32_t> revSuccs_;
+
+    // Reverse post-order of the reverse CFG, starts with the virtual exit.
+    std::vector<uint32_t> order_;
+    // Indexed by node, UNDEF_IDX for nodes which don't reach the exit.
+    std::vector<uint32_t> orderIdx_;
+    // Indexed by position in order_.
+    std::vector<uint32_t> ipdomIdx_;
+
+    BlockSideTable<BasicBlock *> ipdoms_;
+    BlockSideTable<uint32_t> treeIn_;
+    BlockSideTable<uint32_t> treeOut_;
+    std::vector<uint32_t> childrenBegin_;
+    std::vector<BasicBlock *> children_;
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_POST_DOMINATOR_TREE_H
@@ -0,0 +1,513 @@
+#include "analysis/range_analysis.h"
+#include "ir/graph.h"
+#include "ir/instructions.h"
+
+#include <algorithm>
+#include <array>
+
+namespace compiler {
+
+static bool IsIntegerType(DataType type)
+{
+    switch (type) {
+        case DataType::I8:
+        case DataType::U8:
+        case DataType::I16:
+        case DataType::U16:
+        case DataType::I32:
+        case DataType::U32:
+        case DataType::I64:
+        case DataType::U64:
+            return true;
+        default:
+            return false;
+    }
+}
+
+ValueRange ValueRange::ForType(DataType type)
+{
+    switch (type) {
+        case DataType::I8:
+            return {INT8_MIN, INT8_MAX};
+        case DataType::U8:
+            return {0, UINT8_MAX};
+        case DataType::I16:
+            return {INT16_MIN, INT16_MAX};
+        case DataType::U16:
+            return {0, UINT16_MAX};
+        case DataType::I32:
+            return {INT32_MIN, INT32_MAX};
+        case DataType::U32:
+            return {0, UINT32_MAX};
+        default:
+            return Full();
+    }
+}
+
+// Result of an operation which overflows the type wraps around, so nothing is known about it.
+static ValueRange FitToType(const ValueRange &range, DataType type)
+{
+    auto typeRange = ValueRange::ForType(type);
+    return typeRange.Contains(range) ? range : typeRange;
+}
+
+static ValueRange AddRanges(const ValueRange &lhs, const ValueRange &rhs)
+{
+    int64_t min = 0;
+    int64_t max = 0;
+    if (__builtin_add_overflow(lhs.GetMin(), rhs.GetMin(), &min) ||
+        __builtin_add_overflow(lhs.GetMax(), rhs.GetMax(), &max)) {
+        return ValueRange::Full();
+    }
+    return {min, max};
+}
+
+static ValueRange SubRanges(const ValueRange &lhs, const ValueRange &rhs)
+{
+    int64_t min = 0;
+    int64_t max = 0;
+    if (__builtin_sub_overflow(lhs.GetMin(), rhs.GetMax(), &min) ||
+        __builtin_sub_overflow(lhs.GetMax(), rhs.GetMin(), &max)) {
+        return ValueRange::Full();
+    }
+    return {min, max};
+}
+
+static ValueRange MulRanges(const ValueRange &lhs, const ValueRange &rhs)
+{
+    std::array<int64_t, 4U> products {};
+    if (__builtin_mul_overflow(lhs.GetMin(), rhs.GetMin(), &products[0]) ||
+        __builtin_mul_overflow(lhs.GetMin(), rhs.GetMax(), &products[1]) ||
+        __builtin_mul_overflow(lhs.GetMax(), rhs.GetMin(), &products[2]) ||
+        __builtin_mul_overflow(lhs.GetMax(), rhs.GetMax(), &products[3])) {
+        return ValueRange::Full();
+    }
+    auto [min, max] = std::minmax_element(products.begin(), products.end());
+    return {*min, *max};
+}
+
+// Quotient is monotone in both operands while the divisor keeps its sign, so the corners bound it.
+static ValueRange DivRanges(const ValueRange &lhs, const ValueRange &rhs)
+{
+    if (rhs.GetMin() <= 0 && rhs.GetMax() >= 0) {
+        return ValueRange::Full();
+    }
+    if (lhs.GetMin() == ValueRange::MIN && rhs.GetMax() == -1) {
+        return ValueRange::Full();
+    }
+    std::array<int64_t, 4U> quotients {lhs.GetMin() / rhs.GetMin(), lhs.GetMin() / rhs.GetMax(),
+                                       lhs.GetMax() / rhs.GetMin(), lhs.GetMax() / rhs.GetMax()};
+    auto [min, max] = std::minmax_element(quotients.begin(), quotients.end());
+    return {*min, *max};
+}
+
+// Remainder takes the sign of the dividend and is less than the divisor by magnitude.
+static ValueRange RemRanges(const ValueRange &lhs, const ValueRange &rhs)
+{
+    if (rhs.GetMin() <= 0) {
+        return ValueRange::Full();
+    }
+    auto bound = rhs.GetMax() - 1;
+    if (lhs.GetMin() >= 0) {
+        return {0, std::min(lhs.GetMax(), bound)};
+    }
+    if (lhs.GetMax() <= 0) {
+        return {std::max(lhs.GetMin(), -bound), 0};
+    }
+    return {-bound, bound};
+}
+
+// Largest value with the same number of significant bits as `value`, which must be non-negative.
+static int64_t FillLowBits(int64_t value)
+{
+    auto bits = static_cast<uint64_t>(value);
+    bits |= bits >> 1U;
+    bits |= bits >> 2U;
+    bits |= bits >> 4U;
+    bits |= bits >> 8U;
+    bits |= bits >> 16U;
+    bits |= bits >> 32U;
+    return static_cast<int64_t>(bits);
+}
+
+static ValueRange BitwiseRanges(Opcode opcode, const ValueRange &lhs, const ValueRange &rhs)
+{
+    bool isLhsPositive = lhs.GetMin() >= 0;
+    bool isRhsPositive = rhs.GetMin() >= 0;
+
+    if (opcode == Opcode::AND) {
+        if (isLhsPositive && isRhsPositive) {
+            return {0, std::min(lhs.GetMax(), rhs.GetMax())};
+        }
+        if (isLhsPositive || isRhsPositive) {
+            return {0, isLhsPositive ? lhs.GetMax() : rhs.GetMax()};
+        }
+        return ValueRange::Full();
+    }
+
+    if (!isLhsPositive || !isRhsPositive) {
+        return ValueRange::Full();
+    }
+    auto max = FillLowBits(std::max(lhs.GetMax(), rhs.GetMax()));
+    auto min = (opcode == Opcode::OR) ? std::max(lhs.GetMin(), rhs.GetMin()) : 0;
+    return {min, max};
+}
+
+static ValueRange ShiftRanges(Opcode opcode, const ValueRange &lhs, const ValueRange &rhs)
+{
+    constexpr int64_t MAX_SHIFT = 63;
+    if (rhs.GetMin() < 0 || rhs.GetMax() > MAX_SHIFT) {
+        return ValueRange::Full();
+    }
+    auto minShift = rhs.GetMin();
+    auto maxShift = rhs.GetMax();
+
+    if (opcode == Opcode::SHL) {
+        if (maxShift == MAX_SHIFT) {
+            return ValueRange::Full();
+        }
+        auto minFactor = static_cast<int64_t>(uint64_t {1} << static_cast<uint64_t>(minShift));
+        auto maxFactor = static_cast<int64_t>(uint64_t {1} << static_cast<uint64_t>(maxShift));
+        return MulRanges(lhs, {minFactor, maxFactor});
+    }
+
+    // Logical shift of a negative value depends on the width of the type.
+    if (opcode == Opcode::SHR && lhs.GetMin() < 0) {
+        return ValueRange::Full();
+    }
+    auto min = lhs.GetMin() >= 0 ? lhs.GetMin() >> maxShift : lhs.GetMin() >> minShift;
+    auto max = lhs.GetMax() >= 0 ? lhs.GetMax() >> minShift : lhs.GetMax() >> maxShift;
+    return {min, max};
+}
+
+static ValueRange BinaryRanges(Opcode opcode, const ValueRange &lhs, const ValueRange &rhs)
+{
+    switch (opcode) {
+        case Opcode::ADD:
+            return AddRanges(lhs, rhs);
+        case Opcode::SUB:
+            return SubRanges(lhs, rhs);
+        case Opcode::MUL:
+            return MulRanges(lhs, rhs);
+        case Opcode::DIV:
+            return DivRanges(lhs, rhs);
+        case Opcode::REM:
+            return RemRanges(lhs, rhs);
+        case Opcode::AND:
+        case Opcode::OR:
+        case Opcode::XOR:
+            return BitwiseRanges(opcode, lhs, rhs);
+        case Opcode::SHL:
+        case Opcode::SHR:
+        case Opcode::ASHR:
+            return ShiftRanges(opcode, lhs, rhs);
+        default:
+            return ValueRange::Full();
+    }
+}
+
+void RangeAnalysis::Run()
+{
+    auto *analyses = graph_->GetAnalysisManager();
+    analyses->Run(AnalysisType::RPO);
+    analyses->Run(AnalysisType::DOMINATOR_TREE);
+
+    states_ = InsnSideTable<ValueState>(graph_);
+    conditions_ = BlockSideTable<Condition>(graph_);
+    nearestConditions_ = BlockSideTable<const BasicBlock *>(graph_, nullptr);
+    dependents_ = InsnSideTable<std::vector<Instruction *>>(graph_);
+    worklist_.clear();
+    worklistHead_ = 0;
+
+    CollectConditions();
+
+    for (auto *block : graph_->GetRpoVector()) {
+        block->EnumerateInsns([this](Instruction *insn) {
+            if (IsTracked(insn)) {
+                Enqueue(insn);
+            }
+            return false;
+        });
+    }
+
+    while (worklistHead_ != worklist_.size()) {
+        auto *insn = worklist_[worklistHead_++];
+        if (worklistHead_ == worklist_.size()) {
+            worklist_.clear();
+            worklistHead_ = 0;
+        }
+        states_[insn].isQueued = false;
+
+        // Ranges only grow, which together with widening of phis bounds the number of updates.
+        auto oldRange = states_[insn].range;
+        auto range = oldRange.Union(Evaluate(insn));
+        if (insn->IsPhi()) {
+            range = Widen(insn, oldRange, range);
+        }
+        if (range == oldRange) {
+            continue;
+        }
+        states_[insn].range = range;
+        ++states_[insn].updatesCount;
+        EnqueueUsers(insn);
+    }
+
+    Narrow();
+    dependents_ = {};
+}
+
+ValueRange RangeAnalysis::GetRange(const Instruction *value) const
+{
+    if (value->GetId() >= states_.size() || !IsTracked(value)) {
+        return ValueRange::Full();
+    }
+    return states_[value].range;
+}
+
+ValueRange RangeAnalysis::GetRange(const Instruction *value, const BasicBlock *block) const
+{
+    auto range = GetRange(value);
+    VisitConditions(value, block, [this, value, &range](const Condition &condition) {
+        range = Refine(value, range, condition);
+    });
+    return range;
+}
+
+bool RangeAnalysis::IsLess(const Instruction *lhs, const Instruction *rhs, const BasicBlock *block) const
+{
+    auto lhsRange = GetRange(lhs, block);
+    auto rhsRange = GetRange(rhs, block);
+    if (!lhsRange.IsEmpty() && !rhsRange.IsEmpty() && lhsRange.GetMax() < rhsRange.GetMin()) {
+        return true;
+    }
+
+    bool isLess = false;
+    VisitConditions(lhs, block, [lhs, rhs, &isLess](const Condition &condition) {
+        const auto *branch = condition.branch;
+        isLess |= branch->GetOpcode() == Opcode::BGT && condition.isTrue && branch->GetInput(0) == rhs &&
+                  branch->GetInput(1) == lhs;
+    });
+    return isLess;
+}
+
+bool RangeAnalysis::IsTracked(const Instruction *insn) const
+{
+    return insn->HasResult() && (IsIntegerType(insn->GetResultType()) || insn->IsBoundCheck());
+}
+
+// Unsigned 64-bit values don't fit the domain, so their comparisons can't be interpreted.
+void RangeAnalysis::CollectConditions()
+{
+    auto isComparable = [this](const Instruction *insn) {
+        return IsTracked(insn) && insn->GetResultType() != DataType::U64;
+    };
+
+    // Immediate dominator precedes the block in RPO.
+    for (auto *block : graph_->GetRpoVector()) {
+        const auto *dominator = block->GetImmediateDominator();
+        nearestConditions_[block] = (dominator == nullptr) ? nullptr : nearestConditions_[dominator];
+
+        const auto &preds = block->GetPredecessors();
+        const auto *lastInsn = (preds.size() == 1U) ? preds.front()->GetLastInsn() : nullptr;
+        if (lastInsn == nullptr || !lastInsn->IsBranch()) {
+            continue;
+        }
+        const auto *branch = static_cast<const BranchInsn *>(lastInsn);
+        const auto *lhs = branch->GetInput(0);
+        const auto *rhs = branch->GetInput(1);
+        if (lhs == rhs || !isComparable(lhs) || !isComparable(rhs) ||
+            branch->GetTrueBranchBB() == branch->GetFalseBranchBB()) {
+            continue;
+        }
+        conditions_[block] = {branch, branch->GetTrueBranchBB() == block};
+        nearestConditions_[block] = block;
+    }
+}
+
+template <typename Visitor>
+void RangeAnalysis::VisitConditions(const Instruction *value, const BasicBlock *block, Visitor visitor) const
+{
+    if (block->GetId() >= nearestConditions_.size()) {
+        return;
+    }
+    const auto *conditionBlock = nearestConditions_[block];
+    for (uint32_t count = 0; conditionBlock != nullptr && count < MAX_CONDITIONS; ++count) {
+        const auto &condition = conditions_[conditionBlock];
+        if (condition.branch->GetInput(0) == value || condition.branch->GetInput(1) == value) {
+            visitor(condition);
+        }
+        const auto *dominator = conditionBlock->GetImmediateDominator();
+        conditionBlock = (dominator == nullptr) ? nullptr : nearestConditions_[dominator];
+    }
+}
+
+void RangeAnalysis::Enqueue(Instruction *insn)
+{
+    auto &state = states_[insn];
+    if (!state.isQueued) {
+        state.isQueued = true;
+        worklist_.push_back(insn);
+    }
+}
+
+// Dependents are registered again when they are evaluated, so the list is consumed.
+void RangeAnalysis::EnqueueUsers(Instruction *value)
+{
+    for (auto *user : value->GetUsers()) {
+        if (IsTracked(user)) {
+            Enqueue(user);
+        }
+    }
+
+    auto dependents = std::move(dependents_[value]);
+    dependents_[value].clear();
+    for (auto *dependent : dependents) {
+        Enqueue(dependent);
+    }
+}
+
+ValueRange RangeAnalysis::Evaluate(Instruction *insn)
+{
+    auto *block = insn->GetParentBB();
+    auto type = insn->GetResultType();
+
+    switch (insn->GetOpcode()) {
+        case Opcode::CONSTANT: {
+            auto *constant = insn->AsConst();
+            if (!constant->IsSignedInt() && !constant->IsUnsignedInt()) {
+                return ValueRange::ForType(type);
+            }
+            auto value = constant->GetAsI64();
+            return FitToType({value, value}, type);
+        }
+        case Opcode::PHI: {
+            // Every input is taken as seen at the end of its predecessor.
+            ValueRange range;
+            for (const auto &dependency : static_cast<PhiInsn *>(insn)->GetDependencies()) {
+                range = range.Union(GetOperandRange(insn, dependency.value, dependency.block));
+            }
+            return FitToType(range, type);
+        }
+        case Opcode::BOUNDSCHECK: {
+            // The check passes the index through if it lies in [0, length).
+            auto *check = static_cast<BoundsCheckInsn *>(insn);
+            auto idx = GetOperandRange(insn, check->GetIdxToCheck(), block);
+            auto length = GetOperandRange(insn, check->GetMaxArrayIdx(), block);
+            if (idx.IsEmpty() || length.IsEmpty() || length.GetMax() <= 0) {
+                return {};
+            }
+            return idx.Intersect({0, length.GetMax() - 1});
+        }
+        case Opcode::ADD:
+        case Opcode::SUB:
+        case Opcode::MUL:
+        case Opcode::DIV:
+        case Opcode::REM:
+        case Opcode::AND:
+        case Opcode::OR:
+        case Opcode::XOR:
+        case Opcode::SHL:
+        case Opcode::SHR:
+        case Opcode::ASHR: {
+            auto lhs = GetOperandRange(insn, insn->GetInput(0), block);
+            auto rhs = GetOperandRange(insn, insn->GetInput(1), block);
+            if (lhs.IsEmpty() || rhs.IsEmpty()) {
+                return {};
+            }
+            return FitToType(BinaryRanges(insn->GetOpcode(), lhs, rhs), type);
+        }
+        default:
+            return ValueRange::ForType(type);
+    }
+}
+
+// Refined range of the operand, `user` gets re-evaluated when the other operand of an applied condition changes.
+ValueRange RangeAnalysis::GetOperandRange(Instruction *user, const Instruction *value, const BasicBlock *block)
+{
+    auto range = GetRange(value);
+    VisitConditions(value, block, [this, user, value, &range](const Condition &condition) {
+        const auto *branch = condition.branch;
+        dependents_[branch->GetInput(0) == value ? branch->GetInput(1) : branch->GetInput(0)].push_back(user);
+        range = Refine(value, range, condition);
+    });
+    return range;
+}
+
+ValueRange RangeAnalysis::Widen(const Instruction *phi, const ValueRange &oldRange, const ValueRange &newRange) const
+{
+    if (oldRange.IsEmpty() || states_[phi].updatesCount < WIDENING_DELAY) {
+        return newRange;
+    }
+    auto typeRange = ValueRange::ForType(phi->GetResultType());
+    auto min = newRange.GetMin() < oldRange.GetMin() ? typeRange.GetMin() : newRange.GetMin();
+    auto max = newRange.GetMax() > oldRange.GetMax() ? typeRange.GetMax() : newRange.GetMax();
+    return {min, max};
+}
+
+// Ranges are a post-fixpoint after widening, re-evaluating them without widening can only shrink them.
+void RangeAnalysis::Narrow()
+{
+    for (uint32_t sweep = 0; sweep < NARROWING_SWEEPS; ++sweep) {
+        for (auto *block : graph_->GetRpoVector()) {
+            block->EnumerateInsns([this](Instruction *insn) {
+                if (!IsTracked(insn)) {
+                    return false;
+                }
+                auto range = Evaluate(insn);
+                auto &state = states_[insn];
+                if (!range.IsEmpty() && state.range.Contains(range)) {
+                    state.range = range;
+                }
+                return false;
+            });
+        }
+    }
+}
+
+// Restricts the range of `value` by the condition, using the range of the other operand of the branch.
+ValueRange RangeAnalysis::Refine(const Instruction *value, ValueRange range, const Condition &condition) const
+{
+    const auto *branch = condition.branch;
+    bool isTrue = condition.isTrue;
+    bool isLhs = branch->GetInput(0) == value;
+    auto other = GetRange(isLhs ? branch->GetInput(1) : branch->GetInput(0));
+    if (other.IsEmpty() || range.IsEmpty()) {
+        return range;
+    }
+
+    if (branch->GetOpcode() == Opcode::BGT) {
+        // Bgt is taken when lhs > rhs.
+        if (isLhs == isTrue) {
+            // value > other or value >= other.
+            auto min = other.GetMin();
+            if (isTrue && min == ValueRange::MAX) {
+                return {};
+            }
+            return range.Intersect({isTrue ? min + 1 : min, ValueRange::MAX});
+        }
+        // value < other or value <= other.
+        auto max = other.GetMax();
+        if (isTrue && max == ValueRange::MIN) {
+            return {};
+        }
+        return range.Intersect({ValueRange::MIN, isTrue ? max - 1 : max});
+    }
+
+    bool isEqual = (branch->GetOpcode() == Opcode::BEQ) == isTrue;
+    if (isEqual) {
+        return range.Intersect(other);
+    }
+    // Only a constant excluded at a bound of the range shrinks it.
+    if (!other.IsConstant()) {
+        return range;
+    }
+    if (range.GetMin() == other.GetMin()) {
+        return range.IsConstant() ? ValueRange() : ValueRange(range.GetMin() + 1, range.GetMax());
+    }
+    if (range.GetMax() == other.GetMin()) {
+        return ValueRange(range.GetMin(), range.GetMax() - 1);
+    }
+    return range;
+}
+
+}  // namespace compiler
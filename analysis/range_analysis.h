@@ -0,0 +1,166 @@
+#ifndef ANALYSIS_RANGE_ANALYSIS_H
+#define ANALYSIS_RANGE_ANALYSIS_H
+
+#include "utils/macros.h"
+#include "ir/data_types.h"
+#include "ir/side_table.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace compiler {
+
+class BranchInsn;
+
+// Closed interval of integer values in the signed 64-bit domain.
+// Empty range stands for a value which is not computed yet or is defined only on unreachable paths.
+class ValueRange final {
+public:
+    static constexpr int64_t MIN = std::numeric_limits<int64_t>::min();
+    static constexpr int64_t MAX = std::numeric_limits<int64_t>::max();
+
+    constexpr ValueRange() = default;
+    constexpr ValueRange(int64_t min, int64_t max) : min_(min), max_(max) {}
+
+    static constexpr ValueRange Full()
+    {
+        return {MIN, MAX};
+    }
+
+    // Values of the integer type, U64 is not representable and gets the full range.
+    static ValueRange ForType(DataType type);
+
+    constexpr bool IsEmpty() const
+    {
+        return min_ > max_;
+    }
+
+    constexpr int64_t GetMin() const
+    {
+        assert(!IsEmpty());
+        return min_;
+    }
+
+    constexpr int64_t GetMax() const
+    {
+        assert(!IsEmpty());
+        return max_;
+    }
+
+    constexpr bool IsConstant() const
+    {
+        return min_ == max_;
+    }
+
+    constexpr bool Contains(const ValueRange &other) const
+    {
+        return other.IsEmpty() || (min_ <= other.min_ && other.max_ <= max_);
+    }
+
+    constexpr ValueRange Union(const ValueRange &other) const
+    {
+        if (IsEmpty()) {
+            return other;
+        }
+        if (other.IsEmpty()) {
+            return *this;
+        }
+        return {std::min(min_, other.min_), std::max(max_, other.max_)};
+    }
+
+    constexpr ValueRange Intersect(const ValueRange &other) const
+    {
+        if (IsEmpty() || other.IsEmpty()) {
+            return {};
+        }
+        return {std::max(min_, other.min_), std::min(max_, other.max_)};
+    }
+
+    constexpr bool operator==(const ValueRange &other) const
+    {
+        return (IsEmpty() && other.IsEmpty()) || (min_ == other.min_ && max_ == other.max_);
+    }
+
+private:
+    int64_t min_ {1};
+    int64_t max_ {0};
+};
+
+// Sparse range analysis over integer SSA values.
+// Ranges are propagated along def-use edges with a worklist, starting from empty ranges, so loops converge
+// to the smallest ranges found; phis which keep growing are widened to the bounds of their type,
+// then a few narrowing sweeps recover the bounds of widened values.
+//
+// Uses of a value are refined by conditions of branches on it: a block which is entered only through one edge
+// of the branch, and all blocks it dominates, see the value restricted by the condition.
+// Only the nearest MAX_CONDITIONS dominating conditions are looked at, so queries don't depend on the CFG depth.
+class RangeAnalysis final {
+public:
+    NO_COPY_SEMANTIC(RangeAnalysis);
+    NO_MOVE_SEMANTIC(RangeAnalysis);
+
+    // Updates of a phi before it is widened.
+    static constexpr uint32_t WIDENING_DELAY = 2U;
+    static constexpr uint32_t NARROWING_SWEEPS = 2U;
+    static constexpr uint32_t MAX_CONDITIONS = 8U;
+
+    explicit RangeAnalysis(Graph *graph) : graph_(graph) {}
+    ~RangeAnalysis() = default;
+
+    void Run();
+
+    // Range of the value everywhere it is defined, full for values which are not integer.
+    ValueRange GetRange(const Instruction *value) const;
+
+    // Range of the value in `block`, refined by the branches dominating it.
+    ValueRange GetRange(const Instruction *value, const BasicBlock *block) const;
+
+    // Whether `lhs < rhs` holds in `block`, by ranges or by a dominating branch comparing them.
+    bool IsLess(const Instruction *lhs, const Instruction *rhs, const BasicBlock *block) const;
+
+private:
+    struct ValueState {
+        ValueRange range;
+        uint32_t updatesCount {0};
+        bool isQueued {false};
+    };
+
+    // Edge of the branch through which the block is only entered.
+    struct Condition {
+        const BranchInsn *branch {nullptr};
+        bool isTrue {false};
+    };
+
+    bool IsTracked(const Instruction *insn) const;
+    void CollectConditions();
+    void Enqueue(Instruction *insn);
+    void EnqueueUsers(Instruction *value);
+    ValueRange Evaluate(Instruction *insn);
+    ValueRange GetOperandRange(Instruction *user, const Instruction *value, const BasicBlock *block);
+    ValueRange Widen(const Instruction *phi, const ValueRange &oldRange, const ValueRange &newRange) const;
+    void Narrow();
+
+    template <typename Visitor>
+    void VisitConditions(const Instruction *value, const BasicBlock *block, Visitor visitor) const;
+    ValueRange Refine(const Instruction *value, ValueRange range, const Condition &condition) const;
+
+private:
+    Graph *graph_ {nullptr};
+
+    InsnSideTable<ValueState> states_;
+    BlockSideTable<Condition> conditions_;
+    // The block itself if it has a condition, otherwise the nearest dominator with one.
+    BlockSideTable<const BasicBlock *> nearestConditions_;
+    // Instructions whose last evaluation refined an operand by a condition on the value.
+    InsnSideTable<std::vector<Instruction *>> dependents_;
+
+    std::vector<Instruction *> worklist_;
+    size_t worklistHead_ {0};
+};
+
+}  // namespace compiler
+
+#endif  // ANALYSIS_RANGE_ANALYSIS_H
@@ -1,4 +1,5 @@
 #include "analysis/rpo.h"
+#include "analysis/graph_traversal.h"
 #include "ir/graph.h"
 
 namespace compiler {
@@ -8,27 +9,23 @@ std::vector<BasicBlock *> RPO::Run()
     size_t blockCount = graph_->GetAliveBlockCount();
     std::vector<BasicBlock *> rpoVector(blockCount);
 
-    DFS(rpoVector, graph_->GetStartBlock(), &blockCount);
-
-    return rpoVector;
-}
-
-void RPO::DFS(std::vector<BasicBlock *> &rpoVector, BasicBlock *block, size_t *blockCount)
-{
-    assert(block);
-
-    block->SetMarker(marker_);
-
-    for (auto succBlock : block->GetSuccessors()) {
-        if (!succBlock->IsMarked(marker_)) {
-            DFS(rpoVector, succBlock, blockCount);
+    struct Visitor {
+        void PostOrder(BasicBlock *block)
+        {
+            assert(blockCount > 0);
+            rpoVector[--blockCount] = block;
         }
-    }
 
-    assert(blockCount != nullptr);
-    assert(*blockCount > 0);
+        std::vector<BasicBlock *> &rpoVector;
+        size_t &blockCount;
+    };
 
-    rpoVector[--(*blockCount)] = block;
+    GraphTraversal traversal(graph_);
+    traversal.Run(graph_->GetStartBlock(), marker_, Visitor {rpoVector, blockCount});
+    // Unreachable blocks leave the front of the vector unfilled.
+    rpoVector.erase(rpoVector.begin(), rpoVector.begin() + static_cast<std::ptrdiff_t>(blockCount));
+
+    return rpoVector;
 }
 
 }  // namespace compiler
@@ -1,5 +1,5 @@
-#ifndef ANALYSIS_DFS_H
-#define ANALYSIS_DFS_H
+#ifndef ANALYSIS_RPO_H
+#define ANALYSIS_RPO_H
 
 #include "utils/macros.h"
 #include "ir/basic_block.h"
@@ -30,9 +30,6 @@ public:
         return marker_;
     }
 
-private:
-    void DFS(std::vector<BasicBlock *> &rpoVector, BasicBlock *block, size_t *blockCount);
-
 private:
     Graph *graph_ {nullptr};
 
@@ -41,4 +38,4 @@ private:
 
 }  // namespace compiler
 
-#endif  // ANALYSIS_DFS_H
+#endif  // ANALYSIS_RPO_H
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include "ir/ir_builder-inl.h"
+#include "optimizations/check_elimination.h"
+
+namespace compiler::benchmarks {
+
+// One long block of arithmetic followed by repeated null checks of the same reference,
+// all checks but the first one are redundant.
+static void BM_CheckEliminationLongBlock(benchmark::State &state)
+{
+    auto checksNum = state.range(0);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Graph graph;
+        IrBuilder builder(&graph);
+
+        auto *entryBB = builder.CreateBB();
+        builder.SetBasicBlockScope(entryBB);
+
+        auto *array = builder.CreateParameterInsn(0, DataType::REF);
+        auto *idx = builder.CreateInt64ConstantInsn(0);
+        Instruction *acc = idx;
+        for (int64_t addIdx = 0; addIdx < checksNum; ++addIdx) {
+            acc = builder.CreateAddInsn(DataType::I64, acc, idx);
+        }
+        for (int64_t checkIdx = 0; checkIdx < checksNum; ++checkIdx) {
+            auto *check = builder.CreateNullcheckInsn(array);
+            builder.CreateLoadArrayInsn(DataType::U64, check, idx);
+        }
+        CheckElimination checkElimination(&graph);
+        state.ResumeTiming();
+
+        checkElimination.Run();
+        benchmark::DoNotOptimize(array->GetUsers().size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * checksNum);
+}
+BENCHMARK(BM_CheckEliminationLongBlock)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Sequence of counted loops over an array, every body loads and stores an element with its own bounds checks.
+// No check is dominated by an equal one, the load check is removed by ranges, the check of i + 1 stays.
+static void BuildArrayLoops(Graph *graph, int64_t loopsNum)
+{
+    IrBuilder builder(graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *array = builder.CreateParameterInsn(0, DataType::REF);
+    auto *length = builder.CreateParameterInsn(1);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+
+    auto *prevBB = entryBB;
+    for (int64_t loopIdx = 0; loopIdx < loopsNum; ++loopIdx) {
+        auto *headerBB = builder.CreateBB();
+        auto *bodyBB = builder.CreateBB();
+        auto *exitBB = builder.CreateBB();
+
+        builder.SetBasicBlockScope(prevBB);
+        builder.CreateJmpInsn(headerBB);
+
+        builder.SetBasicBlockScope(headerBB);
+        auto *idx = builder.CreatePhiInsn(DataType::I64);
+        builder.CreateBgtInsn(length, idx, bodyBB, exitBB);
+
+        builder.SetBasicBlockScope(bodyBB);
+        auto *loadCheck = builder.CreateBoundsCheckInsn(array, idx, length);
+        auto *value = builder.CreateLoadArrayInsn(DataType::I64, array, loadCheck);
+        auto *sum = builder.CreateAddInsn(DataType::I64, value, idx);
+        auto *next = builder.CreateAddInsn(DataType::I64, idx, one);
+        auto *storeCheck = builder.CreateBoundsCheckInsn(array, next, length);
+        builder.CreateStoreArrayInsn(DataType::I64, array, storeCheck, sum);
+        builder.CreateJmpInsn(headerBB);
+
+        idx->ResolveDependency(zero, prevBB);
+        idx->ResolveDependency(next, bodyBB);
+        prevBB = exitBB;
+    }
+
+    builder.SetBasicBlockScope(prevBB);
+    builder.CreateRetInsn(DataType::VOID);
+}
+
+static void BM_CheckEliminationArrayLoops(benchmark::State &state)
+{
+    auto loopsNum = state.range(0);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Graph graph;
+        BuildArrayLoops(&graph, loopsNum);
+        CheckElimination checkElimination(&graph);
+        state.ResumeTiming();
+
+        checkElimination.Run();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * loopsNum);
+}
+BENCHMARK(BM_CheckEliminationArrayLoops)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace compiler::benchmarks
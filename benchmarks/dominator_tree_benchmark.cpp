@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include "analysis/dfs.h"
+#include "analysis/dominator_tree.h"
+#include "analysis/control_dependence.h"
+#include "analysis/post_dominator_tree.h"
+#include "ir/ir_builder-inl.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace compiler::benchmarks {
+
+// Previous implementation: DFS with every block removed in turn gives the dominated sets,
+// immediate dominators are found by pairwise comparison of the sets.
+class LegacyDominatorTree final {
+public:
+    explicit LegacyDominatorTree(Graph *graph) : graph_(graph) {}
+
+    void Build()
+    {
+        graph_->RunRpo();
+        auto &rpoVec = graph_->GetRpoVector();
+
+        auto *rootBlock = graph_->GetStartBlock();
+        dominatedBlocksMap_[rootBlock] = rpoVec;
+        for (auto it = rpoVec.begin() + 1; it < rpoVec.end(); ++it) {
+            dominatorsMap_.emplace(*it, std::vector<BasicBlock *> {rootBlock});
+        }
+
+        DFS dfs(graph_);
+        for (auto blockIt = rpoVec.begin() + 1; blockIt < rpoVec.end(); ++blockIt) {
+            auto *block = *blockIt;
+            auto marker = graph_->CreateNewMarker();
+            dfs.SetMarker(marker);
+            block->SetMarker(marker);
+
+            auto reachableBlocks = dfs.Run();
+            CalculateDominatedBlocks(block, rpoVec, reachableBlocks);
+
+            graph_->EraseMarker(marker);
+        }
+
+        for (auto *block : rpoVec) {
+            CalculateImmediateDominators(block);
+        }
+    }
+
+private:
+    void CalculateDominatedBlocks(BasicBlock *block, const std::vector<BasicBlock *> &originalVec,
+                                  const std::vector<BasicBlock *> &reachableBlocks)
+    {
+        std::vector<BasicBlock *> dominatedBlocks;
+        for (auto *candidate : originalVec) {
+            if (candidate != block &&
+                std::find(reachableBlocks.begin(), reachableBlocks.end(), candidate) == reachableBlocks.end()) {
+                dominatedBlocks.push_back(candidate);
+                dominatorsMap_[candidate].push_back(block);
+            }
+        }
+        dominatedBlocksMap_[block] = std::move(dominatedBlocks);
+    }
+
+    void CalculateImmediateDominators(BasicBlock *block)
+    {
+        auto isDominatesOver = [this](BasicBlock *dominator, BasicBlock *dominated) {
+            auto &dominatedBlocks = dominatedBlocksMap_[dominator];
+            return dominator == dominated ||
+                   std::find(dominatedBlocks.begin(), dominatedBlocks.end(), dominated) != dominatedBlocks.end();
+        };
+
+        for (auto *dominatedBlock : dominatedBlocksMap_[block]) {
+            if (dominatedBlock == block) {
+                continue;
+            }
+            auto &dominators = dominatorsMap_[dominatedBlock];
+            if (std::all_of(dominators.begin(), dominators.end(),
+                            [block, &isDominatesOver](auto *dom) { return isDominatesOver(dom, block); })) {
+                dominatedBlock->SetImmediateDominator(block);
+            }
+        }
+    }
+
+private:
+    Graph *graph_ {nullptr};
+    std::unordered_map<BasicBlock *, std::vector<BasicBlock *>> dominatorsMap_;
+    std::unordered_map<BasicBlock *, std::vector<BasicBlock *>> dominatedBlocksMap_;
+};
+
+// Sequence of diamonds, every fourth diamond closes a loop back to the start of the previous one.
+static void BuildDiamondsCfg(Graph *graph, int64_t blocksNum)
+{
+    IrBuilder builder(graph);
+
+    auto *prev = builder.CreateBB();
+    BasicBlock *loopHeader = prev;
+    for (int64_t idx = 0; idx + 3 < blocksNum; idx += 3) {
+        auto *left = builder.CreateBB();
+        auto *right = builder.CreateBB();
+        auto *join = builder.CreateBB();
+
+        prev->AddSuccessor(left);
+        prev->AddSuccessor(right);
+        left->AddSuccessor(join);
+        right->AddSuccessor(join);
+
+        if ((idx / 3) % 4 == 3) {
+            join->AddSuccessor(loopHeader);
+            loopHeader = join;
+        }
+        prev = join;
+    }
+}
+
+template <typename TreeT>
+static void BM_DominatorTree(benchmark::State &state)
+{
+    Graph graph;
+    BuildDiamondsCfg(&graph, state.range(0));
+
+    for (auto _ : state) {
+        // Keep RPO in the measurement.
+        graph.GetAnalysisManager()->Invalidate();
+        TreeT tree(&graph);
+        tree.Build();
+        benchmark::DoNotOptimize(graph.GetStartBlock()->GetImmediateDominator());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_DominatorTree, DominatorTree)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+// Legacy algorithm is cubic, larger graphs take minutes.
+BENCHMARK_TEMPLATE(BM_DominatorTree, LegacyDominatorTree)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_PostDominatorTree(benchmark::State &state)
+{
+    Graph graph;
+    BuildDiamondsCfg(&graph, state.range(0));
+
+    for (auto _ : state) {
+        PostDominatorTree tree(&graph);
+        tree.Build();
+        ControlDependence controlDependence(&graph, &tree);
+        controlDependence.Build();
+        benchmark::DoNotOptimize(controlDependence.GetDependentBlocks(graph.GetStartBlock()).size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PostDominatorTree)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace compiler::benchmarks
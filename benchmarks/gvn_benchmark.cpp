@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include "ir/ir_builder-inl.h"
+#include "optimizations/gvn.h"
+
+namespace compiler::benchmarks {
+
+// Chain of diamonds, every block of a diamond recomputes the expression and the load of the block before it,
+// so half of the arithmetic and loads are redundant.
+static void BuildRedundantDiamonds(Graph *graph, int64_t diamondsNum)
+{
+    IrBuilder builder(graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *arr = builder.CreateParameterInsn(0, DataType::REF);
+    auto *param = builder.CreateParameterInsn(1, DataType::U32);
+    Instruction *acc = param;
+
+    auto *currBB = entryBB;
+    for (int64_t idx = 0; idx < diamondsNum; ++idx) {
+        auto *thenBB = builder.CreateBB();
+        auto *elseBB = builder.CreateBB();
+        auto *joinBB = builder.CreateBB();
+
+        builder.SetBasicBlockScope(currBB);
+        auto *sum = builder.CreateAddInsn(DataType::I64, acc, param);
+        auto *load = builder.CreateLoadArrayInsn(DataType::I64, arr, sum);
+        builder.CreateBgtInsn(load, param, thenBB, elseBB);
+
+        for (auto *block : {thenBB, elseBB}) {
+            builder.SetBasicBlockScope(block);
+            auto *sumCopy = builder.CreateAddInsn(DataType::I64, param, acc);
+            auto *loadCopy = builder.CreateLoadArrayInsn(DataType::I64, arr, sumCopy);
+            builder.CreateStoreArrayInsn(DataType::I32, arr, sumCopy, loadCopy);
+            builder.CreateJmpInsn(joinBB);
+        }
+
+        builder.SetBasicBlockScope(joinBB);
+        acc = builder.CreateMulInsn(DataType::I64, sum, load);
+        currBB = joinBB;
+    }
+
+    builder.SetBasicBlockScope(currBB);
+    builder.CreateRetInsn(DataType::I64, acc);
+}
+
+static void BM_GvnDiamonds(benchmark::State &state)
+{
+    auto diamondsNum = state.range(0);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Graph graph;
+        BuildRedundantDiamonds(&graph, diamondsNum);
+        Gvn gvn(&graph);
+        state.ResumeTiming();
+
+        gvn.Run();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * diamondsNum * 10);
+}
+BENCHMARK(BM_GvnDiamonds)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace compiler::benchmarks
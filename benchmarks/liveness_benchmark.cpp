@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include "analysis/liveness.h"
+#include "ir/ir_builder-inl.h"
+
+namespace compiler::benchmarks {
+
+// Sequence of counted loops, every loop accumulates into a phi and its result feeds the next one:
+//
+//   header: acc = phi(prev, next); idx = phi(0, idxNext); bgt limit, idx, body, exit
+//   body:   chain of arithmetic over acc and param; jmp header
+//   exit:   next loop
+static void BuildLoopsChain(Graph *graph, int64_t insnsNum)
+{
+    constexpr int64_t BODY_LENGTH = 16;
+    constexpr int64_t LOOP_INSNS = BODY_LENGTH + 5;
+
+    IrBuilder builder(graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+
+    Instruction *acc = param;
+    auto *prevBB = entryBB;
+    for (int64_t idx = 0; idx + LOOP_INSNS <= insnsNum; idx += LOOP_INSNS) {
+        auto *headerBB = builder.CreateBB();
+        auto *bodyBB = builder.CreateBB();
+        auto *exitBB = builder.CreateBB();
+
+        builder.SetBasicBlockScope(prevBB);
+        builder.CreateJmpInsn(headerBB);
+
+        builder.SetBasicBlockScope(headerBB);
+        auto *accPhi = builder.CreatePhiInsn(DataType::I64);
+        auto *idxPhi = builder.CreatePhiInsn(DataType::I64);
+        builder.CreateBgtInsn(param, idxPhi, bodyBB, exitBB);
+
+        builder.SetBasicBlockScope(bodyBB);
+        Instruction *value = accPhi;
+        for (int64_t insnIdx = 0; insnIdx + 1 < BODY_LENGTH; ++insnIdx) {
+            value = builder.CreateAddInsn(DataType::I64, value, param);
+        }
+        auto *idxNext = builder.CreateAddInsn(DataType::I64, idxPhi, one);
+        builder.CreateJmpInsn(headerBB);
+
+        accPhi->ResolveDependency(acc, prevBB);
+        accPhi->ResolveDependency(value, bodyBB);
+        idxPhi->ResolveDependency(zero, prevBB);
+        idxPhi->ResolveDependency(idxNext, bodyBB);
+
+        acc = accPhi;
+        prevBB = exitBB;
+    }
+
+    builder.SetBasicBlockScope(prevBB);
+    builder.CreateRetInsn(DataType::I64, acc);
+}
+
+// Linear order, numbering, live sets and intervals, together with RPO, dominators and loops they depend on.
+static void BM_Liveness(benchmark::State &state)
+{
+    Graph graph;
+    BuildLoopsChain(&graph, state.range(0));
+    auto *analyses = graph.GetAnalysisManager();
+
+    for (auto _ : state) {
+        analyses->Invalidate();
+        benchmark::DoNotOptimize(analyses->GetLiveness().GetLinearOrder().size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Liveness)->Arg(10000)->Arg(30000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace compiler::benchmarks
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "ir/ir_builder-inl.h"
+#include "optimizations/peepholes.h"
+
+namespace compiler::benchmarks {
+
+// Straight-line code built of the patterns from peepholes tests:
+// mul by one, or with zero, ashr by zero and chains of ashr by constants.
+static void BuildPeepholesGraph(Graph *graph, int64_t chainsNum)
+{
+    IrBuilder builder(graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *param = builder.CreateParameterInsn(0);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    auto *three = builder.CreateInt64ConstantInsn(3);
+
+    Instruction *acc = param;
+    for (int64_t idx = 0; idx < chainsNum; ++idx) {
+        auto *add = builder.CreateAddInsn(DataType::I64, acc, param);
+        auto *mul = builder.CreateMulInsn(DataType::I64, add, one);
+        auto *orInsn = builder.CreateOrInsn(DataType::I64, mul, zero);
+        auto *ashr0 = builder.CreateAshrInsn(DataType::I64, orInsn, zero);
+        auto *ashr1 = builder.CreateAshrInsn(DataType::I64, ashr0, three);
+        auto *ashr2 = builder.CreateAshrInsn(DataType::I64, ashr1, three);
+        acc = builder.CreateSubInsn(DataType::I64, ashr2, add);
+    }
+    builder.CreateRetInsn(DataType::I64, acc);
+}
+
+static void BM_PeepholesLargeGraph(benchmark::State &state)
+{
+    auto chainsNum = state.range(0);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Graph graph;
+        BuildPeepholesGraph(&graph, chainsNum);
+        Peepholes peepholes(&graph);
+        state.ResumeTiming();
+
+        peepholes.Run();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * chainsNum * 7);
+}
+BENCHMARK(BM_PeepholesLargeGraph)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace compiler::benchmarks
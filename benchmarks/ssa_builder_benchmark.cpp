@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include "ir/ir_builder-inl.h"
+
+#include <vector>
+
+namespace compiler::benchmarks {
+
+// Sequence of counted loops built from variables, like a front-end does. Every loop updates only one of the
+// variables and reads all of them, so the other variables get trivial phis in the header which are removed.
+static void BuildLoopsChainFromVariables(Graph *graph, int64_t loopsNum, int64_t varsNum)
+{
+    IrBuilder builder(graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    builder.SealBlock(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+
+    auto idxVar = builder.CreateVariable(DataType::I64);
+    std::vector<VariableId> vars;
+    for (int64_t idx = 0; idx < varsNum; ++idx) {
+        vars.push_back(builder.CreateVariable(DataType::I64));
+        builder.WriteVariable(vars.back(), param);
+    }
+
+    auto *prevBB = entryBB;
+    for (int64_t loopIdx = 0; loopIdx < loopsNum; ++loopIdx) {
+        auto *headerBB = builder.CreateBB();
+        auto *bodyBB = builder.CreateBB();
+        auto *exitBB = builder.CreateBB();
+
+        builder.SetBasicBlockScope(prevBB);
+        builder.WriteVariable(idxVar, one);
+        builder.CreateJmpInsn(headerBB);
+
+        builder.SetBasicBlockScope(headerBB);
+        builder.CreateBgtInsn(param, builder.ReadVariable(idxVar), bodyBB, exitBB);
+
+        builder.SetBasicBlockScope(bodyBB);
+        builder.SealBlock(bodyBB);
+        Instruction *value = builder.ReadVariable(idxVar);
+        for (auto var : vars) {
+            value = builder.CreateAddInsn(DataType::I64, value, builder.ReadVariable(var));
+        }
+        builder.WriteVariable(vars[loopIdx % varsNum], value);
+        builder.WriteVariable(idxVar, builder.CreateAddInsn(DataType::I64, builder.ReadVariable(idxVar), one));
+        builder.CreateJmpInsn(headerBB);
+        builder.SealBlock(headerBB);
+
+        builder.SetBasicBlockScope(exitBB);
+        builder.SealBlock(exitBB);
+        prevBB = exitBB;
+    }
+
+    builder.SetBasicBlockScope(prevBB);
+    builder.CreateRetInsn(DataType::I64, builder.ReadVariable(vars.front()));
+}
+
+static void BM_SsaBuilderLoopsChain(benchmark::State &state)
+{
+    auto loopsNum = state.range(0);
+    auto varsNum = state.range(1);
+
+    for (auto _ : state) {
+        Graph graph;
+        BuildLoopsChainFromVariables(&graph, loopsNum, varsNum);
+        benchmark::DoNotOptimize(graph.GetInstructions().size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * loopsNum * varsNum);
+}
+BENCHMARK(BM_SsaBuilderLoopsChain)
+    ->Args({1000, 8})
+    ->Args({1000, 32})
+    ->Args({10000, 8})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace compiler::benchmarks
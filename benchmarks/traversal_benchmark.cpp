@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include "analysis/rpo.h"
+#include "ir/ir_builder-inl.h"
+
+namespace compiler::benchmarks {
+
+// Recursive RPO as it was implemented before the iterative traversal.
+class RecursiveRPO final {
+public:
+    NO_COPY_SEMANTIC(RecursiveRPO);
+    NO_MOVE_SEMANTIC(RecursiveRPO);
+
+    explicit RecursiveRPO(Graph *graph) : graph_(graph) {}
+    ~RecursiveRPO() = default;
+
+    void SetMarker(Marker marker)
+    {
+        marker_ = marker;
+    }
+
+    std::vector<BasicBlock *> Run()
+    {
+        size_t blockCount = graph_->GetAliveBlockCount();
+        std::vector<BasicBlock *> rpoVector(blockCount);
+        DFS(graph_->GetStartBlock(), &blockCount, rpoVector);
+        rpoVector.erase(rpoVector.begin(), rpoVector.begin() + static_cast<std::ptrdiff_t>(blockCount));
+        return rpoVector;
+    }
+
+private:
+    void DFS(BasicBlock *block, size_t *blockCount, std::vector<BasicBlock *> &rpoVector)
+    {
+        block->SetMarker(marker_);
+        for (auto *succ : block->GetSuccessors()) {
+            if (!succ->IsMarked(marker_)) {
+                DFS(succ, blockCount, rpoVector);
+            }
+        }
+        rpoVector[--(*blockCount)] = block;
+    }
+
+private:
+    Graph *graph_ {nullptr};
+    Marker marker_;
+};
+
+// Chain of diamonds, the depth of DFS is about two thirds of the number of blocks.
+static void BuildDiamondsChain(Graph *graph, int64_t blocksNum)
+{
+    IrBuilder builder(graph);
+
+    auto *prev = builder.CreateBB();
+    for (int64_t idx = 0; idx + 3 < blocksNum; idx += 3) {
+        auto *left = builder.CreateBB();
+        auto *right = builder.CreateBB();
+        auto *join = builder.CreateBB();
+
+        prev->AddSuccessor(left);
+        prev->AddSuccessor(right);
+        left->AddSuccessor(join);
+        right->AddSuccessor(join);
+        prev = join;
+    }
+}
+
+template <typename RpoT>
+static void BM_RPO(benchmark::State &state)
+{
+    Graph graph;
+    BuildDiamondsChain(&graph, state.range(0));
+
+    for (auto _ : state) {
+        auto marker = graph.CreateNewMarker();
+        RpoT rpo(&graph);
+        rpo.SetMarker(marker);
+        benchmark::DoNotOptimize(rpo.Run());
+        graph.EraseMarker(marker);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_RPO, RPO)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+// Larger graphs overflow the default stack with the recursive version.
+BENCHMARK_TEMPLATE(BM_RPO, RecursiveRPO)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+}  // namespace compiler::benchmarks
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include "ir/ir_builder-inl.h"
+
+namespace compiler::benchmarks {
+
+// Replace all uses of a value with many users and move them back.
+static void BM_ReplaceInputsForUsers(benchmark::State &state)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *value = builder.CreateInt64ConstantInsn(1);
+    auto *replacement = builder.CreateInt64ConstantInsn(2);
+    auto *other = builder.CreateInt64ConstantInsn(3);
+
+    auto usersNum = state.range(0);
+    for (int64_t idx = 0; idx < usersNum; ++idx) {
+        builder.CreateAddInsn(DataType::I64, value, other);
+    }
+
+    for (auto _ : state) {
+        value->ReplaceInputsForUsers(replacement);
+        std::swap(value, replacement);
+        benchmark::DoNotOptimize(value->GetUsers().GetFirst());
+    }
+
+    state.SetItemsProcessed(state.iterations() * usersNum);
+}
+BENCHMARK(BM_ReplaceInputsForUsers)->Arg(10000);
+
+// Remove instructions which use one value, each removal unlinks a use in the middle of a long list.
+static void BM_RemoveUsers(benchmark::State &state)
+{
+    auto usersNum = state.range(0);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Graph graph;
+        IrBuilder builder(&graph);
+
+        auto *entryBB = builder.CreateBB();
+        builder.SetBasicBlockScope(entryBB);
+
+        auto *value = builder.CreateInt64ConstantInsn(1);
+        builder.CreateInt64ConstantInsn(2);
+        for (int64_t idx = 0; idx < usersNum; ++idx) {
+            builder.CreateAddInsn(DataType::I64, value, value);
+        }
+        state.ResumeTiming();
+
+        while (entryBB->GetLastInsn() != entryBB->GetFirstInsn()->GetNext()) {
+            entryBB->Remove(entryBB->GetLastInsn());
+        }
+        benchmark::DoNotOptimize(value->GetUsers().size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * usersNum);
+}
+BENCHMARK(BM_RemoveUsers)->Arg(10000);
+
+}  // namespace compiler::benchmarks
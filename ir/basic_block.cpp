@@ -24,38 +24,9 @@ bool BasicBlock::IsHeader() const
     return loop_->GetHeader() == this;
 }
 
-void BasicBlock::SetMarker(Marker marker)
-{
-    uint32_t markerValue = marker >> MarkerManager::COLOR_BITS;
-    uint32_t colorIdx = marker & MarkerManager::COLOR_MASK;
-    assert(colorIdx < MarkerManager::COLORS_NUM);
-    markers_[colorIdx] = markerValue;
-}
-
-void BasicBlock::EraseMarker(Marker marker)
-{
-    uint32_t colorIdx = marker & MarkerManager::COLOR_MASK;
-    assert(colorIdx < MarkerManager::COLORS_NUM);
-    markers_[colorIdx] = MarkerManager::UNMARKER;
-}
-
-bool BasicBlock::IsMarked(Marker marker) const
-{
-    uint32_t markerValue = marker >> MarkerManager::COLOR_BITS;
-    uint32_t colorIdx = marker & MarkerManager::COLOR_MASK;
-    assert(colorIdx < MarkerManager::COLORS_NUM);
-    return markers_[colorIdx] == markerValue;
-}
-
-void BasicBlock::ClearMarkers()
-{
-    for (auto &marker : markers_) {
-        marker = MarkerManager::UNMARKER;
-    }
-}
-
 void BasicBlock::PushInstruction(Instruction *insn)
 {
+    insn->SetParentBB(this);
     if (firstInsn_ == nullptr) {
         firstInsn_ = insn;
         lastInsn_ = firstInsn_;
@@ -64,6 +35,7 @@ void BasicBlock::PushInstruction(Instruction *insn)
         insn->SetPrev(lastInsn_);
         lastInsn_ = insn;
     }
+    AssignOrder(insn);
 }
 
 /// `prevInsn` -- instruction after which `insn` will be inserted
@@ -75,11 +47,13 @@ void BasicBlock::InsertInstruction(Instruction *prevInsn, Instruction *insn)
         return;
     }
 
+    insn->SetParentBB(this);
     if (prevInsn == nullptr) {
         firstInsn_->SetPrev(insn);
         insn->SetNext(firstInsn_);
         insn->SetPrev(nullptr);
         firstInsn_ = insn;
+        AssignOrder(insn);
         return;
     }
 
@@ -91,27 +65,106 @@ void BasicBlock::InsertInstruction(Instruction *prevInsn, Instruction *insn)
 
     insn->SetPrev(prevInsn);
     prevInsn->SetNext(insn);
+    AssignOrder(insn);
+}
+
+// Take the middle of the gap between neighbours, or mark the block for renumbering when there is no gap left.
+void BasicBlock::AssignOrder(Instruction *insn)
+{
+    if (!isOrderValid_) {
+        return;
+    }
+
+    auto *prev = insn->GetPrev();
+    auto *next = insn->GetNext();
+    uint64_t lower = (prev == nullptr) ? 0 : prev->GetOrder();
+    uint64_t upper = (next == nullptr) ? lower + 2U * INSN_ORDER_STEP : next->GetOrder();
+
+    auto order = lower + (upper - lower) / 2U;
+    if (UNLIKELY(order == lower || order > UINT32_MAX)) {
+        isOrderValid_ = false;
+        return;
+    }
+    insn->SetOrder(static_cast<uint32_t>(order));
+}
+
+void BasicBlock::RenumberInsns()
+{
+    uint32_t order = 0;
+    for (auto *insn = firstInsn_; insn != nullptr; insn = insn->GetNext()) {
+        order += INSN_ORDER_STEP;
+        insn->SetOrder(order);
+    }
+    isOrderValid_ = true;
 }
 
 void BasicBlock::Remove(Instruction *insnToRemove)
 {
     assert(insnToRemove != nullptr);
 
-    if (insnToRemove == firstInsn_) {
-        firstInsn_ = insnToRemove->GetNext();
-        firstInsn_->SetPrev(nullptr);
-    } else if (insnToRemove == lastInsn_) {
-        lastInsn_ = insnToRemove->GetPrev();
-        lastInsn_->SetNext(nullptr);
-    } else {
-        auto *prevInsn = insnToRemove->GetPrev();
-        auto *nextInsn = insnToRemove->GetNext();
+    auto *prevInsn = insnToRemove->GetPrev();
+    auto *nextInsn = insnToRemove->GetNext();
 
+    if (prevInsn == nullptr) {
+        assert(insnToRemove == firstInsn_);
+        firstInsn_ = nextInsn;
+    } else {
         prevInsn->SetNext(nextInsn);
+    }
+
+    if (nextInsn == nullptr) {
+        assert(insnToRemove == lastInsn_);
+        lastInsn_ = prevInsn;
+    } else {
         nextInsn->SetPrev(prevInsn);
     }
 
-    insnToRemove->GetInputs()->RemoveUsers(insnToRemove);
+    insnToRemove->ClearInputs();
+}
+
+void BasicBlock::RemovePredecessor(BasicBlock *block)
+{
+    std::erase(predecessors_, block);
+    for (auto *phi = firstInsn_; phi != nullptr && phi->IsPhi(); phi = phi->GetNext()) {
+        static_cast<PhiInsn *>(phi)->RemoveDependency(block);
+    }
+}
+
+void BasicBlock::RemoveSuccessor(BasicBlock *block)
+{
+    std::erase(successors_, block);
+    block->RemovePredecessor(this);
+    hasEdgeCounts_ = false;
+}
+
+void BasicBlock::SplitAfter(Instruction *insn, BasicBlock *block)
+{
+    assert(insn->GetParentBB() == this);
+    assert(block->firstInsn_ == nullptr && block->successors_.empty());
+
+    auto *movedInsn = insn->GetNext();
+    insn->SetNext(nullptr);
+    lastInsn_ = insn;
+    while (movedInsn != nullptr) {
+        auto *nextInsn = movedInsn->GetNext();
+        movedInsn->SetPrev(nullptr);
+        movedInsn->SetNext(nullptr);
+        block->PushInstruction(movedInsn);
+        movedInsn = nextInsn;
+    }
+
+    for (auto *succ : successors_) {
+        std::replace(succ->predecessors_.begin(), succ->predecessors_.end(), this, block);
+        for (auto *phi = succ->firstInsn_; phi != nullptr && phi->IsPhi(); phi = phi->GetNext()) {
+            static_cast<PhiInsn *>(phi)->ReplaceDependencyBlock(this, block);
+        }
+        block->successors_.push_back(succ);
+    }
+    successors_.clear();
+
+    block->edgeCounts_ = edgeCounts_;
+    block->hasEdgeCounts_ = hasEdgeCounts_;
+    hasEdgeCounts_ = false;
 }
 
 }  // namespace compiler
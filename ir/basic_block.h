@@ -4,10 +4,13 @@
 #include "utils/macros.h"
 #include "ir/instruction.h"
 #include "ir/marker.h"
+#include "utils/arena_allocator.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <memory>
 #include <sstream>
 
 namespace compiler {
@@ -18,11 +21,21 @@ class Loop;
 using BasicBlockId = size_t;
 
 class BasicBlock final {
+public:
+    // Distance between order numbers of adjacent instructions after renumbering,
+    // inserting in the middle of a block takes a number from the gap.
+    static constexpr uint32_t INSN_ORDER_STEP = 1U << 10U;
+
 public:
     NO_COPY_SEMANTIC(BasicBlock);
     NO_MOVE_SEMANTIC(BasicBlock);
 
-    BasicBlock() = default;
+    explicit BasicBlock(utils::ArenaAllocator *allocator)
+        : predecessors_(allocator->Adapter<BasicBlock *>()),
+          successors_(allocator->Adapter<BasicBlock *>()),
+          dominatedBlocks_(allocator->Adapter<BasicBlock *>())
+    {
+    }
     ~BasicBlock() = default;
 
     void PushInstruction(Instruction *insn);
@@ -33,6 +46,20 @@ public:
 
     void Remove(Instruction *insnToRemove);
 
+    /// Moves instructions following `insn` and the outgoing edges to the empty block `block`,
+    /// which then continues this one.
+    void SplitAfter(Instruction *insn, BasicBlock *block);
+
+    /// Whether `lhs` goes before `rhs`, both instructions must belong to this block.
+    bool IsInsnBefore(const Instruction *lhs, const Instruction *rhs)
+    {
+        assert(lhs->GetParentBB() == this && rhs->GetParentBB() == this);
+        if (UNLIKELY(!isOrderValid_)) {
+            RenumberInsns();
+        }
+        return lhs->GetOrder() < rhs->GetOrder();
+    }
+
     template <typename Callback>
     void EnumerateInsns(Callback callback)
     {
@@ -84,12 +111,18 @@ public:
         predecessors_.push_back(block);
     }
 
-    const std::vector<BasicBlock *> &GetSuccessors() const
+    /// Drops all edges from `block` and the values which phis take along them.
+    void RemovePredecessor(BasicBlock *block);
+
+    /// Drops all edges to `block` on both sides, measured edge counts don't apply anymore.
+    void RemoveSuccessor(BasicBlock *block);
+
+    const utils::ArenaVector<BasicBlock *> &GetSuccessors() const
     {
         return successors_;
     }
 
-    const std::vector<BasicBlock *> &GetPredecessors() const
+    const utils::ArenaVector<BasicBlock *> &GetPredecessors() const
     {
         return predecessors_;
     }
@@ -99,16 +132,37 @@ public:
         return lastInsn_;
     }
 
-    void SetMarker(Marker marker);
-    void EraseMarker(Marker marker);
-    bool IsMarked(Marker marker) const;
-    void ClearMarkers();
+    void SetMarker(Marker marker)
+    {
+        marker.Set<MarkedKind::BLOCK>(bbId_);
+    }
+
+    void EraseMarker(Marker marker)
+    {
+        marker.Reset<MarkedKind::BLOCK>(bbId_);
+    }
 
-    const std::vector<BasicBlock *> &GetDominatedBlocks() const
+    bool IsMarked(Marker marker) const
+    {
+        return marker.Check<MarkedKind::BLOCK>(bbId_);
+    }
+
+    /// Children of the block in the dominator tree.
+    const utils::ArenaVector<BasicBlock *> &GetDominatedBlocks() const
     {
         return dominatedBlocks_;
     }
 
+    void AddDominatedBlock(BasicBlock *block)
+    {
+        dominatedBlocks_.push_back(block);
+    }
+
+    void ClearDominatedBlocks()
+    {
+        dominatedBlocks_.clear();
+    }
+
     void SetImmediateDominator(BasicBlock *dominator)
     {
         immediateDominator_ = dominator;
@@ -124,24 +178,31 @@ public:
         return immediateDominator_;
     }
 
-    void SetDominatedBlocks(std::vector<BasicBlock *> &&dominatedBlocks)
+    /// Entry and exit numbers of the block in DFS over the dominator tree, zero for blocks outside of the tree.
+    void SetDomTreeInterval(uint32_t in, uint32_t out)
+    {
+        domTreeIn_ = in;
+        domTreeOut_ = out;
+    }
+
+    uint32_t GetDomTreeIn() const
     {
-        dominatedBlocks_ = std::move(dominatedBlocks);
+        return domTreeIn_;
     }
 
-    void SetDominatedBlocks(const std::vector<BasicBlock *> &dominatedBlocks)
+    uint32_t GetDomTreeOut() const
     {
-        dominatedBlocks_ = dominatedBlocks;
+        return domTreeOut_;
     }
 
-    bool IsDominatesOver(BasicBlock *block) const
+    /// The block dominates over `block` iff its DFS interval in the dominator tree encloses the interval of `block`.
+    bool IsDominatesOver(const BasicBlock *block) const
     {
+        assert(block != nullptr);
         if (block == this) {
             return true;
         }
-        auto it = std::find_if(dominatedBlocks_.begin(), dominatedBlocks_.end(),
-                               [block](auto domBlock) { return domBlock == block; });
-        return it != dominatedBlocks_.end();
+        return domTreeIn_ != 0 && domTreeIn_ <= block->domTreeIn_ && block->domTreeOut_ <= domTreeOut_;
     }
 
     void SetLoop(Loop *loop)
@@ -161,26 +222,54 @@ public:
 
     bool IsHeader() const;
 
+    /// Measured numbers of transitions to the successors, they take place of static branch probabilities.
+    /// Like other CFG changes, setting them must be followed by AnalysisManager::Invalidate().
+    void SetEdgeCounts(uint64_t firstCount, uint64_t secondCount)
+    {
+        edgeCounts_ = {firstCount, secondCount};
+        hasEdgeCounts_ = true;
+    }
+
+    bool HasEdgeCounts() const
+    {
+        return hasEdgeCounts_;
+    }
+
+    uint64_t GetEdgeCount(size_t succIdx) const
+    {
+        assert(hasEdgeCounts_ && succIdx < edgeCounts_.size());
+        return edgeCounts_[succIdx];
+    }
+
     void Dump(std::stringstream &ss) const;
 
+private:
+    void AssignOrder(Instruction *insn);
+    void RenumberInsns();
+
 private:
     BasicBlockId bbId_ {0};
 
-    std::vector<BasicBlock *> predecessors_;
-    std::vector<BasicBlock *> successors_;
+    utils::ArenaVector<BasicBlock *> predecessors_;
+    utils::ArenaVector<BasicBlock *> successors_;
 
     Instruction *firstPhi_ {nullptr};
     Instruction *firstInsn_ {nullptr};
     Instruction *lastInsn_ {nullptr};
+    // Order numbers are repaired lazily, on the first query after they ran out of gaps.
+    bool isOrderValid_ {true};
 
     Graph *graph_ {nullptr};
 
-    std::array<Marker, MarkerManager::COLORS_NUM> markers_;
-
     BasicBlock *immediateDominator_ {nullptr};
-    std::vector<BasicBlock *> dominatedBlocks_;
+    utils::ArenaVector<BasicBlock *> dominatedBlocks_;
+    uint32_t domTreeIn_ {0};
+    uint32_t domTreeOut_ {0};
 
     Loop *loop_ {nullptr};
+
+    std::array<uint64_t, 2U> edgeCounts_ {};
+    bool hasEdgeCounts_ {false};
 };
 
 }  // namespace compiler
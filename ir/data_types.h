@@ -1,6 +1,8 @@
 #ifndef IR_DATA_TYPES_H
 #define IR_DATA_TYPES_H
 
+#include <cstddef>
+
 namespace compiler {
 
 enum class DataType {
@@ -19,6 +21,8 @@ enum class DataType {
     REF,
 };
 
+constexpr size_t DATA_TYPES_COUNT = static_cast<size_t>(DataType::REF) + 1U;
+
 }  // namespace compiler
 
 #endif  // IR_DATA_TYPES_H
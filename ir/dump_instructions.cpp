@@ -38,27 +38,17 @@ void PhiInsn::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
 
-    for (auto dependencyIt = dependencies_.cbegin(); dependencyIt != dependencies_.cend(); ++dependencyIt) {
-        auto &[inst, bbs] = *dependencyIt;
-
-        for (auto bbIt = bbs.cbegin(); bbIt != bbs.cend(); ++bbIt) {
-            ss << 'v' << inst->GetId() << ":BB_" << (*bbIt)->GetId();
-            if (std::next(bbIt) != bbs.cend()) {
-                ss << ", ";
-            }
-        }
-
-        if (dependencies_.cend() != std::next(dependencyIt)) {
-            ss << ", ";
-        }
+    for (size_t idx = 0; idx < dependencies_.size(); ++idx) {
+        auto &dependency = dependencies_[idx];
+        ss << (idx == 0 ? "" : ", ") << 'v' << dependency.value->GetId() << ":BB_" << dependency.block->GetId();
     }
 }
 
 void ArithmeticInsn::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
-    ss << "v" << GetInputs()->GetInput(0)->GetId() << ", "
-       << "v" << GetInputs()->GetInput(1)->GetId();
+    ss << "v" << GetInput(0)->GetId() << ", "
+       << "v" << GetInput(1)->GetId();
 }
 
 void JmpInsn::Dump(std::stringstream &ss) const
@@ -70,8 +60,8 @@ void JmpInsn::Dump(std::stringstream &ss) const
 void BranchInsn::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
-    ss << "v" << GetInputs()->GetInput(0)->GetId() << ", "
-       << "v" << GetInputs()->GetInput(1)->GetId() << ", ";
+    ss << "v" << GetInput(0)->GetId() << ", "
+       << "v" << GetInput(1)->GetId() << ", ";
     ss << "BB_" << GetTrueBranchBB()->GetId() << ", BB_" << GetFalseBranchBB()->GetId();
 }
 
@@ -79,7 +69,7 @@ void RetInsn::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
 
-    auto input = GetInputs()->GetInput(0);
+    auto input = GetInput(0);
     if (input != nullptr) {
         ss << "v" << input->GetId();
     }
@@ -88,17 +78,25 @@ void RetInsn::Dump(std::stringstream &ss) const
 void NullCheckInsn::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
-    ss << "v" << objectValueToCheck_->GetId();
+    ss << "v" << GetInsnToCheck()->GetId();
+}
+
+void CallStaticInsn::Dump(std::stringstream &ss) const
+{
+    Instruction::Dump(ss);
+    ss << "method_" << methodId_;
+    for (size_t idx = 0; idx < GetInputsCount(); ++idx) {
+        ss << ", v" << GetInput(idx)->GetId();
+    }
 }
 
 void BoundsCheckInsn::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
-    auto &inputs = GetInputs()->AsVectorInputs()->GetInputs();
-    for (auto it = inputs.cbegin(); it < inputs.cend(); ++it) {
-        ss << "v" << (*it)->GetId();
+    for (size_t idx = 0; idx < GetInputsCount(); ++idx) {
+        ss << "v" << GetInput(idx)->GetId();
 
-        if (std::next(it) != inputs.cend()) {
+        if (idx + 1 != GetInputsCount()) {
             ss << ", ";
         }
     }
@@ -107,11 +105,10 @@ void BoundsCheckInsn::Dump(std::stringstream &ss) const
 void StoreArrayInsn::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
-    auto &inputs = GetInputs()->AsVectorInputs()->GetInputs();
-    for (auto it = inputs.cbegin(); it < inputs.cend(); ++it) {
-        ss << "v" << (*it)->GetId();
+    for (size_t idx = 0; idx < GetInputsCount(); ++idx) {
+        ss << "v" << GetInput(idx)->GetId();
 
-        if (std::next(it) != inputs.cend()) {
+        if (idx + 1 != GetInputsCount()) {
             ss << ", ";
         }
     }
@@ -120,8 +117,8 @@ void StoreArrayInsn::Dump(std::stringstream &ss) const
 void LoadArrayInsn::Dump(std::stringstream &ss) const
 {
     Instruction::Dump(ss);
-    ss << "v" << GetInputs()->GetInput(0)->GetId() << ", "
-       << "v" << GetInputs()->GetInput(1)->GetId();
+    ss << "v" << GetInput(0)->GetId() << ", "
+       << "v" << GetInput(1)->GetId();
 }
 
 }  // namespace compiler
@@ -1,11 +1,13 @@
 #include "ir/graph.h"
 #include "analysis/rpo.h"
-#include "analysis/dominator_tree.h"
 #include "ir/instructions.h"
 
 namespace compiler {
 
 Graph::Graph()
+    : basicBlocks_(allocator_.Adapter<BasicBlock *>()),
+      instructions_(allocator_.Adapter<Instruction *>()),
+      loops_(allocator_.Adapter<Loop *>())
 {
     static size_t newGraphCounter = 0;
     methodId_ = newGraphCounter++;
@@ -16,18 +18,25 @@ size_t Graph::GetMethodId() const
     return methodId_;
 }
 
-void Graph::AddBlock(std::unique_ptr<BasicBlock> block)
+BasicBlock *Graph::CreateNewBlock()
+{
+    auto *block = allocator_.New<BasicBlock>(&allocator_);
+    AddBlock(block);
+    return block;
+}
+
+void Graph::AddBlock(BasicBlock *block)
 {
     size_t currblockNum = basicBlocks_.size();
     block->SetId(currblockNum);
     block->SetGraph(this);
-    basicBlocks_.push_back(std::move(block));
+    basicBlocks_.push_back(block);
 }
 
-void Graph::AddInstruction(std::unique_ptr<Instruction> insn)
+void Graph::AddInstruction(Instruction *insn)
 {
     insn->SetId(instructions_.size());
-    instructions_.push_back(std::move(insn));
+    instructions_.push_back(insn);
 }
 
 void Graph::Dump(std::stringstream &ss) const
@@ -39,7 +48,7 @@ void Graph::Dump(std::stringstream &ss) const
 
 BasicBlock *Graph::GetStartBlock() const
 {
-    return basicBlocks_.front().get();
+    return basicBlocks_.front();
 }
 
 size_t Graph::GetAliveBlockCount() const
@@ -47,6 +56,23 @@ size_t Graph::GetAliveBlockCount() const
     return basicBlocks_.size();
 }
 
+void Graph::RenumberIds()
+{
+    assert(markerManager_.GetLiveMarkersCount() == 0);
+
+    for (size_t idx = 0; idx < basicBlocks_.size(); ++idx) {
+        basicBlocks_[idx]->SetId(idx);
+    }
+
+    instructions_.clear();
+    for (auto *block : basicBlocks_) {
+        block->EnumerateInsns([this](Instruction *insn) {
+            AddInstruction(insn);
+            return false;
+        });
+    }
+}
+
 void Graph::RunRpo()
 {
     RPO rpo(this);
@@ -57,30 +83,57 @@ void Graph::RunRpo()
     EraseMarker(marker);
 }
 
-std::vector<BasicBlock *> &Graph::GetRpoVector()
+void Graph::RemoveUnreachableBlocks()
 {
-    return rpoVector_;
+    assert(markerManager_.GetLiveMarkersCount() == 0);
+
+    RunRpo();
+    auto marker = CreateNewMarker();
+    for (auto *block : rpoVector_) {
+        block->SetMarker(marker);
+    }
+
+    for (auto *block : basicBlocks_) {
+        if (block->IsMarked(marker)) {
+            continue;
+        }
+        for (auto *succ : block->GetSuccessors()) {
+            if (succ->IsMarked(marker)) {
+                succ->RemovePredecessor(block);
+            }
+        }
+        block->EnumerateInsns([block](Instruction *insn) {
+            block->Remove(insn);
+            return false;
+        });
+    }
+
+    std::erase_if(basicBlocks_, [marker](const BasicBlock *block) { return !block->IsMarked(marker); });
+    EraseMarker(marker);
+
+    for (size_t idx = 0; idx < basicBlocks_.size(); ++idx) {
+        basicBlocks_[idx]->SetId(idx);
+    }
 }
 
-const std::vector<BasicBlock *> &Graph::GetRpoVector() const
+std::vector<BasicBlock *> &Graph::GetRpoVector()
 {
     return rpoVector_;
 }
 
-void Graph::BuildDominatorTree()
+const std::vector<BasicBlock *> &Graph::GetRpoVector() const
 {
-    DominatorTree tree(this);
-    tree.Build();
+    return rpoVector_;
 }
 
-void Graph::SetRootLoop(std::unique_ptr<Loop> rootLoop)
+void Graph::SetRootLoop(Loop *rootLoop)
 {
-    rootLoop_ = std::move(rootLoop);
+    rootLoop_ = rootLoop;
 }
 
 Loop *Graph::GetRootLoop() const
 {
-    return rootLoop_.get();
+    return rootLoop_;
 }
 
 Marker Graph::CreateNewMarker()
@@ -95,12 +148,14 @@ void Graph::EraseMarker(Marker marker)
 
 Loop *Graph::CreateNewLoop(BasicBlock *header)
 {
-    auto loop = std::make_unique<Loop>(header);
-    auto loopPtr = loop.get();
-    loop->PushBlock(header);
+    auto *loop = allocator_.New<Loop>(&allocator_, header);
+    loop->SetId(loops_.size());
+    if (header != nullptr) {
+        loop->PushBlock(header);
+    }
 
-    loops_.push_back(std::move(loop));
-    return loopPtr;
+    loops_.push_back(loop);
+    return loop;
 }
 
 }  // namespace compiler
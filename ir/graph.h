@@ -2,8 +2,9 @@
 #define IR_GRAPH_H
 
 #include "utils/macros.h"
+#include "utils/arena_allocator.h"
 
-#include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "ir/basic_block.h"
@@ -11,11 +12,13 @@
 #include "ir/instructions.h"
 #include "ir/marker.h"
 
+#include "analysis/analysis_manager.h"
 #include "analysis/loop.h"
 
 namespace compiler {
 
 class RPO;
+class MethodRegistry;
 
 class Graph final {
 public:
@@ -25,21 +28,50 @@ public:
     Graph();
     ~Graph() = default;
 
-    void AddBlock(std::unique_ptr<BasicBlock> block);
-    void AddInstruction(std::unique_ptr<Instruction> insn);
+    utils::ArenaAllocator *GetAllocator()
+    {
+        return &allocator_;
+    }
+
+    BasicBlock *CreateNewBlock();
+
+    void AddBlock(BasicBlock *block);
+    void AddInstruction(Instruction *insn);
 
     BasicBlock *GetStartBlock() const;
 
+    const utils::ArenaVector<BasicBlock *> &GetBlocks() const
+    {
+        return basicBlocks_;
+    }
+
+    // Instructions which have ever been created in the graph, including removed ones until RenumberIds.
+    const utils::ArenaVector<Instruction *> &GetInstructions() const
+    {
+        return instructions_;
+    }
+
     size_t GetAliveBlockCount() const;
 
+    // Gives dense ids to blocks and to instructions which are still in blocks, in layout order.
+    // Ids are keys of markers and side tables, so no marker may be alive.
+    void RenumberIds();
+
     void RunRpo();
 
+    // Drops blocks which are not reachable from the start block, together with their edges and instructions.
+    // Blocks get dense ids, so no marker may be alive.
+    void RemoveUnreachableBlocks();
+
     std::vector<BasicBlock *> &GetRpoVector();
     const std::vector<BasicBlock *> &GetRpoVector() const;
 
-    void BuildDominatorTree();
+    AnalysisManager *GetAnalysisManager()
+    {
+        return &analysisManager_;
+    }
 
-    void SetRootLoop(std::unique_ptr<Loop> rootLoop);
+    void SetRootLoop(Loop *rootLoop);
     Loop *GetRootLoop() const;
 
     void Dump(std::stringstream &ss) const;
@@ -49,14 +81,24 @@ public:
 
     Loop *CreateNewLoop(BasicBlock *header);
 
+    // Loops of all runs of LoopAnalyzer, only those reachable from the root loop are actual.
+    const utils::ArenaVector<Loop *> &GetLoops() const
+    {
+        return loops_;
+    }
+
     template <typename InsnT, typename... Args>
     InsnT *CreateInsn(Args &&...args)
     {
-        auto insn = std::make_unique<InsnT>(std::forward<Args>(args)...);
-
-        auto *insnPtr = insn.get();
-        AddInstruction(std::move(insn));
-        return insnPtr;
+        InsnT *insn = nullptr;
+        // Only instructions with growable storage (e.g. dynamic inputs) need the arena themselves.
+        if constexpr (std::is_constructible_v<InsnT, utils::ArenaAllocator *, Args &&...>) {
+            insn = allocator_.New<InsnT>(&allocator_, std::forward<Args>(args)...);
+        } else {
+            insn = allocator_.New<InsnT>(std::forward<Args>(args)...);
+        }
+        AddInstruction(insn);
+        return insn;
     }
 
     template <typename InsnT, typename... Args>
@@ -75,19 +117,35 @@ public:
 
     size_t GetMethodId() const;
 
+    void SetMethodRegistry(MethodRegistry *registry)
+    {
+        methodRegistry_ = registry;
+    }
+
+    MethodRegistry *GetMethodRegistry() const
+    {
+        return methodRegistry_;
+    }
+
 private:
+    // Must be declared first: it is destroyed last and releases memory of all IR objects at once.
+    utils::ArenaAllocator allocator_;
+
     // Graph owns all basic blocks and instruction of the current function.
-    std::vector<std::unique_ptr<BasicBlock>> basicBlocks_;
-    std::vector<std::unique_ptr<Instruction>> instructions_;
-    std::vector<std::unique_ptr<Loop>> loops_;
+    utils::ArenaVector<BasicBlock *> basicBlocks_;
+    utils::ArenaVector<Instruction *> instructions_;
+    utils::ArenaVector<Loop *> loops_;
 
     std::vector<BasicBlock *> rpoVector_;
 
-    std::unique_ptr<Loop> rootLoop_;
+    Loop *rootLoop_ {nullptr};
 
     MarkerManager markerManager_;
 
+    AnalysisManager analysisManager_ {this};
+
     size_t methodId_ {0};
+    MethodRegistry *methodRegistry_ {nullptr};
 };
 
 }  // namespace compiler
@@ -51,8 +51,8 @@ inline T CastToType(T, DataType)
 inline std::string OpcodeToString(Opcode opcode)
 {
     (void)opcode;
-#define OPCODE_MACROS(insn, _) \
-    case Opcode::insn:         \
+#define OPCODE_MACROS(insn, instrType, inputsCount) \
+    case Opcode::insn:                              \
         return #insn;
 
     switch (opcode) {
@@ -5,65 +5,28 @@
 
 namespace compiler {
 
-bool Instruction::TryReplaceInput(Instruction *inputToReplace, Instruction *insnToReplaceWith, size_t idx)
-{
-    if (inputs_->GetInput(idx) == inputToReplace) {
-        return inputs_->SetInput(insnToReplaceWith, idx);
-    }
-    return false;
-}
-
-bool Instruction::ReplaceInputs(Instruction *inputToReplace, Instruction *insnToReplaceWith)
-{
-    assert(opcode_ != Opcode::PHI);
-
-    bool succ0 = TryReplaceInput(inputToReplace, insnToReplaceWith, 0);
-    bool succ1 = TryReplaceInput(inputToReplace, insnToReplaceWith, 1);
-
-    return succ0 || succ1;
-}
-
-bool Instruction::ReplaceVectorInputs(Instruction *inputToReplace, Instruction *insnToReplaceWith)
-{
-    bool inputsReplaced = false;
-
-    auto &inputs = inputs_->AsVectorInputs()->GetInputs();
-    for (auto it = inputs.begin(); it != inputs.end(); ++it) {
-        if (*it == inputToReplace) {
-            *it = insnToReplaceWith;
-            inputsReplaced = true;
-        }
-    }
-
-    if (IsPhi() && inputsReplaced) {
-        auto *phiInsn = static_cast<PhiInsn *>(this);
-        bool depsReplaced = phiInsn->ReplaceDependency(inputToReplace, insnToReplaceWith);
-        if (UNLIKELY(!depsReplaced)) {
-            std::cerr << "ReplaceInputsPhi: failed to replaced dependency." << std::endl;
-            UNREACHABLE();
-        }
-    }
-
-    return inputsReplaced;
-}
-
 /// For all users of this insn change inputs from this insn to given.
 void Instruction::ReplaceInputsForUsers(Instruction *insnToReplaceWith)
 {
-    for (auto userIt = users_.begin(); userIt != users_.end();) {
-        // Need to save iterator, because of removing user from list below.
-        auto currUser = *(userIt++);
-
-        bool isReplaced = currUser->HasVectorInputs() ? currUser->ReplaceVectorInputs(this, insnToReplaceWith)
-                                                      : currUser->ReplaceInputs(this, insnToReplaceWith);
-
-        if (isReplaced) {
-            // Now we successfully replace input for current user,
-            // it means that `this` insn do not have this user, so we need to remove it.
-            this->RemoveUser(currUser);
-            // Current user is new user for insn by which we replace `this` insn.
-            insnToReplaceWith->AddUser(currUser);
+    assert(insnToReplaceWith != this);
+
+    while (!users_.empty()) {
+        auto *use = users_.GetFirst();
+        auto *user = use->GetUser();
+
+        // A phi keeps one input per value, so the slot is dropped if the phi merges `insnToReplaceWith` already.
+        if (user->IsPhi()) {
+            auto *phi = static_cast<PhiInsn *>(user);
+            bool isMerged = phi->HasDependency(insnToReplaceWith);
+            [[maybe_unused]] bool depsReplaced = phi->ReplaceDependency(this, insnToReplaceWith);
+            assert(depsReplaced);
+            if (isMerged) {
+                phi->RemoveInput(use->GetIndex());
+                continue;
+            }
         }
+        // Moves the use to the list of `insnToReplaceWith`.
+        use->SetValue(insnToReplaceWith);
     }
 }
 
@@ -89,21 +52,7 @@ bool Instruction::DominatedOver(Instruction *insn)
         return parentBB_->IsDominatesOver(insn->GetParentBB());
     }
 
-    bool result = false;
-
-    parentBB_->EnumerateInsns([&result, &insn, this](Instruction *currInsn) {
-        if (currInsn == insn) {
-            result = false;
-            return true;
-        } else if (currInsn == this) {
-            result = true;
-            return true;
-        }
-
-        return false;
-    });
-
-    return result;
+    return parentBB_->IsInsnBefore(this, insn);
 }
 
 bool Instruction::DoesProduceReference() const
@@ -3,15 +3,18 @@
 
 #include "ir/data_types.h"
 #include "ir/opcodes.h"
+#include "ir/marker.h"
 #include "utils/macros.h"
-#include "ir/inputs.h"
+#include "ir/use.h"
+#include "utils/arena_allocator.h"
+#include "utils/small_vector.h"
 
 #include <array>
 #include <vector>
-#include <list>
+#include <span>
 #include <sstream>
-#include <memory>
 #include <iostream>
+#include <utility>
 
 namespace compiler {
 
@@ -25,13 +28,9 @@ public:
     NO_COPY_SEMANTIC(Instruction);
     NO_MOVE_SEMANTIC(Instruction);
 
-    Instruction(Opcode opcode, DataType resultType = DataType::UNDEFINED) : opcode_(opcode), resultType_(resultType)
+    explicit Instruction(Opcode opcode, DataType resultType = DataType::UNDEFINED)
+        : opcode_(opcode), resultType_(resultType)
     {
-        if (HasVectorInputs()) {
-            inputs_ = std::make_unique<VectorInputs>();
-        } else {
-            inputs_ = std::make_unique<DefaultInputs>();
-        }
     }
 
     virtual ~Instruction() = default;
@@ -66,49 +65,66 @@ public:
         return prev_;
     }
 
-    void AddUser(Instruction *user)
+    UseList &GetUsers()
     {
-        users_.push_back(user);
+        return users_;
     }
 
-    std::list<Instruction *> &GetUsers()
+    const UseList &GetUsers() const
     {
         return users_;
     }
 
-    const std::list<Instruction *> &GetUsers() const
+    Instruction *GetInput(size_t idx)
     {
-        return users_;
+        assert(idx < inputsCount_);
+        return inputs_[idx].GetValue();
     }
 
-    std::list<Instruction *>::iterator RemoveUser(std::list<Instruction *>::iterator userIt)
+    const Instruction *GetInput(size_t idx) const
     {
-        return users_.erase(userIt);
+        assert(idx < inputsCount_);
+        return inputs_[idx].GetValue();
     }
 
-    void RemoveUser(Instruction *userToRemove)
+    /// Store `input` into the slot `idx`, keeping use lists of the old and new values up to date.
+    void SetInput(Instruction *input, size_t idx)
     {
-        auto it = std::find(users_.begin(), users_.end(), userToRemove);
-        if (it != users_.end()) {
-            users_.erase(it);
-        }
+        assert(input != nullptr);
+        assert(idx < inputsCount_);
+        inputs_[idx].SetValue(input);
     }
 
-    const InputsContainerIface *GetInputs() const
+    size_t GetInputsCount() const
     {
-        return inputs_.get();
+        return inputsCount_;
     }
 
-    InputsContainerIface *GetInputs()
+    std::span<Use> GetInputs()
     {
-        return inputs_.get();
+        return {inputs_, inputsCount_};
     }
 
-    bool TryReplaceInput(Instruction *inputToReplace, Instruction *insnToReplaceWith, size_t idx);
+    std::span<const Use> GetInputs() const
+    {
+        return {inputs_, inputsCount_};
+    }
 
-    bool ReplaceInputs(Instruction *inputToReplace, Instruction *insnToReplaceWith);
+    void SwapInputs()
+    {
+        assert(inputsCount_ == 2U);
+        auto *input0 = inputs_[0].GetValue();
+        inputs_[0].SetValue(inputs_[1].GetValue());
+        inputs_[1].SetValue(input0);
+    }
 
-    bool ReplaceVectorInputs(Instruction *inputToReplace, Instruction *insnToReplaceWith);
+    /// Reset all slots, removing them from use lists of the inputs.
+    void ClearInputs()
+    {
+        for (auto &input : GetInputs()) {
+            input.SetValue(nullptr);
+        }
+    }
 
     /// For all users of this insn change inputs from this insn to given.
     void ReplaceInputsForUsers(Instruction *insnToReplaceWith);
@@ -148,9 +164,25 @@ public:
         return opcode_ == Opcode::BOUNDSCHECK;
     }
 
-    bool HasVectorInputs() const
+    // Whether the instruction defines a value for other instructions.
+    bool HasResult() const
+    {
+        switch (opcode_) {
+            case Opcode::JMP:
+            case Opcode::BEQ:
+            case Opcode::BNE:
+            case Opcode::BGT:
+            case Opcode::RET:
+            case Opcode::STOREARRAY:
+                return false;
+            default:
+                return resultType_ != DataType::VOID;
+        }
+    }
+
+    bool HasDynamicInputs() const
     {
-        return IsPhi() || IsCall() || IsStoreArray() || IsBoundCheck();
+        return GetOpcodeInputsCount(opcode_) == DYNAMIC_INPUTS;
     }
 
     bool DoesProduceReference() const;
@@ -192,8 +224,42 @@ public:
 
     bool DominatedOver(Instruction *insn);
 
+    /// Position in the parent block, valid only while the block keeps its order numbers up to date.
+    void SetOrder(uint32_t order)
+    {
+        order_ = order;
+    }
+
+    uint32_t GetOrder() const
+    {
+        return order_;
+    }
+
+    void SetMarker(Marker marker)
+    {
+        marker.Set<MarkedKind::INSN>(insnId_);
+    }
+
+    void EraseMarker(Marker marker)
+    {
+        marker.Reset<MarkedKind::INSN>(insnId_);
+    }
+
+    bool IsMarked(Marker marker) const
+    {
+        return marker.Check<MarkedKind::INSN>(insnId_);
+    }
+
     virtual void Dump(std::stringstream &ss) const;
 
+protected:
+    // Operand slots are owned by the derived classes, see FixedInputsInstruction and DynamicInputsInstruction.
+    void SetInputsStorage(Use *inputs, size_t count)
+    {
+        inputs_ = inputs;
+        inputsCount_ = static_cast<uint32_t>(count);
+    }
+
 private:
     Instruction *prev_ {nullptr};
     Instruction *next_ {nullptr};
@@ -201,13 +267,105 @@ private:
     BasicBlock *parentBB_ {nullptr};
 
     InstructionId insnId_ {0};
+    uint32_t order_ {0};
     Opcode opcode_ {Opcode::UNDEFINED};
     DataType resultType_;
 
-    std::unique_ptr<InputsContainerIface> inputs_;
-    std::list<Instruction *> users_;
+    Use *inputs_ {nullptr};
+    uint32_t inputsCount_ {0};
+    UseList users_;
+};
+
+// Instruction with the number of inputs fixed by its opcode, the slots are stored right in the instruction.
+template <size_t INPUTS_COUNT>
+class FixedInputsInstruction : public Instruction {
+public:
+    FixedInputsInstruction(Opcode opcode, DataType resultType)
+        : Instruction(opcode, resultType), inputs_(CreateInputs(std::make_index_sequence<INPUTS_COUNT>()))
+    {
+        assert(GetOpcodeInputsCount(opcode) == INPUTS_COUNT);
+        SetInputsStorage(inputs_.data(), INPUTS_COUNT);
+    }
+
+private:
+    template <size_t... IDX>
+    std::array<Use, INPUTS_COUNT> CreateInputs(std::index_sequence<IDX...>)
+    {
+        return {Use(this, IDX)...};
+    }
+
+private:
+    std::array<Use, INPUTS_COUNT> inputs_;
+};
+
+// Instruction with an arbitrary number of inputs.
+// The first `INLINE_INPUTS_COUNT` slots are stored in the instruction, the rest spill to the arena.
+template <size_t INLINE_INPUTS_COUNT>
+class DynamicInputsInstruction : public Instruction {
+public:
+    DynamicInputsInstruction(utils::ArenaAllocator *allocator, Opcode opcode, DataType resultType)
+        : Instruction(opcode, resultType), inputs_(allocator)
+    {
+        assert(GetOpcodeInputsCount(opcode) == DYNAMIC_INPUTS);
+    }
+
+    void AppendInput(Instruction *input)
+    {
+        assert(input != nullptr);
+        auto &use = inputs_.emplace_back(this, static_cast<uint32_t>(inputs_.size()));
+        SetInputsStorage(inputs_.data(), inputs_.size());
+        use.SetValue(input);
+    }
+
+    void ReserveInputs(size_t count)
+    {
+        inputs_.reserve(count);
+        SetInputsStorage(inputs_.data(), inputs_.size());
+    }
+
+    // The last input takes the place of the removed one.
+    void RemoveInput(size_t idx)
+    {
+        assert(idx < inputs_.size());
+        auto lastIdx = inputs_.size() - 1U;
+        if (idx != lastIdx) {
+            inputs_[idx].SetValue(inputs_[lastIdx].GetValue());
+        }
+        inputs_.back().SetValue(nullptr);
+        inputs_.pop_back();
+        SetInputsStorage(inputs_.data(), inputs_.size());
+    }
+
+private:
+    utils::SmallVector<Use, INLINE_INPUTS_COUNT> inputs_;
 };
 
+inline Use::Use(Use &&other) noexcept
+    : value_(other.value_), user_(other.user_), idx_(other.idx_), prev_(other.prev_), next_(other.next_)
+{
+    if (value_ != nullptr) {
+        value_->GetUsers().Relink(&other, this);
+    }
+
+    other.value_ = nullptr;
+    other.prev_ = nullptr;
+    other.next_ = nullptr;
+}
+
+inline void Use::SetValue(Instruction *value)
+{
+    if (value_ == value) {
+        return;
+    }
+    if (value_ != nullptr) {
+        value_->GetUsers().Remove(this);
+    }
+    value_ = value;
+    if (value_ != nullptr) {
+        value_->GetUsers().PushBack(this);
+    }
+}
+
 }  // namespace compiler
 
 #endif  // IR_INSTRUCTION_H
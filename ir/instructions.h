@@ -2,12 +2,11 @@
 #define IR_INSTRUCTIONS_H
 
 #include "ir/data_types.h"
-#include "ir/inputs.h"
 #include "ir/instruction.h"
 #include "utils/bit_utils.h"
 
+#include <algorithm>
 #include <cmath>
-#include <unordered_map>
 
 namespace compiler {
 
@@ -18,7 +17,7 @@ public:
 
 class ParameterInsn final : public Instruction {
 public:
-    ParameterInsn(uint32_t argNum, DataType paramType = DataType::UNDEFINED)
+    explicit ParameterInsn(uint32_t argNum, DataType paramType = DataType::UNDEFINED)
         : Instruction(Opcode::PARAMETER, DataType::U32), argNum_(argNum), paramType_(paramType)
     {
     }
@@ -163,79 +162,91 @@ private:
     uint64_t value_ {0};
 };
 
-class PhiInsn final : public Instruction {
+class PhiInsn final : public DynamicInputsInstruction<2U> {
 public:
-    using ValueToBBMap = std::unordered_map<Instruction *, std::list<BasicBlock *>>;
+    // Value coming to the phi from the predecessor block.
+    struct Dependency {
+        Instruction *value {nullptr};
+        BasicBlock *block {nullptr};
+    };
 
-    PhiInsn(DataType resultType) : Instruction(Opcode::PHI, resultType) {}
-
-    ValueToBBMap &GetDependenciesMap()
+    PhiInsn(utils::ArenaAllocator *allocator, DataType resultType)
+        : DynamicInputsInstruction(allocator, Opcode::PHI, resultType), dependencies_(allocator->Adapter())
     {
-        return dependencies_;
     }
 
-    const ValueToBBMap &GetDependenciesMap() const
+    // In order of resolving, a value coming from several blocks has several entries but one input.
+    const utils::ArenaVector<Dependency> &GetDependencies() const
     {
         return dependencies_;
     }
 
     void ResolveDependency(Instruction *value, BasicBlock *bb)
     {
-        auto it = dependencies_.find(value);
-        if (it == dependencies_.end()) {
-            GetInputs()->AppendInput(value);
-            value->AddUser(this);
+        auto isInput = std::any_of(dependencies_.begin(), dependencies_.end(),
+                                   [value](const Dependency &dependency) { return dependency.value == value; });
+        if (!isInput) {
+            AppendInput(value);
         }
-        dependencies_[value].push_back(bb);
+        dependencies_.push_back({value, bb});
     }
 
-    bool ReplaceDependency(Instruction *oldValue, Instruction *newValue)
+    bool HasDependency(const Instruction *value) const
     {
-        auto node = dependencies_.extract(oldValue);
-        if (node.empty()) {
-            return false;
-        }
+        return std::any_of(dependencies_.begin(), dependencies_.end(),
+                           [value](const Dependency &dependency) { return dependency.value == value; });
+    }
 
-        auto nodeWithNewValue = dependencies_.find(newValue);
-        if (nodeWithNewValue == dependencies_.end()) {
-            node.key() = newValue;
-            dependencies_.insert(std::move(node));
-        } else {
-            auto &oldValueBBVec = node.mapped();
-            dependencies_[newValue].merge(std::move(oldValueBBVec));
+    bool ReplaceDependency(Instruction *oldValue, Instruction *newValue)
+    {
+        bool replaced = false;
+        for (auto &dependency : dependencies_) {
+            if (dependency.value == oldValue) {
+                dependency.value = newValue;
+                replaced = true;
+            }
         }
-
-        return true;
+        return replaced;
     }
 
-    VectorInputs *GetInputs()
+    // Drops values coming from the predecessor which is removed, and inputs which are not merged anymore.
+    void RemoveDependency(BasicBlock *block)
     {
-        return static_cast<VectorInputs *>(Instruction::GetInputs());
+        std::erase_if(dependencies_, [block](const Dependency &dependency) { return dependency.block == block; });
+        for (size_t idx = GetInputsCount(); idx != 0; --idx) {
+            auto *value = GetInput(idx - 1U);
+            auto isMerged = std::any_of(dependencies_.begin(), dependencies_.end(),
+                                        [value](const Dependency &dependency) { return dependency.value == value; });
+            if (!isMerged) {
+                RemoveInput(idx - 1U);
+            }
+        }
     }
 
-    const VectorInputs *GetInputs() const
+    // Values which came from `oldBlock` come from `newBlock` after the edge is moved.
+    void ReplaceDependencyBlock(BasicBlock *oldBlock, BasicBlock *newBlock)
     {
-        return static_cast<const VectorInputs *>(Instruction::GetInputs());
+        for (auto &dependency : dependencies_) {
+            if (dependency.block == oldBlock) {
+                dependency.block = newBlock;
+            }
+        }
     }
 
     void Dump(std::stringstream &ss) const override;
 
 private:
-    ValueToBBMap dependencies_;
+    utils::ArenaVector<Dependency> dependencies_;
 };
 
-class ArithmeticInsn : public Instruction {
+// All arithmetic opcodes are binary.
+class ArithmeticInsn : public FixedInputsInstruction<GetOpcodeInputsCount(Opcode::ADD)> {
 public:
     ArithmeticInsn(Opcode opcode, DataType resultType, Instruction *input1, Instruction *input2)
-        : Instruction(opcode, resultType)
+        : FixedInputsInstruction(opcode, resultType)
     {
-        GetInputs()->SetInput(input1, 0);
-        GetInputs()->SetInput(input2, 1);
-        input1->AddUser(this);
-        if (input1 == input2) {
-            return;
-        }
-        input2->AddUser(this);
+        SetInput(input1, 0);
+        SetInput(input2, 1);
     }
 
     void Dump(std::stringstream &ss) const override;
@@ -284,7 +295,7 @@ public:
 class AndInsn final : public ArithmeticInsn {
 public:
     AndInsn(DataType resultType, Instruction *input1, Instruction *input2)
-        : ArithmeticInsn(Opcode::ADD, resultType, input1, input2)
+        : ArithmeticInsn(Opcode::AND, resultType, input1, input2)
     {
     }
 };
@@ -331,7 +342,7 @@ public:
 
 class JmpInsn final : public Instruction {
 public:
-    JmpInsn(BasicBlock *bbToJmp) : Instruction(Opcode::JMP, DataType::VOID), bbToJmp_(bbToJmp) {}
+    explicit JmpInsn(BasicBlock *bbToJmp) : Instruction(Opcode::JMP, DataType::VOID), bbToJmp_(bbToJmp) {}
 
     BasicBlock *GetBBToJmp() const
     {
@@ -344,18 +355,14 @@ private:
     BasicBlock *bbToJmp_ {nullptr};
 };
 
-class BranchInsn : public Instruction {
+// All conditional branches compare two values.
+class BranchInsn : public FixedInputsInstruction<GetOpcodeInputsCount(Opcode::BEQ)> {
 public:
     BranchInsn(Opcode opcode, Instruction *input1, Instruction *input2, BasicBlock *ifTrueBB, BasicBlock *ifFalseBB)
-        : Instruction(opcode, DataType::VOID), ifTrueBB_(ifTrueBB), ifFalseBB_(ifFalseBB)
+        : FixedInputsInstruction(opcode, DataType::VOID), ifTrueBB_(ifTrueBB), ifFalseBB_(ifFalseBB)
     {
-        GetInputs()->SetInput(input1, 0);
-        GetInputs()->SetInput(input2, 1);
-        input1->AddUser(this);
-        if (input1 == input2) {
-            return;
-        }
-        input2->AddUser(this);
+        SetInput(input1, 0);
+        SetInput(input2, 1);
     }
 
     BasicBlock *GetTrueBranchBB() const
@@ -399,40 +406,58 @@ public:
     }
 };
 
-class RetInsn final : public Instruction {
+// The input of void return stays empty.
+class RetInsn final : public FixedInputsInstruction<GetOpcodeInputsCount(Opcode::RET)> {
 public:
-    RetInsn() : Instruction(Opcode::RET, DataType::VOID) {}
+    RetInsn() : FixedInputsInstruction(Opcode::RET, DataType::VOID) {}
 
-    RetInsn(DataType retType, Instruction *input) : Instruction(Opcode::RET, retType), retValue_(input)
+    RetInsn(DataType retType, Instruction *input) : FixedInputsInstruction(Opcode::RET, retType)
     {
         assert(retType != DataType::VOID);
         assert(input != nullptr);
 
-        GetInputs()->SetInput(input, 0);
-        input->AddUser(this);
+        SetInput(input, 0);
     }
 
     void Dump(std::stringstream &ss) const override;
-
-private:
-    Instruction *retValue_ {nullptr};
 };
 
-class CallStaticInsn final : public Instruction {
+class CallStaticInsn final : public DynamicInputsInstruction<4U> {
 public:
-    CallStaticInsn(DataType retType, size_t methodId, std::initializer_list<std::pair<Instruction *, DataType>> inputs)
-        : Instruction(Opcode::CALLSTATIC, retType), arguments_(std::move(inputs)), methodId_(methodId)
-    {
-        for (auto &argPair : arguments_) {
-            auto *input = argPair.first;
-            GetInputs()->AppendInput(input);
-            input->AddUser(this);
+    CallStaticInsn(utils::ArenaAllocator *allocator, DataType retType, size_t methodId,
+                   std::initializer_list<std::pair<Instruction *, DataType>> arguments)
+        : DynamicInputsInstruction(allocator, Opcode::CALLSTATIC, retType),
+          argumentTypes_(allocator->Adapter<DataType>()),
+          methodId_(methodId)
+    {
+        ReserveInputs(arguments.size());
+        argumentTypes_.reserve(arguments.size());
+        for (auto &[argument, type] : arguments) {
+            AppendInput(argument);
+            argumentTypes_.push_back(type);
         }
     }
 
-    const std::initializer_list<std::pair<Instruction *, DataType>> &GetArgument() const
+    Instruction *GetArgument(size_t idx)
+    {
+        return GetInput(idx);
+    }
+
+    const Instruction *GetArgument(size_t idx) const
+    {
+        return GetInput(idx);
+    }
+
+    DataType GetArgumentType(size_t idx) const
     {
-        return arguments_;
+        assert(idx < argumentTypes_.size());
+        return argumentTypes_[idx];
+    }
+
+    void AppendArgument(Instruction *argument, DataType type)
+    {
+        AppendInput(argument);
+        argumentTypes_.push_back(type);
     }
 
     size_t GetMethodId() const
@@ -443,90 +468,74 @@ public:
     void Dump(std::stringstream &ss) const override;
 
 private:
-    std::initializer_list<std::pair<Instruction *, DataType>> arguments_;
+    utils::ArenaVector<DataType> argumentTypes_;
     size_t methodId_ {0};
 };
 
-class NullCheckInsn final : public Instruction {
+class NullCheckInsn final : public FixedInputsInstruction<GetOpcodeInputsCount(Opcode::NULLCHECK)> {
 public:
-    NullCheckInsn(Instruction *insn) : Instruction(Opcode::NULLCHECK, DataType::REF), objectValueToCheck_(insn)
+    explicit NullCheckInsn(Instruction *insn) : FixedInputsInstruction(Opcode::NULLCHECK, DataType::REF)
     {
-        GetInputs()->SetInput(insn, 0);
-        insn->AddUser(this);
+        SetInput(insn, 0);
     }
 
     Instruction *GetInsnToCheck()
     {
-        return objectValueToCheck_;
+        return GetInput(0);
     }
 
     const Instruction *GetInsnToCheck() const
     {
-        return objectValueToCheck_;
+        return GetInput(0);
     }
 
     void Dump(std::stringstream &ss) const override;
-
-private:
-    Instruction *objectValueToCheck_ {nullptr};
 };
 
-class BoundsCheckInsn final : public Instruction {
+class BoundsCheckInsn final : public FixedInputsInstruction<GetOpcodeInputsCount(Opcode::BOUNDSCHECK)> {
 public:
     BoundsCheckInsn(Instruction *insn, Instruction *idxToCheck, Instruction *maxArrIdx)
-        : Instruction(Opcode::BOUNDSCHECK, DataType::U32),
-          objectValueToCheck_(insn),
-          idxToCheck_(idxToCheck),
-          maxArrIdx_(maxArrIdx)
+        : FixedInputsInstruction(Opcode::BOUNDSCHECK, DataType::U32)
     {
-        GetInputs()->AppendInput(insn);
-        GetInputs()->AppendInput(idxToCheck);
-        GetInputs()->AppendInput(maxArrIdx);
+        SetInput(insn, 0);
+        SetInput(idxToCheck, 1);
+        SetInput(maxArrIdx, 2);
 
         assert(insn != idxToCheck);
         assert(idxToCheck != maxArrIdx);
-        insn->AddUser(this);
-        idxToCheck->AddUser(this);
-        maxArrIdx->AddUser(this);
     }
 
     Instruction *GetInsnToCheck()
     {
-        return objectValueToCheck_;
+        return GetInput(0);
     }
 
     const Instruction *GetInsnToCheck() const
     {
-        return objectValueToCheck_;
+        return GetInput(0);
     }
 
-    Instruction *GetMaxArrayIdx()
+    Instruction *GetIdxToCheck()
     {
-        return maxArrIdx_;
+        return GetInput(1);
     }
 
-    const Instruction *GetMaxArrayIdx() const
+    const Instruction *GetIdxToCheck() const
     {
-        return maxArrIdx_;
+        return GetInput(1);
     }
 
-    Instruction *GetIdxToCheck()
+    Instruction *GetMaxArrayIdx()
     {
-        return maxArrIdx_;
+        return GetInput(2);
     }
 
-    const Instruction *GetIdxToCheck() const
+    const Instruction *GetMaxArrayIdx() const
     {
-        return maxArrIdx_;
+        return GetInput(2);
     }
 
     void Dump(std::stringstream &ss) const override;
-
-private:
-    Instruction *objectValueToCheck_ {nullptr};
-
-    Instruction *idxToCheck_ {nullptr};
-    Instruction *maxArrIdx_ {nullptr};
 };
 
 class NewArrInsn final : public Instruction {
@@ -536,53 +545,49 @@ public:
     {
     }
 
+    DataType GetElemType() const
+    {
+        return elemtype_;
+    }
+
+    size_t GetLength() const
+    {
+        return length_;
+    }
+
 private:
     DataType elemtype_;
     size_t length_ {0};
 };
 
-class LoadArrayInsn final : public Instruction {
+class LoadArrayInsn final : public FixedInputsInstruction<GetOpcodeInputsCount(Opcode::LOADARRAY)> {
 public:
     LoadArrayInsn(DataType elemType, Instruction *arrayRef, Instruction *idx)
-        : Instruction(Opcode::LOADARRAY, elemType), arrayRef_(arrayRef), loadIdx_(idx)
+        : FixedInputsInstruction(Opcode::LOADARRAY, elemType)
     {
-        GetInputs()->SetInput(arrayRef, 0);
-        GetInputs()->SetInput(idx, 1);
+        SetInput(arrayRef, 0);
+        SetInput(idx, 1);
 
         assert(arrayRef != idx);
-        arrayRef->AddUser(this);
-        idx->AddUser(this);
     }
 
     void Dump(std::stringstream &ss) const override;
-
-private:
-    Instruction *arrayRef_ {nullptr};
-    Instruction *loadIdx_ {nullptr};
 };
 
-class StoreArrayInsn final : public Instruction {
+class StoreArrayInsn final : public FixedInputsInstruction<GetOpcodeInputsCount(Opcode::STOREARRAY)> {
 public:
     StoreArrayInsn(DataType elemType, Instruction *arrayRef, Instruction *idx, Instruction *value)
-        : Instruction(Opcode::STOREARRAY, elemType), arrayRef_(arrayRef), storeIdx_(idx), storeValue_(value)
+        : FixedInputsInstruction(Opcode::STOREARRAY, elemType)
     {
-        GetInputs()->AppendInput(arrayRef);
-        GetInputs()->AppendInput(idx);
-        GetInputs()->AppendInput(value);
+        SetInput(arrayRef, 0);
+        SetInput(idx, 1);
+        SetInput(value, 2);
 
         assert(arrayRef != idx);
         assert(idx != value);
-        arrayRef->AddUser(this);
-        idx->AddUser(this);
-        value->AddUser(this);
     }
 
     void Dump(std::stringstream &ss) const override;
-
-private:
-    Instruction *arrayRef_ {nullptr};
-    Instruction *storeIdx_ {nullptr};
-    Instruction *storeValue_ {nullptr};
 };
 
 }  // namespace compiler
@@ -10,9 +10,7 @@ namespace compiler {
 template <typename InsnT, typename... ArgsT>
 inline Instruction *IrBuilder::CreateInstruction(ArgsT &&...args)
 {
-    auto insn = std::make_unique<InsnT>(std::forward<ArgsT>(args)...);
-    Instruction *insnPtr = insn.get();
-    graph_->AddInstruction(std::move(insn));
+    Instruction *insnPtr = graph_->CreateInsn<InsnT>(std::forward<ArgsT>(args)...);
 
     insnPtr->SetParentBB(currentBB_);
     currentBB_->PushInstruction(insnPtr);
@@ -96,6 +94,11 @@ inline Instruction *IrBuilder::CreateDivInsn(DataType resultType, Instruction *i
     return CreateInstruction<DivInsn>(resultType, input1, input2);
 }
 
+inline Instruction *IrBuilder::CreateAndInsn(DataType resultType, Instruction *input1, Instruction *input2)
+{
+    return CreateInstruction<AndInsn>(resultType, input1, input2);
+}
+
 inline Instruction *IrBuilder::CreateOrInsn(DataType resultType, Instruction *input1, Instruction *input2)
 {
     return CreateInstruction<OrInsn>(resultType, input1, input2);
@@ -154,6 +157,12 @@ inline Instruction *IrBuilder::CreateRetInsn(DataType retType, Instruction *inpu
     return CreateInstruction<RetInsn>(retType, input);
 }
 
+inline Instruction *IrBuilder::CreateCallStaticInsn(
+    DataType retType, size_t methodId, std::initializer_list<std::pair<Instruction *, DataType>> arguments)
+{
+    return CreateInstruction<CallStaticInsn>(retType, methodId, arguments);
+}
+
 inline Instruction *IrBuilder::CreateNullcheckInsn(Instruction *input)
 {
     return CreateInstruction<NullCheckInsn>(input);
@@ -165,6 +174,11 @@ inline Instruction *IrBuilder::CreateBoundsCheckInsn(Instruction *input, Instruc
     return CreateInstruction<BoundsCheckInsn>(input, idxToCheck, maxArrIdx);
 }
 
+inline Instruction *IrBuilder::CreateNewArrInsn(DataType elemType, size_t length)
+{
+    return CreateInstruction<NewArrInsn>(elemType, length);
+}
+
 inline Instruction *IrBuilder::CreateLoadArrayInsn(DataType arrType, Instruction *arrayRef, Instruction *idx)
 {
     return CreateInstruction<LoadArrayInsn>(arrType, arrayRef, idx);
@@ -176,6 +190,31 @@ inline Instruction *IrBuilder::CreateStoreArrayInsn(DataType arrType, Instructio
     return CreateInstruction<StoreArrayInsn>(arrType, arrayRef, idx, storeValue);
 }
 
+inline VariableId IrBuilder::CreateVariable(DataType type)
+{
+    return ssaBuilder_.CreateVariable(type);
+}
+
+inline void IrBuilder::WriteVariable(VariableId var, Instruction *value)
+{
+    ssaBuilder_.WriteVariable(var, currentBB_, value);
+}
+
+inline Instruction *IrBuilder::ReadVariable(VariableId var)
+{
+    return ssaBuilder_.ReadVariable(var, currentBB_);
+}
+
+inline void IrBuilder::SealBlock(BasicBlock *block)
+{
+    ssaBuilder_.SealBlock(block);
+}
+
+inline void IrBuilder::SealAllBlocks()
+{
+    ssaBuilder_.SealAllBlocks();
+}
+
 }  // namespace compiler
 
 #endif  // IR_IR_BUILDER_INL_H
@@ -6,10 +6,12 @@
 #include "ir/basic_block.h"
 #include "ir/instructions.h"
 #include "ir/graph.h"
+#include "ir/ssa_builder.h"
 
+#include <initializer_list>
 #include <string>
+#include <utility>
 #include <vector>
-#include <memory>
 
 namespace compiler {
 
@@ -18,15 +20,12 @@ public:
     NO_COPY_SEMANTIC(IrBuilder);
     NO_MOVE_SEMANTIC(IrBuilder);
 
-    IrBuilder(Graph *graph) : graph_(graph) {}
+    IrBuilder(Graph *graph) : graph_(graph), ssaBuilder_(graph) {}
     ~IrBuilder() = default;
 
     BasicBlock *CreateBB()
     {
-        auto bb = std::make_unique<BasicBlock>();
-        auto bbPtr = bb.get();
-        graph_->AddBlock(std::move(bb));
-        return bbPtr;
+        return graph_->CreateNewBlock();
     }
 
     void SetBasicBlockScope(BasicBlock *currentBB)
@@ -54,6 +53,7 @@ public:
     Instruction *CreateDivInsn(DataType resultType, Instruction *input1, Instruction *input2);
     Instruction *CreateRemInsn(DataType resultType, Instruction *input1, Instruction *input2);
 
+    Instruction *CreateAndInsn(DataType resultType, Instruction *input1, Instruction *input2);
     Instruction *CreateOrInsn(DataType resultType, Instruction *input1, Instruction *input2);
     Instruction *CreateXorInsn(DataType resultType, Instruction *input1, Instruction *input2);
     Instruction *CreateAshrInsn(DataType resultType, Instruction *input1, Instruction *input2);
@@ -67,15 +67,28 @@ public:
 
     Instruction *CreateRetInsn(DataType retType, Instruction *input);
 
+    Instruction *CreateCallStaticInsn(DataType retType, size_t methodId,
+                                      std::initializer_list<std::pair<Instruction *, DataType>> arguments);
+
     Instruction *CreateBoundsCheckInsn(Instruction *input, Instruction *idxToCheck, Instruction *maxArrIdx);
     Instruction *CreateNullcheckInsn(Instruction *input);
 
+    Instruction *CreateNewArrInsn(DataType elemType, size_t length);
     Instruction *CreateLoadArrayInsn(DataType arrType, Instruction *arrayRef, Instruction *idx);
     Instruction *CreateStoreArrayInsn(DataType arrType, Instruction *arrayRef, Instruction *idx,
                                       Instruction *storeValue);
 
+    // Alternative to manual phis: values are read and written through variables in the current block,
+    // phis are placed by SsaBuilder. Each block must be sealed once all its predecessors are created.
+    VariableId CreateVariable(DataType type);
+    void WriteVariable(VariableId var, Instruction *value);
+    Instruction *ReadVariable(VariableId var);
+    void SealBlock(BasicBlock *block);
+    void SealAllBlocks();
+
 private:
     Graph *graph_ {nullptr};
+    SsaBuilder ssaBuilder_;
 
     BasicBlock *currentBB_ {nullptr};
 };
@@ -3,31 +3,82 @@
 
 #include "utils/macros.h"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <bitset>
-#include <iostream>
+#include <memory>
+#include <vector>
 
 namespace compiler {
 
-using Marker = uint32_t;
+// Kinds of IR objects which could be marked, every kind has its own id space.
+enum class MarkedKind : uint8_t { BLOCK, INSN, COUNT };
 
-// Marker structure:
-//
-// | unique       |         |
-// | marker index |  color  |
-// |______________|_________|
-//     30 bits      2 bits
+// Stamps of one marker slot, indexed by the id of the marked object.
+// An object is marked when its stamp equals the epoch of the marker which currently owns the slot,
+// so a slot is handed to a new marker without clearing.
+struct MarkerSlot final {
+    std::array<std::vector<uint32_t>, static_cast<size_t>(MarkedKind::COUNT)> stamps;
+};
 
-class MarkerManager final {
+// Handle of a live marker.
+class Marker final {
 public:
-    static constexpr uint32_t COLOR_BITS = 2;
-    static constexpr uint32_t MARKER_INDEX_BITS = 30;
-    static constexpr uint32_t COLORS_NUM = 1 << COLOR_BITS;
-    static constexpr uint32_t MARKER_SHIFT = COLOR_BITS;
-    static constexpr uint32_t COLOR_MASK = (1 << MARKER_SHIFT) - 1;
-    static constexpr uint32_t MAX_MARKER_INDEX = (1 << (MARKER_INDEX_BITS - COLOR_BITS)) - 1;
-    static constexpr uint32_t UNMARKER = 0;
+    Marker() = default;
+    Marker(MarkerSlot *slot, uint32_t epoch) : slot_(slot), epoch_(epoch) {}
+
+    template <MarkedKind KIND>
+    void Set(size_t id) const
+    {
+        auto &stamps = GetStamps<KIND>();
+        if (UNLIKELY(id >= stamps.size())) {
+            stamps.resize(id + 1);
+        }
+        stamps[id] = epoch_;
+    }
+
+    template <MarkedKind KIND>
+    void Reset(size_t id) const
+    {
+        auto &stamps = GetStamps<KIND>();
+        if (id < stamps.size()) {
+            stamps[id] = 0;
+        }
+    }
+
+    template <MarkedKind KIND>
+    bool Check(size_t id) const
+    {
+        const auto &stamps = GetStamps<KIND>();
+        return id < stamps.size() && stamps[id] == epoch_;
+    }
+
+    MarkerSlot *GetSlot() const
+    {
+        return slot_;
+    }
+
+    bool IsValid() const
+    {
+        return slot_ != nullptr;
+    }
 
+private:
+    template <MarkedKind KIND>
+    std::vector<uint32_t> &GetStamps() const
+    {
+        assert(IsValid());
+        return slot_->stamps[static_cast<size_t>(KIND)];
+    }
+
+private:
+    MarkerSlot *slot_ {nullptr};
+    uint32_t epoch_ {0};
+};
+
+// Any number of markers can be alive at the same time.
+// Erased markers return their slots for reuse, so the memory is bounded by the maximum number of live markers.
+class MarkerManager final {
 public:
     NO_COPY_SEMANTIC(MarkerManager);
     NO_MOVE_SEMANTIC(MarkerManager);
@@ -35,33 +86,51 @@ public:
     MarkerManager() = default;
     ~MarkerManager() = default;
 
-    // Create new marker.
-    // Only 4 markers are available at one moment.
     Marker CreateNewMarker()
     {
-        ++markerIndex_;
-        assert(markerIndex_ < MAX_MARKER_INDEX);
-
-        for (size_t idx = 0; idx < COLORS_NUM; ++idx) {
-            if (!colors_[idx]) {
-                Marker marker = (markerIndex_ << COLOR_BITS) | idx;
-                colors_[idx] = 1;
-                return marker;
-            }
+        ++epoch_;
+        if (UNLIKELY(epoch_ == 0)) {
+            ResetEpoch();
         }
 
-        std::cerr << "No free markers are available" << std::endl;
-        UNREACHABLE();
+        MarkerSlot *slot = nullptr;
+        if (freeSlots_.empty()) {
+            slot = slots_.emplace_back(std::make_unique<MarkerSlot>()).get();
+        } else {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+        return Marker(slot, epoch_);
     }
 
     void EraseMarker(Marker marker)
     {
-        colors_[marker & COLOR_MASK] = 0;
+        assert(marker.IsValid());
+        freeSlots_.push_back(marker.GetSlot());
+    }
+
+    size_t GetLiveMarkersCount() const
+    {
+        return slots_.size() - freeSlots_.size();
+    }
+
+private:
+    // Stale stamps of the previous epochs would match again after the counter wraps around.
+    void ResetEpoch()
+    {
+        assert(GetLiveMarkersCount() == 0);
+        for (auto &slot : slots_) {
+            for (auto &stamps : slot->stamps) {
+                stamps.clear();
+            }
+        }
+        epoch_ = 1;
     }
 
 private:
-    size_t markerIndex_ {0};
-    std::bitset<COLORS_NUM> colors_;
+    uint32_t epoch_ {0};
+    std::vector<std::unique_ptr<MarkerSlot>> slots_;
+    std::vector<MarkerSlot *> freeSlots_;
 };
 
 }  // namespace compiler
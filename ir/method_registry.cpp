@@ -0,0 +1,18 @@
+#include "ir/method_registry.h"
+#include "ir/graph.h"
+
+namespace compiler {
+
+void MethodRegistry::Register(Graph *graph)
+{
+    graphs_[graph->GetMethodId()] = graph;
+    graph->SetMethodRegistry(this);
+}
+
+Graph *MethodRegistry::GetGraph(size_t methodId) const
+{
+    auto it = graphs_.find(methodId);
+    return it == graphs_.end() ? nullptr : it->second;
+}
+
+}  // namespace compiler
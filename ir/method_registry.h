@@ -0,0 +1,34 @@
+#ifndef IR_METHOD_REGISTRY_H
+#define IR_METHOD_REGISTRY_H
+
+#include "utils/macros.h"
+
+#include <cstddef>
+#include <unordered_map>
+
+namespace compiler {
+
+class Graph;
+
+// Graphs of the methods known to the compiler, callees of CallStatic are looked up here by method id.
+class MethodRegistry final {
+public:
+    NO_COPY_SEMANTIC(MethodRegistry);
+    NO_MOVE_SEMANTIC(MethodRegistry);
+
+    MethodRegistry() = default;
+    ~MethodRegistry() = default;
+
+    // The graph gets access to the registry, so that its passes may look up callees.
+    void Register(Graph *graph);
+
+    // Nullptr for methods which are not registered.
+    Graph *GetGraph(size_t methodId) const;
+
+private:
+    std::unordered_map<size_t, Graph *> graphs_;
+};
+
+}  // namespace compiler
+
+#endif  // IR_METHOD_REGISTRY_H
@@ -1,16 +1,39 @@
 #ifndef IR_OPCODES_H
 #define IR_OPCODES_H
 
+#include <array>
 #include <cstddef>
+#include <limits>
 
 namespace compiler {
 
 enum Opcode : size_t {
-#define OPCODE_MACROS(instr, _) instr,
+#define OPCODE_MACROS(instr, instrType, inputsCount) instr,
 #include "ir/instruction_type.def"
 #undef OPCODE_MACROS
 };
 
+/// Number of opcodes declared in instruction_type.def.
+static constexpr size_t OPCODES_COUNT = std::array {
+#define OPCODE_MACROS(instr, instrType, inputsCount) Opcode::instr,
+#include "ir/instruction_type.def"
+#undef OPCODE_MACROS
+}.size();
+
+/// Inputs count of the opcodes which take an arbitrary number of inputs.
+static constexpr size_t DYNAMIC_INPUTS = std::numeric_limits<size_t>::max();
+
+/// Number of inputs taken by the opcode, as declared in instruction_type.def.
+constexpr size_t GetOpcodeInputsCount(Opcode opcode)
+{
+    constexpr std::array INPUTS_COUNT {
+#define OPCODE_MACROS(instr, instrType, inputsCount) static_cast<size_t>(inputsCount),
+#include "ir/instruction_type.def"
+#undef OPCODE_MACROS
+    };
+    return INPUTS_COUNT[opcode];
+}
+
 }  // namespace compiler
 
 #endif  // IR_OPCODES_H
@@ -0,0 +1,76 @@
+#ifndef IR_SIDE_TABLE_H
+#define IR_SIDE_TABLE_H
+
+#include "utils/macros.h"
+#include "ir/basic_block.h"
+#include "ir/graph.h"
+#include "ir/instruction.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace compiler {
+
+// Per-object data of an analysis in a flat array indexed by ids of blocks or instructions.
+// Objects created after the table get the default value on the first access.
+// Tables must be rebuilt after Graph::RenumberIds.
+template <typename KeyT, typename T>
+class SideTable final {
+    static_assert(std::is_same_v<KeyT, BasicBlock> || std::is_same_v<KeyT, Instruction>);
+
+public:
+    DEFAULT_COPY_SEMANTIC(SideTable);
+    DEFAULT_MOVE_SEMANTIC(SideTable);
+
+    SideTable() = default;
+    explicit SideTable(const Graph *graph, const T &defaultValue = T())
+        : table_(GetIdBound(graph), defaultValue), defaultValue_(defaultValue)
+    {
+    }
+    ~SideTable() = default;
+
+    T &operator[](const KeyT *key)
+    {
+        auto id = key->GetId();
+        if (UNLIKELY(id >= table_.size())) {
+            table_.resize(id + 1, defaultValue_);
+        }
+        return table_[id];
+    }
+
+    const T &operator[](const KeyT *key) const
+    {
+        assert(key->GetId() < table_.size());
+        return table_[key->GetId()];
+    }
+
+    size_t size() const
+    {
+        return table_.size();
+    }
+
+private:
+    static size_t GetIdBound(const Graph *graph)
+    {
+        if constexpr (std::is_same_v<KeyT, BasicBlock>) {
+            return graph->GetBlocks().size();
+        } else {
+            return graph->GetInstructions().size();
+        }
+    }
+
+private:
+    std::vector<T> table_;
+    T defaultValue_ {};
+};
+
+template <typename T>
+using BlockSideTable = SideTable<BasicBlock, T>;
+
+template <typename T>
+using InsnSideTable = SideTable<Instruction, T>;
+
+}  // namespace compiler
+
+#endif  // IR_SIDE_TABLE_H
@@ -0,0 +1,213 @@
+#include "ir/ssa_builder.h"
+
+namespace compiler {
+
+Instruction *SsaBuilder::ReadVariable(VariableId var, BasicBlock *block)
+{
+    assert(var < defs_.size());
+    assert(tasks_.empty() && results_.empty());
+
+    tasks_.push_back({block, nullptr});
+    RunTasks(var);
+
+    assert(results_.size() == 1);
+    auto *value = Resolve(results_.back());
+    results_.clear();
+    return value;
+}
+
+void SsaBuilder::SealBlock(BasicBlock *block)
+{
+    assert(!IsSealed(block));
+    assert(tasks_.empty() && results_.empty());
+
+    auto incompletePhis = std::move(blocks_[block].incompletePhis);
+    blocks_[block].incompletePhis.clear();
+    blocks_[block].sealed = true;
+
+    for (auto [var, phi] : incompletePhis) {
+        AddPhiInputs(phi);
+        RunTasks(var);
+        assert(results_.size() == 1);
+        results_.clear();
+    }
+}
+
+void SsaBuilder::SealAllBlocks()
+{
+    for (auto *block : graph_->GetBlocks()) {
+        if (!IsSealed(block)) {
+            SealBlock(block);
+        }
+    }
+}
+
+Instruction *SsaBuilder::GetUndefined()
+{
+    if (undefined_ == nullptr) {
+        undefined_ = graph_->CreateInsn<UndefinedInsn>();
+        graph_->GetStartBlock()->InsertInstruction(nullptr, undefined_);
+    }
+    return undefined_;
+}
+
+// Phis go before other instructions of the block, after the phis which are already there.
+PhiInsn *SsaBuilder::CreatePhi(VariableId var, BasicBlock *block)
+{
+    auto *phi = graph_->CreateInsn<PhiInsn>(types_[var]);
+
+    Instruction *lastPhi = nullptr;
+    for (auto *insn = block->GetFirstInsn(); insn != nullptr && insn->IsPhi(); insn = insn->GetNext()) {
+        lastPhi = insn;
+    }
+    block->InsertInstruction(lastPhi, phi);
+
+    phis_[phi].pending = true;
+    return phi;
+}
+
+void SsaBuilder::RunTasks(VariableId var)
+{
+    while (!tasks_.empty()) {
+        auto task = tasks_.back();
+        tasks_.pop_back();
+
+        if (task.phi == nullptr) {
+            Lookup(var, task.block);
+            continue;
+        }
+
+        auto *phi = task.phi;
+        const auto &preds = phi->GetParentBB()->GetPredecessors();
+        assert(results_.size() >= preds.size());
+
+        auto base = results_.size() - preds.size();
+        phi->ReserveInputs(preds.size());
+        for (size_t idx = 0; idx < preds.size(); ++idx) {
+            phi->ResolveDependency(Resolve(results_[base + idx]), preds[idx]);
+        }
+        results_.resize(base);
+
+        phis_[phi].pending = false;
+        results_.push_back(TryRemoveTrivialPhi(phi));
+    }
+}
+
+// Walks up through blocks with a single predecessor until the definition is found or a phi is needed.
+// Definition is recorded in all walked blocks, so the next lookup from any of them is immediate.
+void SsaBuilder::Lookup(VariableId var, BasicBlock *block)
+{
+    auto &defs = defs_[var];
+    chain_.clear();
+
+    Instruction *value = nullptr;
+    auto *bb = block;
+    for (size_t steps = 0;; ++steps) {
+        if (auto *def = defs[bb]; def != nullptr) {
+            value = Resolve(def);
+            break;
+        }
+        chain_.push_back(bb);
+
+        if (!blocks_[bb].sealed) {
+            auto *phi = CreatePhi(var, bb);
+            blocks_[bb].incompletePhis.emplace_back(var, phi);
+            value = phi;
+            break;
+        }
+
+        const auto &preds = bb->GetPredecessors();
+        // A cycle of blocks with single predecessors is unreachable, the bound on the walk keeps it finite.
+        if (preds.empty() || steps > graph_->GetBlocks().size()) {
+            value = GetUndefined();
+            break;
+        }
+        if (preds.size() == 1) {
+            bb = preds.front();
+            continue;
+        }
+
+        // The phi is recorded as the definition before the lookups in predecessors to break cycles through loops.
+        auto *phi = CreatePhi(var, bb);
+        for (auto *chainBB : chain_) {
+            defs[chainBB] = phi;
+        }
+        AddPhiInputs(phi);
+        return;
+    }
+
+    for (auto *chainBB : chain_) {
+        defs[chainBB] = value;
+    }
+    results_.push_back(value);
+}
+
+// Schedules lookups in all predecessors followed by the task which resolves the phi with their results.
+void SsaBuilder::AddPhiInputs(PhiInsn *phi)
+{
+    tasks_.push_back({nullptr, phi});
+
+    const auto &preds = phi->GetParentBB()->GetPredecessors();
+    for (auto it = preds.rbegin(); it != preds.rend(); ++it) {
+        tasks_.push_back({*it, nullptr});
+    }
+}
+
+// Returns the only value merged by the phi apart from the phi itself, or nullptr if there are several.
+Instruction *SsaBuilder::GetTrivialPhiValue(PhiInsn *phi)
+{
+    Instruction *same = nullptr;
+    for (const auto &input : phi->GetInputs()) {
+        auto *value = input.GetValue();
+        if (value == same || value == phi) {
+            continue;
+        }
+        if (same != nullptr) {
+            return nullptr;
+        }
+        same = value;
+    }
+    // The phi is unreachable or merges only itself.
+    return same == nullptr ? GetUndefined() : same;
+}
+
+// Removing a phi may make trivial the phis which use it, they are checked with a worklist.
+Instruction *SsaBuilder::TryRemoveTrivialPhi(PhiInsn *phi)
+{
+    assert(worklist_.empty());
+    worklist_.push_back(phi);
+
+    while (!worklist_.empty()) {
+        auto *candidate = worklist_.back();
+        worklist_.pop_back();
+
+        if (phis_[candidate].replacement != nullptr || phis_[candidate].pending) {
+            continue;
+        }
+        auto *same = GetTrivialPhiValue(candidate);
+        if (same == nullptr) {
+            continue;
+        }
+
+        for (auto *user : candidate->GetUsers()) {
+            if (user->IsPhi() && user != candidate) {
+                worklist_.push_back(static_cast<PhiInsn *>(user));
+            }
+        }
+        candidate->GetParentBB()->Remove(candidate);
+        candidate->ReplaceInputsForUsers(same);
+        phis_[candidate].replacement = same;
+    }
+
+    return Resolve(phi);
+}
+
+Instruction *SsaBuilder::Resolve(Instruction *value)
+{
+    while (value->IsPhi() && phis_[value].replacement != nullptr) {
+        value = phis_[value].replacement;
+    }
+    return value;
+}
+
+}  // namespace compiler
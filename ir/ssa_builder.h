@@ -0,0 +1,110 @@
+#ifndef IR_SSA_BUILDER_H
+#define IR_SSA_BUILDER_H
+
+#include "utils/macros.h"
+#include "ir/basic_block.h"
+#include "ir/data_types.h"
+#include "ir/graph.h"
+#include "ir/instruction.h"
+#include "ir/instructions.h"
+#include "ir/side_table.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace compiler {
+
+using VariableId = uint32_t;
+
+// On-the-fly SSA construction from variables (Braun et al., "Simple and Efficient Construction of SSA Form").
+// Front-end writes and reads variables block by block, phis are created only where a read needs them
+// and trivial phis (all inputs are the same value or the phi itself) are removed at once.
+//
+// A block must be sealed when all its predecessors are known. Reads in an unsealed block create incomplete phis,
+// which get their inputs on sealing. Lookups are iterative, so long chains of blocks don't exhaust the stack.
+class SsaBuilder final {
+public:
+    NO_COPY_SEMANTIC(SsaBuilder);
+    NO_MOVE_SEMANTIC(SsaBuilder);
+
+    explicit SsaBuilder(Graph *graph) : graph_(graph) {}
+    ~SsaBuilder() = default;
+
+    VariableId CreateVariable(DataType type)
+    {
+        types_.push_back(type);
+        defs_.emplace_back();
+        return static_cast<VariableId>(types_.size() - 1);
+    }
+
+    void WriteVariable(VariableId var, BasicBlock *block, Instruction *value)
+    {
+        assert(var < defs_.size());
+        assert(value != nullptr);
+        defs_[var][block] = value;
+    }
+
+    Instruction *ReadVariable(VariableId var, BasicBlock *block);
+
+    void SealBlock(BasicBlock *block);
+    void SealAllBlocks();
+
+    bool IsSealed(const BasicBlock *block) const
+    {
+        return block->GetId() < blocks_.size() && blocks_[block].sealed;
+    }
+
+    // Value read from a variable which is not written on some path to the read.
+    Instruction *GetUndefined();
+
+private:
+    struct BlockInfo {
+        bool sealed {false};
+        std::vector<std::pair<VariableId, PhiInsn *>> incompletePhis;
+    };
+
+    struct PhiInfo {
+        // Value which replaced the removed phi, reads of stale definitions are forwarded to it.
+        Instruction *replacement {nullptr};
+        // Phi is waiting for its inputs and must not be removed yet.
+        bool pending {false};
+    };
+
+    // Lookup of the variable starting at `block` pushes exactly one value to `results_`,
+    // either right away or by the task which finishes a phi with the values of the predecessors.
+    struct Task {
+        BasicBlock *block {nullptr};
+        PhiInsn *phi {nullptr};
+    };
+
+    PhiInsn *CreatePhi(VariableId var, BasicBlock *block);
+    void RunTasks(VariableId var);
+    void Lookup(VariableId var, BasicBlock *block);
+    void AddPhiInputs(PhiInsn *phi);
+    Instruction *GetTrivialPhiValue(PhiInsn *phi);
+    Instruction *TryRemoveTrivialPhi(PhiInsn *phi);
+    Instruction *Resolve(Instruction *value);
+
+private:
+    Graph *graph_ {nullptr};
+
+    std::vector<DataType> types_;
+    // Definitions of each variable at the end of blocks, may refer to removed phis.
+    std::vector<BlockSideTable<Instruction *>> defs_;
+
+    BlockSideTable<BlockInfo> blocks_;
+    InsnSideTable<PhiInfo> phis_;
+
+    Instruction *undefined_ {nullptr};
+
+    std::vector<Task> tasks_;
+    std::vector<Instruction *> results_;
+    std::vector<BasicBlock *> chain_;
+    std::vector<PhiInsn *> worklist_;
+};
+
+}  // namespace compiler
+
+#endif  // IR_SSA_BUILDER_H
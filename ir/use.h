@@ -0,0 +1,241 @@
+#ifndef IR_USE_H
+#define IR_USE_H
+
+#include "utils/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace compiler {
+
+class Instruction;
+class UseList;
+
+// Operand slot of an instruction.
+// Every slot is a node of the intrusive list of uses of the instruction stored in it,
+// so a def-use edge costs no extra allocation and is added/removed in O(1).
+class Use final {
+public:
+    NO_COPY_SEMANTIC(Use);
+
+    Use() = default;
+    Use(Instruction *user, uint32_t idx) : user_(user), idx_(idx) {}
+    ~Use() = default;
+
+    // Keeps the node linked when operand storage is relocated (e.g. vector growth).
+    Use(Use &&other) noexcept;
+    Use &operator=(Use &&other) = delete;
+
+    Instruction *GetValue() const
+    {
+        return value_;
+    }
+
+    /// Replace value stored in the slot, moving this use from the old value's list to the new one.
+    void SetValue(Instruction *value);
+
+    Instruction *GetUser() const
+    {
+        return user_;
+    }
+
+    uint32_t GetIndex() const
+    {
+        return idx_;
+    }
+
+    Use *GetNext() const
+    {
+        return next_;
+    }
+
+    Use *GetPrev() const
+    {
+        return prev_;
+    }
+
+private:
+    friend class UseList;
+
+    Instruction *value_ {nullptr};
+    Instruction *user_ {nullptr};
+    uint32_t idx_ {0};
+
+    Use *prev_ {nullptr};
+    Use *next_ {nullptr};
+};
+
+// Intrusive list of uses of a value.
+// Iteration yields user instructions, `GetFirst` gives access to the uses themselves.
+// A user occupies as many nodes as the number of its operands referring to the value.
+class UseList final {
+public:
+    NO_COPY_SEMANTIC(UseList);
+    NO_MOVE_SEMANTIC(UseList);
+
+    UseList() = default;
+    ~UseList() = default;
+
+    class Iterator final {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Instruction *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Instruction **;
+        using reference = Instruction *;
+
+        Iterator() = default;
+        Iterator(Use *use, const UseList *list) : use_(use), list_(list) {}
+
+        Instruction *operator*() const
+        {
+            return use_->GetUser();
+        }
+
+        Use *GetUse() const
+        {
+            return use_;
+        }
+
+        Iterator &operator++()
+        {
+            use_ = use_->GetNext();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        Iterator &operator--()
+        {
+            use_ = (use_ == nullptr) ? list_->last_ : use_->GetPrev();
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return use_ == other.use_;
+        }
+
+        bool operator!=(const Iterator &other) const
+        {
+            return use_ != other.use_;
+        }
+
+    private:
+        Use *use_ {nullptr};
+        const UseList *list_ {nullptr};
+    };
+
+    void PushBack(Use *use)
+    {
+        assert(use->prev_ == nullptr && use->next_ == nullptr);
+
+        use->prev_ = last_;
+        if (last_ != nullptr) {
+            last_->next_ = use;
+        } else {
+            first_ = use;
+        }
+        last_ = use;
+        ++size_;
+    }
+
+    void Remove(Use *use)
+    {
+        assert(size_ != 0);
+
+        if (use->prev_ != nullptr) {
+            use->prev_->next_ = use->next_;
+        } else {
+            first_ = use->next_;
+        }
+        if (use->next_ != nullptr) {
+            use->next_->prev_ = use->prev_;
+        } else {
+            last_ = use->prev_;
+        }
+
+        use->prev_ = nullptr;
+        use->next_ = nullptr;
+        --size_;
+    }
+
+    // `to` takes place of `from` in the list.
+    void Relink(Use *from, Use *to)
+    {
+        if (to->prev_ != nullptr) {
+            to->prev_->next_ = to;
+        } else if (first_ == from) {
+            first_ = to;
+        }
+        if (to->next_ != nullptr) {
+            to->next_->prev_ = to;
+        } else if (last_ == from) {
+            last_ = to;
+        }
+    }
+
+    Use *GetFirst() const
+    {
+        return first_;
+    }
+
+    Use *GetLast() const
+    {
+        return last_;
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(first_, this);
+    }
+
+    Iterator end() const
+    {
+        return Iterator(nullptr, this);
+    }
+
+    Instruction *front() const
+    {
+        assert(first_ != nullptr);
+        return first_->GetUser();
+    }
+
+    Instruction *back() const
+    {
+        assert(last_ != nullptr);
+        return last_->GetUser();
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+private:
+    Use *first_ {nullptr};
+    Use *last_ {nullptr};
+    size_t size_ {0};
+};
+
+}  // namespace compiler
+
+#endif  // IR_USE_H
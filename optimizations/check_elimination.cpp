@@ -1,17 +1,18 @@
-#include "analysis/dominator_tree.h"
 #include "ir/instruction.h"
 #include "ir/instructions.h"
 #include "optimizations/check_elimination.h"
-#include <unordered_map>
+#include "analysis/range_analysis.h"
 
 namespace compiler {
 
 void CheckElimination::Run()
 {
-    DominatorTree tree(graph_);
-    tree.Build();
+    graph_->GetAnalysisManager()->Run(AnalysisType::DOMINATOR_TREE);
 
     OptimizeDominatedChecks();
+    OptimizeChecksByRanges();
+
+    graph_->GetAnalysisManager()->Invalidate(PRESERVED_ANALYSES);
 }
 
 void CheckElimination::OptimizeDominatedChecks()
@@ -36,9 +37,10 @@ void CheckElimination::OptimizeDominatedChecks()
             // we will check all existing checks in the graph.
             Instruction *checkToRemain = nullptr;
 
-            for (auto userIt = currInsn->GetUsers().begin(); userIt != currInsn->GetUsers().end();) {
-                // Need to save iterator, because of removing user from list below.
-                auto currUser = *(userIt++);
+            for (auto *use = currInsn->GetUsers().GetFirst(); use != nullptr;) {
+                // Need to save next use, because of removing user from list below.
+                auto *currUser = use->GetUser();
+                use = use->GetNext();
 
                 bool isBoundCheck = currUser->GetOpcode() == Opcode::BOUNDSCHECK;
                 bool isNullCheck = currUser->GetOpcode() == Opcode::NULLCHECK;
@@ -63,4 +65,27 @@ void CheckElimination::OptimizeDominatedChecks()
     }
 }
 
+// The check passes the index through, so its users take the index itself.
+void CheckElimination::OptimizeChecksByRanges()
+{
+    const auto &ranges = graph_->GetAnalysisManager()->GetRangeAnalysis();
+
+    for (auto *block : graph_->GetRpoVector()) {
+        block->EnumerateInsns([&ranges, block](Instruction *insn) {
+            if (!insn->IsBoundCheck()) {
+                return false;
+            }
+            auto *check = static_cast<BoundsCheckInsn *>(insn);
+            auto *idx = check->GetIdxToCheck();
+            auto idxRange = ranges.GetRange(idx, block);
+
+            if (!idxRange.IsEmpty() && idxRange.GetMin() >= 0 && ranges.IsLess(idx, check->GetMaxArrayIdx(), block)) {
+                check->ReplaceInputsForUsers(idx);
+                block->Remove(check);
+            }
+            return false;
+        });
+    }
+}
+
 }  // namespace compiler
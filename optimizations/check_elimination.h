@@ -16,7 +16,12 @@ public:
 
     void Run();
 
+    // Only checks are removed, CFG is kept.
+    static constexpr AnalysisSet PRESERVED_ANALYSES = CFG_ANALYSES;
+
     void OptimizeDominatedChecks();
+    // Removes bounds checks whose index provably lies in [0, length).
+    void OptimizeChecksByRanges();
 
 private:
     Graph *graph_ {nullptr};
@@ -1,88 +1,336 @@
+#include "optimizations/constant_folding.h"
 #include "ir/data_types.h"
 #include "ir/instructions.h"
 #include "optimizations/peepholes.h"
+#include "utils/bit_utils.h"
+
+#include <array>
+#include <cmath>
+#include <type_traits>
 
 namespace compiler {
 
-bool Peepholes::ConstantFoldingMul(Instruction *insn)
-{
-    assert(insn != nullptr);
-    assert(insn->GetOpcode() == Opcode::MUL);
+// Operations over values of C++ types, IS_DEFINED tells whether the opcode exists for the type.
+// Integer arithmetic is done over uint64_t and truncated, so it wraps around instead of overflowing.
 
-    if (!insn->GetInputs()->GetInput(0)->IsConst() || !insn->GetInputs()->GetInput(1)->IsConst()) {
-        return false;
+template <typename T>
+struct AddOp {
+    static constexpr bool IS_DEFINED = true;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(static_cast<uint64_t>(lhs) + static_cast<uint64_t>(rhs));
+        } else {
+            return lhs + rhs;
+        }
     }
+};
 
-    auto *input0 = insn->GetInputs()->GetInput(0)->AsConst();
-    auto *input1 = insn->GetInputs()->GetInput(1)->AsConst();
+template <typename T>
+struct SubOp {
+    static constexpr bool IS_DEFINED = true;
 
-    switch (insn->GetResultType()) {
-        case DataType::U64:
-            [[fallthrough]];
-        case DataType::I64: {
-            int64_t value = input0->GetAsU64() * input1->GetAsU64();
-            graph_->CreateNewInsnInsteadOfInsn<ConstantInsn>(insn, value, DataType::I64);
-            break;
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(static_cast<uint64_t>(lhs) - static_cast<uint64_t>(rhs));
+        } else {
+            return lhs - rhs;
         }
-        case DataType::F32: {
-            float value = input0->GetAsF32() * input1->GetAsF32();
-            graph_->CreateNewInsnInsteadOfInsn<ConstantInsn>(insn, value, DataType::F32);
-            break;
+    }
+};
+
+template <typename T>
+struct MulOp {
+    static constexpr bool IS_DEFINED = true;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(static_cast<uint64_t>(lhs) * static_cast<uint64_t>(rhs));
+        } else {
+            return lhs * rhs;
         }
-        case DataType::F64: {
-            double value = input0->GetAsF64() * input1->GetAsF64();
-            graph_->CreateNewInsnInsteadOfInsn<ConstantInsn>(insn, value, DataType::F64);
-            break;
+    }
+};
+
+template <typename T>
+struct DivOp {
+    static constexpr bool IS_DEFINED = true;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        if constexpr (std::is_integral_v<T>) {
+            if (rhs == 0) {
+                return std::nullopt;
+            }
+            if constexpr (std::is_signed_v<T>) {
+                // The only overflowing quotient, MIN / -1 wraps around to MIN.
+                if (rhs == -1) {
+                    return static_cast<T>(0U - static_cast<uint64_t>(lhs));
+                }
+            }
+            return static_cast<T>(lhs / rhs);
+        } else {
+            return lhs / rhs;
         }
-        default: {
-            UNREACHABLE();
-            return false;
+    }
+};
+
+template <typename T>
+struct RemOp {
+    static constexpr bool IS_DEFINED = true;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        if constexpr (std::is_integral_v<T>) {
+            if (rhs == 0) {
+                return std::nullopt;
+            }
+            if constexpr (std::is_signed_v<T>) {
+                if (rhs == -1) {
+                    return T {0};
+                }
+            }
+            return static_cast<T>(lhs % rhs);
+        } else {
+            return std::fmod(lhs, rhs);
         }
     }
+};
 
-    return true;
-}
+template <typename T>
+struct AndOp {
+    static constexpr bool IS_DEFINED = std::is_integral_v<T>;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        return static_cast<T>(lhs & rhs);
+    }
+};
 
-bool Peepholes::ConstantFoldingAshr(Instruction *insn)
+template <typename T>
+struct OrOp {
+    static constexpr bool IS_DEFINED = std::is_integral_v<T>;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        return static_cast<T>(lhs | rhs);
+    }
+};
+
+template <typename T>
+struct XorOp {
+    static constexpr bool IS_DEFINED = std::is_integral_v<T>;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        return static_cast<T>(lhs ^ rhs);
+    }
+};
+
+// Only the low bits of the shift amount are taken, as much as needed to shift by the width minus one.
+template <typename T>
+static uint64_t GetShiftAmount(T rhs)
 {
-    assert(insn != nullptr);
-    assert(insn->GetOpcode() == Opcode::ASHR);
-    assert(insn->IsIntResultType());
+    return static_cast<uint64_t>(rhs) & (sizeof(T) * 8U - 1U);
+}
 
-    if (!insn->GetInputs()->GetInput(0)->IsConst() || !insn->GetInputs()->GetInput(1)->IsConst()) {
-        return false;
+template <typename T>
+struct ShlOp {
+    static constexpr bool IS_DEFINED = std::is_integral_v<T>;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        return static_cast<T>(static_cast<uint64_t>(lhs) << GetShiftAmount(rhs));
     }
+};
 
-    int64_t input0Value = insn->GetInputs()->GetInput(0)->AsConst()->GetAsI64();
-    uint64_t input1Value = insn->GetInputs()->GetInput(1)->AsConst()->GetAsI64();
+template <typename T>
+struct ShrOp {
+    static constexpr bool IS_DEFINED = std::is_integral_v<T>;
 
-    if (insn->GetResultType() == DataType::I32 || insn->GetResultType() == DataType::U32) {
-        int32_t value = static_cast<int32_t>(input0Value) >> static_cast<uint32_t>(input1Value);
-        graph_->CreateNewInsnInsteadOfInsn<ConstantInsn>(insn, value, insn->GetResultType());
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        return static_cast<T>(static_cast<std::make_unsigned_t<T>>(lhs) >> GetShiftAmount(rhs));
+    }
+};
+
+template <typename T>
+struct AshrOp {
+    static constexpr bool IS_DEFINED = std::is_integral_v<T>;
+
+    static std::optional<T> Apply(T lhs, T rhs)
+    {
+        return static_cast<T>(static_cast<std::make_signed_t<T>>(lhs) >> GetShiftAmount(rhs));
+    }
+};
+
+template <typename T>
+static T FromBits(uint64_t bits)
+{
+    if constexpr (std::is_same_v<T, float>) {
+        return utils::bit_cast<float>(static_cast<uint32_t>(bits));
+    } else if constexpr (std::is_same_v<T, double>) {
+        return utils::bit_cast<double>(bits);
     } else {
-        int64_t value = input0Value >> input1Value;
-        graph_->CreateNewInsnInsteadOfInsn<ConstantInsn>(insn, value, insn->GetResultType());
+        return static_cast<T>(bits);
     }
+}
 
-    return true;
+template <typename T>
+static uint64_t ToBits(T value)
+{
+    if constexpr (std::is_same_v<T, float>) {
+        return utils::bit_cast<uint32_t>(value);
+    } else if constexpr (std::is_same_v<T, double>) {
+        return utils::bit_cast<uint64_t>(value);
+    } else if constexpr (std::is_signed_v<T>) {
+        return static_cast<uint64_t>(static_cast<int64_t>(value));
+    } else {
+        return static_cast<uint64_t>(value);
+    }
+}
+
+using FoldKernel = std::optional<uint64_t> (*)(uint64_t lhs, uint64_t rhs);
+using KernelRow = std::array<FoldKernel, DATA_TYPES_COUNT>;
+
+template <template <typename> class OpT, typename T>
+static std::optional<uint64_t> ApplyKernel(uint64_t lhs, uint64_t rhs)
+{
+    auto result = OpT<T>::Apply(FromBits<T>(lhs), FromBits<T>(rhs));
+    return result ? std::optional(ToBits(*result)) : std::nullopt;
+}
+
+template <template <typename> class OpT, typename T>
+static constexpr void SetKernel(KernelRow *row, DataType type)
+{
+    if constexpr (OpT<T>::IS_DEFINED) {
+        (*row)[static_cast<size_t>(type)] = &ApplyKernel<OpT, T>;
+    }
+}
+
+template <template <typename> class OpT>
+static constexpr KernelRow MakeKernelRow()
+{
+    KernelRow row {};
+    SetKernel<OpT, int8_t>(&row, DataType::I8);
+    SetKernel<OpT, uint8_t>(&row, DataType::U8);
+    SetKernel<OpT, int16_t>(&row, DataType::I16);
+    SetKernel<OpT, uint16_t>(&row, DataType::U16);
+    SetKernel<OpT, int32_t>(&row, DataType::I32);
+    SetKernel<OpT, uint32_t>(&row, DataType::U32);
+    SetKernel<OpT, int64_t>(&row, DataType::I64);
+    SetKernel<OpT, uint64_t>(&row, DataType::U64);
+    SetKernel<OpT, float>(&row, DataType::F32);
+    SetKernel<OpT, double>(&row, DataType::F64);
+    return row;
+}
+
+// Kernels by opcodes and result types, null where nothing is folded.
+static constexpr auto FOLD_KERNELS = [] {
+    std::array<KernelRow, OPCODES_COUNT> kernels {};
+    kernels[Opcode::ADD] = MakeKernelRow<AddOp>();
+    kernels[Opcode::SUB] = MakeKernelRow<SubOp>();
+    kernels[Opcode::MUL] = MakeKernelRow<MulOp>();
+    kernels[Opcode::DIV] = MakeKernelRow<DivOp>();
+    kernels[Opcode::REM] = MakeKernelRow<RemOp>();
+    kernels[Opcode::AND] = MakeKernelRow<AndOp>();
+    kernels[Opcode::OR] = MakeKernelRow<OrOp>();
+    kernels[Opcode::XOR] = MakeKernelRow<XorOp>();
+    kernels[Opcode::ASHR] = MakeKernelRow<AshrOp>();
+    kernels[Opcode::SHR] = MakeKernelRow<ShrOp>();
+    kernels[Opcode::SHL] = MakeKernelRow<ShlOp>();
+    return kernels;
+}();
+
+std::optional<uint64_t> FoldBinaryOperation(Opcode opcode, DataType type, uint64_t lhs, uint64_t rhs)
+{
+    auto kernel = FOLD_KERNELS[opcode][static_cast<size_t>(type)];
+    return kernel == nullptr ? std::nullopt : kernel(lhs, rhs);
+}
+
+template <typename T>
+static uint64_t NormalizeBits(uint64_t bits)
+{
+    return ToBits(FromBits<T>(bits));
+}
+
+std::optional<uint64_t> GetConstantOperand(const ConstantInsn *constant, DataType type)
+{
+    if (type == DataType::F32 || type == DataType::F64) {
+        bool isMatched = type == DataType::F32 ? constant->IsF32() : constant->IsF64();
+        return isMatched ? std::optional(constant->GetAsU64()) : std::nullopt;
+    }
+    if (!constant->IsSignedInt() && !constant->IsUnsignedInt()) {
+        return std::nullopt;
+    }
+
+    // Integer constants are truncated to the type.
+    auto bits = constant->GetAsU64();
+    switch (type) {
+        case DataType::I8:
+            return NormalizeBits<int8_t>(bits);
+        case DataType::U8:
+            return NormalizeBits<uint8_t>(bits);
+        case DataType::I16:
+            return NormalizeBits<int16_t>(bits);
+        case DataType::U16:
+            return NormalizeBits<uint16_t>(bits);
+        case DataType::I32:
+            return NormalizeBits<int32_t>(bits);
+        case DataType::U32:
+            return NormalizeBits<uint32_t>(bits);
+        case DataType::I64:
+        case DataType::U64:
+            return bits;
+        default:
+            return std::nullopt;
+    }
 }
 
-bool Peepholes::ConstantFoldingOr(Instruction *insn)
+ConstantInsn *CreateFoldedConstant(Graph *graph, DataType type, uint64_t value)
+{
+    switch (type) {
+        case DataType::F32:
+            return graph->CreateInsn<ConstantInsn>(FromBits<float>(value), type);
+        case DataType::F64:
+            return graph->CreateInsn<ConstantInsn>(FromBits<double>(value), type);
+        case DataType::U8:
+        case DataType::U16:
+        case DataType::U32:
+        case DataType::U64:
+            return graph->CreateInsn<ConstantInsn>(value, type);
+        default:
+            return graph->CreateInsn<ConstantInsn>(static_cast<int64_t>(value), type);
+    }
+}
+
+bool Peepholes::ConstantFolding(Instruction *insn)
 {
     assert(insn != nullptr);
-    assert(insn->GetOpcode() == Opcode::OR);
-    assert(insn->IsIntResultType());
 
-    if (!insn->GetInputs()->GetInput(0)->IsConst() || !insn->GetInputs()->GetInput(1)->IsConst()) {
+    if (!insn->GetInput(0)->IsConst() || !insn->GetInput(1)->IsConst()) {
         return false;
     }
 
-    auto *input0 = insn->GetInputs()->GetInput(0)->AsConst();
-    auto *input1 = insn->GetInputs()->GetInput(1)->AsConst();
-
-    uint64_t value = input0->GetAsU64() | input1->GetAsU64();
-    graph_->CreateNewInsnInsteadOfInsn<ConstantInsn>(insn, value, insn->GetResultType());
+    auto type = insn->GetResultType();
+    auto lhs = GetConstantOperand(insn->GetInput(0)->AsConst(), type);
+    auto rhs = GetConstantOperand(insn->GetInput(1)->AsConst(), type);
+    if (!lhs || !rhs) {
+        return false;
+    }
+    auto value = FoldBinaryOperation(insn->GetOpcode(), type, *lhs, *rhs);
+    if (!value) {
+        return false;
+    }
 
+    auto *constant = CreateFoldedConstant(graph_, type, *value);
+    auto *block = insn->GetParentBB();
+    block->InsertInstruction(insn->GetPrev(), constant);
+    insn->ReplaceInputsForUsers(constant);
+    block->Remove(insn);
     return true;
 }
 
@@ -0,0 +1,32 @@
+#ifndef OPTIMIZATIONS_CONSTANT_FOLDING_H
+#define OPTIMIZATIONS_CONSTANT_FOLDING_H
+
+#include "ir/data_types.h"
+#include "ir/opcodes.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace compiler {
+
+class ConstantInsn;
+class Graph;
+
+// Compile-time evaluation of arithmetic, bitwise and shift opcodes with the semantics of the result type:
+// integers wrap around their width and shift amounts are masked by it, floats follow IEEE 754, so NaNs propagate.
+// Values are passed as ConstantInsn keeps them: integers extended to 64 bits with the sign or zeros,
+// floats as their bit patterns.
+
+// Result of the operation, nullopt if it is not folded: the opcode is not defined for the type
+// (e.g. bitwise opcodes for floats) or it is an integer division by zero.
+std::optional<uint64_t> FoldBinaryOperation(Opcode opcode, DataType type, uint64_t lhs, uint64_t rhs);
+
+// Value of the constant as an operand of the type, nullopt if the constant is of the other kind.
+std::optional<uint64_t> GetConstantOperand(const ConstantInsn *constant, DataType type);
+
+// New constant out of the folded value, it's not inserted into a block.
+ConstantInsn *CreateFoldedConstant(Graph *graph, DataType type, uint64_t value);
+
+}  // namespace compiler
+
+#endif  // OPTIMIZATIONS_CONSTANT_FOLDING_H
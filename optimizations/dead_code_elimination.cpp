@@ -0,0 +1,80 @@
+#include "optimizations/dead_code_elimination.h"
+#include "ir/instructions.h"
+
+namespace compiler {
+
+// Returns, jumps and checks change the control flow, stores and calls may change memory.
+static bool HasSideEffects(const Instruction *insn)
+{
+    switch (insn->GetOpcode()) {
+        case Opcode::RET:
+        case Opcode::JMP:
+        case Opcode::BEQ:
+        case Opcode::BNE:
+        case Opcode::BGT:
+        case Opcode::STOREARRAY:
+        case Opcode::CALLSTATIC:
+        case Opcode::NULLCHECK:
+        case Opcode::BOUNDSCHECK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void DeadCodeElimination::Run()
+{
+    graph_->RemoveUnreachableBlocks();
+
+    auto marker = graph_->CreateNewMarker();
+    MarkLive(marker);
+    SweepDead(marker);
+    graph_->EraseMarker(marker);
+
+    graph_->RenumberIds();
+    graph_->GetAnalysisManager()->Invalidate(PRESERVED_ANALYSES);
+}
+
+void DeadCodeElimination::MarkLive(Marker marker)
+{
+    for (auto *block : graph_->GetBlocks()) {
+        for (auto *insn = block->GetFirstInsn(); insn != nullptr; insn = insn->GetNext()) {
+            if (HasSideEffects(insn)) {
+                Mark(insn, marker);
+            }
+        }
+    }
+
+    while (!worklist_.empty()) {
+        auto *insn = worklist_.back();
+        worklist_.pop_back();
+        for (auto &input : insn->GetInputs()) {
+            // The input of a void return is empty.
+            if (input.GetValue() != nullptr) {
+                Mark(input.GetValue(), marker);
+            }
+        }
+    }
+}
+
+void DeadCodeElimination::Mark(Instruction *insn, Marker marker)
+{
+    if (!insn->IsMarked(marker)) {
+        insn->SetMarker(marker);
+        worklist_.push_back(insn);
+    }
+}
+
+void DeadCodeElimination::SweepDead(Marker marker)
+{
+    for (auto *block : graph_->GetBlocks()) {
+        block->EnumerateInsns([block, marker](Instruction *insn) {
+            if (!insn->IsMarked(marker)) {
+                block->Remove(insn);
+            }
+            return false;
+        });
+    }
+}
+
+}  // namespace compiler
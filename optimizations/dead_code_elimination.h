@@ -0,0 +1,41 @@
+#ifndef OPTIMIZATIONS_DEAD_CODE_ELIMINATION_H
+#define OPTIMIZATIONS_DEAD_CODE_ELIMINATION_H
+
+#include "utils/macros.h"
+#include "ir/graph.h"
+
+#include <vector>
+
+namespace compiler {
+
+// Mark-and-sweep removal of unused instructions. Instructions with side effects are live, as well as
+// everything they use transitively; the rest, including cycles of phis, is removed.
+// Unreachable blocks are removed first, so their values don't keep anything alive through phis.
+// Ids of blocks and instructions are renumbered afterwards.
+class DeadCodeElimination final {
+public:
+    NO_COPY_SEMANTIC(DeadCodeElimination);
+    NO_MOVE_SEMANTIC(DeadCodeElimination);
+
+    DeadCodeElimination(Graph *graph) : graph_(graph) {}
+    ~DeadCodeElimination() = default;
+
+    void Run();
+
+    // Blocks are removed and ids are changed.
+    static constexpr AnalysisSet PRESERVED_ANALYSES {};
+
+private:
+    void MarkLive(Marker marker);
+    void Mark(Instruction *insn, Marker marker);
+    void SweepDead(Marker marker);
+
+private:
+    Graph *graph_ {nullptr};
+
+    std::vector<Instruction *> worklist_;
+};
+
+}  // namespace compiler
+
+#endif  // OPTIMIZATIONS_DEAD_CODE_ELIMINATION_H
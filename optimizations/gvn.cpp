@@ -0,0 +1,191 @@
+#include "optimizations/gvn.h"
+#include "analysis/alias_analysis.h"
+#include "ir/instructions.h"
+
+#include <functional>
+
+namespace compiler {
+
+static bool IsCommutative(Opcode opcode)
+{
+    switch (opcode) {
+        case Opcode::ADD:
+        case Opcode::MUL:
+        case Opcode::AND:
+        case Opcode::OR:
+        case Opcode::XOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Instructions whose result depends only on their inputs; checks which fail stop the execution,
+// so a dominated duplicate of a check never fails.
+static bool IsNumbered(Opcode opcode)
+{
+    switch (opcode) {
+        case Opcode::ADD:
+        case Opcode::SUB:
+        case Opcode::MUL:
+        case Opcode::DIV:
+        case Opcode::REM:
+        case Opcode::AND:
+        case Opcode::OR:
+        case Opcode::XOR:
+        case Opcode::ASHR:
+        case Opcode::SHR:
+        case Opcode::SHL:
+        case Opcode::CONSTANT:
+        case Opcode::NULLCHECK:
+        case Opcode::BOUNDSCHECK:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t Gvn::KeyHash::operator()(const Key &key) const
+{
+    size_t hash = std::hash<uint64_t> {}(key.payload);
+    auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6U) + (hash >> 2U); };
+
+    combine(key.opcode);
+    combine(static_cast<size_t>(key.type));
+    combine(static_cast<size_t>(key.payloadType));
+    for (const auto *input : key.inputs) {
+        combine(std::hash<const Instruction *> {}(input));
+    }
+    return hash;
+}
+
+void Gvn::Run()
+{
+    auto *analysisManager = graph_->GetAnalysisManager();
+    analysisManager->Run(AnalysisType::DOMINATOR_TREE);
+    aliases_ = &analysisManager->GetAliasAnalysis();
+    values_.reserve(graph_->GetInstructions().size());
+
+    // Walk over the dominator tree without recursion, the scope of a block is left after all its children.
+    std::vector<Scope> scopes;
+    auto enterBlock = [this, &scopes](BasicBlock *block) {
+        scopes.push_back({block, 0, keys_.size(), loads_.size(), kills_.size(), memoryBase_});
+        EnterBlock(block);
+    };
+
+    enterBlock(graph_->GetStartBlock());
+    while (!scopes.empty()) {
+        auto &scope = scopes.back();
+        const auto &children = scope.block->GetDominatedBlocks();
+        if (scope.nextChild < children.size()) {
+            enterBlock(children[scope.nextChild++]);
+            continue;
+        }
+        LeaveScope(scope);
+        scopes.pop_back();
+    }
+
+    analysisManager->Invalidate(PRESERVED_ANALYSES);
+}
+
+void Gvn::EnterBlock(BasicBlock *block)
+{
+    if (block->GetPredecessors().size() != 1U) {
+        memoryBase_ = loads_.size();
+    }
+
+    block->EnumerateInsns([this, block](Instruction *insn) {
+        if (VisitInsn(insn)) {
+            block->Remove(insn);
+        }
+        return false;
+    });
+}
+
+void Gvn::LeaveScope(const Scope &scope)
+{
+    while (keys_.size() > scope.keysCount) {
+        values_.erase(keys_.back());
+        keys_.pop_back();
+    }
+
+    while (kills_.size() > scope.killsCount) {
+        auto [idx, load] = kills_.back();
+        if (idx < scope.loadsCount) {
+            loads_[idx] = load;
+        }
+        kills_.pop_back();
+    }
+    loads_.resize(scope.loadsCount);
+    memoryBase_ = scope.memoryBase;
+}
+
+// Returns true if the instruction is replaced with an equal one and must be removed.
+bool Gvn::VisitInsn(Instruction *insn)
+{
+    auto opcode = insn->GetOpcode();
+    if (opcode == Opcode::LOADARRAY) {
+        return VisitLoad(insn);
+    }
+    if (opcode == Opcode::STOREARRAY) {
+        KillLoads(insn);
+        return false;
+    }
+    if (opcode == Opcode::CALLSTATIC) {
+        memoryBase_ = loads_.size();
+        return false;
+    }
+    if (!IsNumbered(opcode)) {
+        return false;
+    }
+
+    Key key {opcode, insn->GetResultType()};
+    for (size_t idx = 0; idx < insn->GetInputsCount(); ++idx) {
+        key.inputs[idx] = insn->GetInput(idx);
+    }
+    if (IsCommutative(opcode) && key.inputs[0]->GetId() > key.inputs[1]->GetId()) {
+        std::swap(key.inputs[0], key.inputs[1]);
+    }
+    if (insn->IsConst()) {
+        key.payload = insn->AsConst()->GetAsU64();
+        key.payloadType = insn->AsConst()->GetType();
+    }
+
+    auto [it, isInserted] = values_.try_emplace(key, insn);
+    if (isInserted) {
+        keys_.push_back(key);
+        return false;
+    }
+    insn->ReplaceInputsForUsers(it->second);
+    return true;
+}
+
+bool Gvn::VisitLoad(Instruction *load)
+{
+    for (auto idx = loads_.size(); idx > memoryBase_; --idx) {
+        auto *available = loads_[idx - 1U];
+        if (available != nullptr && available->GetResultType() == load->GetResultType() &&
+            available->GetInput(0) == load->GetInput(0) && available->GetInput(1) == load->GetInput(1)) {
+            load->ReplaceInputsForUsers(available);
+            return true;
+        }
+    }
+
+    if (loads_.size() - memoryBase_ < MAX_AVAILABLE_LOADS) {
+        loads_.push_back(load);
+    }
+    return false;
+}
+
+void Gvn::KillLoads(const Instruction *store)
+{
+    for (auto idx = memoryBase_; idx < loads_.size(); ++idx) {
+        auto *load = loads_[idx];
+        if (load != nullptr && aliases_->CheckAlias(load, store) != AliasResult::NO_ALIAS) {
+            kills_.emplace_back(idx, load);
+            loads_[idx] = nullptr;
+        }
+    }
+}
+
+}  // namespace compiler
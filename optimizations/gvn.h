@@ -0,0 +1,90 @@
+#ifndef OPTIMIZATIONS_GVN_H
+#define OPTIMIZATIONS_GVN_H
+
+#include "utils/macros.h"
+#include "ir/graph.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace compiler {
+
+class AliasAnalysis;
+
+// Dominator-based global value numbering: an instruction which computes the same value as an instruction
+// of a dominating block, or earlier in its own block, is replaced with it. Values are looked up in a hash table
+// which is scoped by the dominator tree walk, inputs of commutative opcodes are ordered by ids.
+//
+// Pure arithmetic, constants and checks are numbered everywhere. Loads are only reused along straight-line code,
+// the memory state is dropped at blocks with several predecessors, since stores may happen on the other paths.
+// A store kills the available loads which it may alias, a call kills all of them.
+class Gvn final {
+public:
+    NO_COPY_SEMANTIC(Gvn);
+    NO_MOVE_SEMANTIC(Gvn);
+
+    // Loads available at once, bounds the cost of lookups and kills.
+    static constexpr size_t MAX_AVAILABLE_LOADS = 32U;
+
+    Gvn(Graph *graph) : graph_(graph) {}
+    ~Gvn() = default;
+
+    void Run();
+
+    // Only instructions are removed, CFG is kept.
+    static constexpr AnalysisSet PRESERVED_ANALYSES = CFG_ANALYSES;
+
+private:
+    struct Key {
+        Opcode opcode {Opcode::UNDEFINED};
+        DataType type {DataType::UNDEFINED};
+        std::array<const Instruction *, 3U> inputs {};
+        // Value bits and kind of constants.
+        uint64_t payload {0};
+        DataType payloadType {DataType::UNDEFINED};
+
+        bool operator==(const Key &other) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    // State of the walk to restore once the subtree of the block is left.
+    struct Scope {
+        BasicBlock *block {nullptr};
+        size_t nextChild {0};
+        size_t keysCount {0};
+        size_t loadsCount {0};
+        size_t killsCount {0};
+        size_t memoryBase {0};
+    };
+
+    void EnterBlock(BasicBlock *block);
+    void LeaveScope(const Scope &scope);
+    bool VisitInsn(Instruction *insn);
+    bool VisitLoad(Instruction *load);
+    void KillLoads(const Instruction *store);
+
+private:
+    Graph *graph_ {nullptr};
+    const AliasAnalysis *aliases_ {nullptr};
+
+    std::unordered_map<Key, Instruction *, KeyHash> values_;
+    // Keys added in the current path of the dominator tree, in order of addition.
+    std::vector<Key> keys_;
+
+    // Loads in the current path, nulls for killed ones; only those from `memoryBase_` are available.
+    std::vector<Instruction *> loads_;
+    size_t memoryBase_ {0};
+    // Killed loads with their positions, to restore them for the siblings.
+    std::vector<std::pair<size_t, Instruction *>> kills_;
+};
+
+}  // namespace compiler
+
+#endif  // OPTIMIZATIONS_GVN_H
@@ -1,21 +1,284 @@
-#include "analysis/dominator_tree.h"
 #include "optimizations/inlining.h"
+#include "analysis/block_frequency.h"
+#include "ir/ir_builder-inl.h"
+#include "ir/method_registry.h"
+#include "ir/side_table.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
 
 namespace compiler {
 
+// Number of instructions which the callee adds to the caller, nullopt if it never returns.
+// Only reachable blocks are counted, as only they are cloned.
+static std::optional<size_t> GetInlinedSize(Graph *callee)
+{
+    callee->GetAnalysisManager()->Run(AnalysisType::RPO);
+
+    size_t size = 0;
+    bool hasReturn = false;
+    for (const auto *block : callee->GetRpoVector()) {
+        for (const auto *insn = block->GetFirstInsn(); insn != nullptr; insn = insn->GetNext()) {
+            hasReturn |= insn->GetOpcode() == Opcode::RET;
+            size += insn->GetOpcode() == Opcode::PARAMETER ? 0U : 1U;
+        }
+    }
+    return hasReturn ? std::optional(size) : std::nullopt;
+}
+
+static size_t CountInsns(const Graph *graph)
+{
+    size_t size = 0;
+    for (const auto *block : graph->GetBlocks()) {
+        for (const auto *insn = block->GetFirstInsn(); insn != nullptr; insn = insn->GetNext()) {
+            ++size;
+        }
+    }
+    return size;
+}
+
+static Instruction *CloneConstant(IrBuilder *builder, const ConstantInsn *constant)
+{
+    auto type = constant->GetResultType();
+    if (constant->IsSignedInt()) {
+        return builder->CreateConstantInsn(constant->GetAsI64(), type);
+    }
+    if (constant->IsUnsignedInt()) {
+        return builder->CreateConstantInsn(constant->GetAsU64(), type);
+    }
+    if (constant->IsF32()) {
+        return builder->CreateConstantInsn(constant->GetAsF32(), type);
+    }
+    assert(constant->IsF64());
+    return builder->CreateConstantInsn(constant->GetAsF64(), type);
+}
+
+// Copy of the callee instruction in the current block of the builder, inputs and targets are taken from the
+// copies made before. Phis are created without inputs, since their inputs may come later.
+static Instruction *CloneInsn(IrBuilder *builder, Instruction *insn, const InsnSideTable<Instruction *> &insns,
+                              const BlockSideTable<BasicBlock *> &blocks)
+{
+    auto input = [insn, &insns](size_t idx) { return insns[insn->GetInput(idx)]; };
+    auto type = insn->GetResultType();
+
+    switch (insn->GetOpcode()) {
+        case Opcode::UNDEFINED:
+            return builder->CreateInstruction<UndefinedInsn>();
+        case Opcode::ADD:
+            return builder->CreateAddInsn(type, input(0), input(1));
+        case Opcode::SUB:
+            return builder->CreateSubInsn(type, input(0), input(1));
+        case Opcode::MUL:
+            return builder->CreateMulInsn(type, input(0), input(1));
+        case Opcode::DIV:
+            return builder->CreateDivInsn(type, input(0), input(1));
+        case Opcode::REM:
+            return builder->CreateRemInsn(type, input(0), input(1));
+        case Opcode::AND:
+            return builder->CreateAndInsn(type, input(0), input(1));
+        case Opcode::OR:
+            return builder->CreateOrInsn(type, input(0), input(1));
+        case Opcode::XOR:
+            return builder->CreateXorInsn(type, input(0), input(1));
+        case Opcode::ASHR:
+            return builder->CreateAshrInsn(type, input(0), input(1));
+        case Opcode::SHR:
+            return builder->CreateShrInsn(type, input(0), input(1));
+        case Opcode::SHL:
+            return builder->CreateShlInsn(type, input(0), input(1));
+        case Opcode::JMP:
+            return builder->CreateJmpInsn(blocks[static_cast<JmpInsn *>(insn)->GetBBToJmp()]);
+        case Opcode::BEQ:
+        case Opcode::BNE:
+        case Opcode::BGT: {
+            auto *branch = static_cast<BranchInsn *>(insn);
+            auto *ifTrueBB = blocks[branch->GetTrueBranchBB()];
+            auto *ifFalseBB = blocks[branch->GetFalseBranchBB()];
+            if (insn->GetOpcode() == Opcode::BEQ) {
+                return builder->CreateBeqInsn(input(0), input(1), ifTrueBB, ifFalseBB);
+            }
+            if (insn->GetOpcode() == Opcode::BNE) {
+                return builder->CreateBneInsn(input(0), input(1), ifTrueBB, ifFalseBB);
+            }
+            return builder->CreateBgtInsn(input(0), input(1), ifTrueBB, ifFalseBB);
+        }
+        case Opcode::PHI:
+            return builder->CreatePhiInsn(type);
+        case Opcode::CONSTANT:
+            return CloneConstant(builder, insn->AsConst());
+        case Opcode::CALLSTATIC: {
+            auto *call = static_cast<CallStaticInsn *>(insn);
+            auto *newCall = static_cast<CallStaticInsn *>(builder->CreateCallStaticInsn(type, call->GetMethodId(), {}));
+            for (size_t idx = 0; idx < call->GetInputsCount(); ++idx) {
+                newCall->AppendArgument(input(idx), call->GetArgumentType(idx));
+            }
+            return newCall;
+        }
+        case Opcode::NULLCHECK:
+            return builder->CreateNullcheckInsn(input(0));
+        case Opcode::BOUNDSCHECK:
+            return builder->CreateBoundsCheckInsn(input(0), input(1), input(2));
+        case Opcode::NEWARR: {
+            auto *newArr = static_cast<NewArrInsn *>(insn);
+            return builder->CreateNewArrInsn(newArr->GetElemType(), newArr->GetLength());
+        }
+        case Opcode::LOADARRAY:
+            return builder->CreateLoadArrayInsn(type, input(0), input(1));
+        case Opcode::STOREARRAY:
+            return builder->CreateStoreArrayInsn(type, input(0), input(1), input(2));
+        default:
+            // Parameters and returns are replaced by the caller.
+            UNREACHABLE();
+    }
+}
+
+bool Inlining::IsProfitable(size_t calleeSize, double frequency, uint32_t depth)
+{
+    if (depth >= MAX_DEPTH) {
+        return false;
+    }
+    if (calleeSize <= SMALL_METHOD_INSNS) {
+        return true;
+    }
+    auto limit = static_cast<double>(CALLEE_INSNS_LIMIT) * std::min(frequency, MAX_FREQUENCY_SCALE) / (depth + 1U);
+    return static_cast<double>(calleeSize) <= limit;
+}
+
 void Inlining::Run()
 {
-    // DominatorTree tree(graph_);
-    // tree.Build();
+    auto *registry = graph_->GetMethodRegistry();
+    if (registry == nullptr) {
+        return;
+    }
+
+    const auto &frequencies = graph_->GetAnalysisManager()->GetBlockFrequency();
+    frames_.push_back({graph_->GetMethodId(), 0});
+    for (auto *block : graph_->GetRpoVector()) {
+        for (auto *insn = block->GetFirstInsn(); insn != nullptr; insn = insn->GetNext()) {
+            if (insn->IsCall()) {
+                callSites_.push_back({static_cast<CallStaticInsn *>(insn), frequencies.GetFrequency(block), 0, 0});
+            }
+        }
+    }
+
+    auto callerSize = CountInsns(graph_);
+    bool isChanged = false;
+    // Call sites of the inlined bodies are appended, so callees are inlined level by level.
+    for (size_t idx = 0; idx < callSites_.size(); ++idx) {
+        auto site = callSites_[idx];
+        auto *callee = registry->GetGraph(site.call->GetMethodId());
+        if (callee == nullptr || IsRecursive(callee->GetMethodId(), site.frame)) {
+            continue;
+        }
+
+        auto calleeSize = GetInlinedSize(callee);
+        if (!calleeSize || !IsProfitable(*calleeSize, site.frequency, site.depth) ||
+            callerSize + *calleeSize > CALLER_INSNS_LIMIT) {
+            continue;
+        }
+
+        InlineCall(site, callee);
+        callerSize += *calleeSize;
+        isChanged = true;
+    }
+
+    if (isChanged) {
+        graph_->GetAnalysisManager()->Invalidate(PRESERVED_ANALYSES);
+    }
+}
+
+bool Inlining::IsRecursive(size_t methodId, size_t frame) const
+{
+    for (auto idx = frame;; idx = frames_[idx].parent) {
+        if (frames_[idx].methodId == methodId) {
+            return true;
+        }
+        if (idx == 0) {
+            return false;
+        }
+    }
+}
+
+void Inlining::InlineCall(const CallSite &site, Graph *callee)
+{
+    const auto &calleeFrequencies = callee->GetAnalysisManager()->GetBlockFrequency();
+    const auto &calleeBlocks = callee->GetRpoVector();
+
+    auto *call = site.call;
+    auto *callBlock = call->GetParentBB();
+    auto frame = frames_.size();
+    frames_.push_back({callee->GetMethodId(), site.frame});
+
+    IrBuilder builder(graph_);
+    auto *contBlock = builder.CreateBB();
+    callBlock->SplitAfter(call, contBlock);
+
+    BlockSideTable<BasicBlock *> blocks(callee, nullptr);
+    for (auto *calleeBlock : calleeBlocks) {
+        blocks[calleeBlock] = builder.CreateBB();
+    }
+
+    InsnSideTable<Instruction *> insns(callee, nullptr);
+    std::vector<PhiInsn *> phis;
+    std::vector<std::pair<Instruction *, BasicBlock *>> returns;
+
+    // Definitions dominate their uses, so in RPO only inputs of phis are not cloned yet.
+    for (auto *calleeBlock : calleeBlocks) {
+        auto *block = blocks[calleeBlock];
+        builder.SetBasicBlockScope(block);
+        for (auto *insn = calleeBlock->GetFirstInsn(); insn != nullptr; insn = insn->GetNext()) {
+            if (insn->GetOpcode() == Opcode::PARAMETER) {
+                auto argNum = static_cast<ParameterInsn *>(insn)->GetArgNum();
+                assert(argNum < call->GetInputsCount());
+                insns[insn] = call->GetArgument(argNum);
+                continue;
+            }
+            if (insn->GetOpcode() == Opcode::RET) {
+                auto *value = insn->GetInput(0);
+                returns.emplace_back(value == nullptr ? nullptr : insns[value], block);
+                builder.CreateJmpInsn(contBlock);
+                continue;
+            }
+
+            auto *clone = CloneInsn(&builder, insn, insns, blocks);
+            insns[insn] = clone;
+            if (clone->IsPhi()) {
+                phis.push_back(static_cast<PhiInsn *>(insn));
+            } else if (clone->IsCall()) {
+                auto frequency = site.frequency * calleeFrequencies.GetFrequency(calleeBlock);
+                callSites_.push_back({static_cast<CallStaticInsn *>(clone), frequency, site.depth + 1U, frame});
+            }
+        }
+    }
+
+    for (auto *phi : phis) {
+        auto *clone = static_cast<PhiInsn *>(insns[phi]);
+        for (auto &dependency : phi->GetDependencies()) {
+            // Values from unreachable predecessors and values defined in unreachable blocks are dropped.
+            if (blocks[dependency.block] != nullptr && insns[dependency.value] != nullptr) {
+                clone->ResolveDependency(insns[dependency.value], blocks[dependency.block]);
+            }
+        }
+    }
 
-    // auto &blocks = graph_->GetRpoVector();
-    // for (auto *block: blocks) {
-    //     block->EnumerateInsns([](Instruction *currInsn) {
-    //         if (currInsn->GetOpcode() == Opcode::CALLSTATIC && static_cast<>(currInsn)->) {
+    if (call->HasResult() && !call->GetUsers().empty()) {
+        assert(!returns.empty() && returns.front().first != nullptr);
+        if (returns.size() == 1U) {
+            call->ReplaceInputsForUsers(returns.front().first);
+        } else {
+            auto *phi = graph_->CreateInsn<PhiInsn>(call->GetResultType());
+            contBlock->InsertInstruction(nullptr, phi);
+            for (auto &[value, block] : returns) {
+                phi->ResolveDependency(value, block);
+            }
+            call->ReplaceInputsForUsers(phi);
+        }
+    }
 
-    //         }
-    //     });
-    // }
+    callBlock->Remove(call);
+    builder.SetBasicBlockScope(callBlock);
+    builder.CreateJmpInsn(blocks[callee->GetStartBlock()]);
 }
 
 }  // namespace compiler
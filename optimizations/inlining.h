@@ -1,24 +1,70 @@
-#ifndef OPTIMIZATIONS_PEEPHOLES_H
-#define OPTIMIZATIONS_PEEPHOLES_H
+#ifndef OPTIMIZATIONS_INLINING_H
+#define OPTIMIZATIONS_INLINING_H
 
+#include "utils/macros.h"
 #include "ir/graph.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace compiler {
 
+// Replaces static calls with bodies of the callees found in the method registry of the graph.
+// The call block is split after the call, the cloned callee goes in between and its returns jump to the rest
+// of the block, values they return are merged by a phi there.
+// Calls of the inlined bodies are inlined as well, up to MAX_DEPTH, unless they call back a method of the chain.
 class Inlining final {
 public:
     NO_COPY_SEMANTIC(Inlining);
     NO_MOVE_SEMANTIC(Inlining);
 
+    // Callees which are not larger than the call sequence itself are inlined at any call site.
+    static constexpr size_t SMALL_METHOD_INSNS = 8U;
+    // Limit of the callee size at a call site executed once per invocation of the caller.
+    static constexpr size_t CALLEE_INSNS_LIMIT = 64U;
+    // The limit grows with the call site frequency up to this factor.
+    static constexpr double MAX_FREQUENCY_SCALE = 4.0;
+    static constexpr uint32_t MAX_DEPTH = 3U;
+    // No callee is inlined once the caller would grow beyond this size.
+    static constexpr size_t CALLER_INSNS_LIMIT = 4096U;
+
     Inlining(Graph *graph) : graph_(graph) {}
     ~Inlining() = default;
 
     void Run();
 
+    // New blocks are created and calls are moved to them.
+    static constexpr AnalysisSet PRESERVED_ANALYSES {};
+
+    // Whether a callee of `calleeSize` instructions is worth inlining at the call site of `frequency`, relative to
+    // the start of the caller, `depth` is the number of methods inlined on the way to the call site.
+    static bool IsProfitable(size_t calleeSize, double frequency, uint32_t depth);
+
+private:
+    struct CallSite {
+        CallStaticInsn *call {nullptr};
+        double frequency {0.0};
+        uint32_t depth {0};
+        size_t frame {0};
+    };
+
+    // Method whose body the call site belongs to, frames chain up to the caller.
+    struct Frame {
+        size_t methodId {0};
+        size_t parent {0};
+    };
+
+    bool IsRecursive(size_t methodId, size_t frame) const;
+    void InlineCall(const CallSite &site, Graph *callee);
+
 private:
     Graph *graph_ {nullptr};
+
+    std::vector<CallSite> callSites_;
+    std::vector<Frame> frames_;
 };
 
 }  // namespace compiler
 
-#endif  // OPTIMIZATIONS_PEEPHOLES_H
+#endif  // OPTIMIZATIONS_INLINING_H
@@ -0,0 +1,167 @@
+#include "optimizations/pass_manager.h"
+#include "optimizations/check_elimination.h"
+#include "optimizations/dead_code_elimination.h"
+#include "optimizations/gvn.h"
+#include "optimizations/inlining.h"
+#include "optimizations/peepholes.h"
+#include "optimizations/sccp.h"
+#include "ir/graph.h"
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <string>
+
+namespace compiler {
+
+std::string_view PassManager::GetPassName(PassId pass)
+{
+    switch (pass) {
+#define PASS_MACROS(ID, PassType, name) \
+    case PassId::ID:                    \
+        return name;
+#include "optimizations/passes.def"
+#undef PASS_MACROS
+        default:
+            UNREACHABLE();
+    }
+}
+
+bool PassManager::SetPipeline(std::string_view pipeline, std::string_view *unknownPass)
+{
+    static constexpr std::array PASSES {
+#define PASS_MACROS(ID, PassType, name) PassId::ID,
+#include "optimizations/passes.def"
+#undef PASS_MACROS
+    };
+
+    std::vector<PassId> newPipeline;
+    while (!pipeline.empty()) {
+        auto delimPos = pipeline.find(',');
+        auto passName = pipeline.substr(0, delimPos);
+        pipeline.remove_prefix(delimPos == std::string_view::npos ? pipeline.size() : delimPos + 1);
+
+        auto passIt = std::find_if(PASSES.begin(), PASSES.end(),
+                                   [passName](PassId pass) { return GetPassName(pass) == passName; });
+        if (passIt == PASSES.end()) {
+            if (unknownPass != nullptr) {
+                *unknownPass = passName;
+            }
+            return false;
+        }
+        newPipeline.push_back(*passIt);
+    }
+
+    pipeline_ = std::move(newPipeline);
+    return true;
+}
+
+bool PassManager::Run()
+{
+    statistics_.clear();
+    budgetExceeded_ = false;
+
+    auto *allocator = graph_->GetAllocator();
+    std::chrono::nanoseconds totalTime {0};
+
+    for (auto pass : pipeline_) {
+        if (totalTime >= timeBudget_) {
+            budgetExceeded_ = true;
+            return false;
+        }
+
+        auto &stats = statistics_.emplace_back();
+        stats.pass = pass;
+        stats.insnsBefore = CountInsns();
+        stats.blocksBefore = graph_->GetAliveBlockCount();
+        auto allocatedBefore = allocator->GetAllocatedSize();
+
+        auto start = std::chrono::steady_clock::now();
+        RunPass(pass);
+        stats.time = std::chrono::steady_clock::now() - start;
+
+        stats.bytesAllocated = allocator->GetAllocatedSize() - allocatedBefore;
+        stats.insnsAfter = CountInsns();
+        stats.blocksAfter = graph_->GetAliveBlockCount();
+        totalTime += stats.time;
+    }
+    return true;
+}
+
+std::chrono::nanoseconds PassManager::GetTotalTime() const
+{
+    std::chrono::nanoseconds totalTime {0};
+    for (auto &stats : statistics_) {
+        totalTime += stats.time;
+    }
+    return totalTime;
+}
+
+// Counts before and after a pass, as a single cell of the table.
+static std::string FormatChange(size_t before, size_t after)
+{
+    return std::to_string(before) + " -> " + std::to_string(after);
+}
+
+void PassManager::DumpStatistics(std::stringstream &ss) const
+{
+    ss << std::left << std::setw(16) << "pass" << std::right << std::setw(12) << "time, us" << std::setw(12)
+       << "insns" << std::setw(12) << "blocks" << std::setw(12) << "bytes" << "\n";
+
+    for (auto &stats : statistics_) {
+        ss << std::left << std::setw(16) << GetPassName(stats.pass) << std::right << std::fixed
+           << std::setprecision(1) << std::setw(12) << static_cast<double>(stats.time.count()) / 1000
+           << std::setw(12) << FormatChange(stats.insnsBefore, stats.insnsAfter) << std::setw(12)
+           << FormatChange(stats.blocksBefore, stats.blocksAfter) << std::setw(12) << stats.bytesAllocated << "\n";
+    }
+
+    ss << std::left << std::setw(16) << "total" << std::right << std::setw(12)
+       << static_cast<double>(GetTotalTime().count()) / 1000 << "\n";
+    if (budgetExceeded_) {
+        ss << "budget exceeded, " << pipeline_.size() - statistics_.size() << " passes skipped\n";
+    }
+}
+
+void PassManager::DumpStatisticsJson(std::stringstream &ss) const
+{
+    ss << "{\"passes\": [";
+    for (size_t idx = 0; idx < statistics_.size(); ++idx) {
+        auto &stats = statistics_[idx];
+        ss << (idx == 0 ? "" : ", ") << "{\"name\": \"" << GetPassName(stats.pass)
+           << "\", \"time_ns\": " << stats.time.count() << ", \"insns_before\": " << stats.insnsBefore
+           << ", \"insns_after\": " << stats.insnsAfter << ", \"blocks_before\": " << stats.blocksBefore
+           << ", \"blocks_after\": " << stats.blocksAfter << ", \"bytes_allocated\": " << stats.bytesAllocated << "}";
+    }
+    ss << "], \"total_time_ns\": " << GetTotalTime().count()
+       << ", \"budget_exceeded\": " << (budgetExceeded_ ? "true" : "false") << "}";
+}
+
+void PassManager::RunPass(PassId pass)
+{
+    switch (pass) {
+#define PASS_MACROS(ID, PassType, name) \
+    case PassId::ID: {                  \
+        PassType passImpl(graph_);      \
+        passImpl.Run();                 \
+        break;                          \
+    }
+#include "optimizations/passes.def"
+#undef PASS_MACROS
+        default:
+            UNREACHABLE();
+    }
+}
+
+size_t PassManager::CountInsns() const
+{
+    size_t insnsCount = 0;
+    for (auto *block : graph_->GetBlocks()) {
+        block->EnumerateInsns([&insnsCount](Instruction *) {
+            ++insnsCount;
+            return false;
+        });
+    }
+    return insnsCount;
+}
+
+}  // namespace compiler
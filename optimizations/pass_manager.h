@@ -0,0 +1,96 @@
+#ifndef OPTIMIZATIONS_PASS_MANAGER_H
+#define OPTIMIZATIONS_PASS_MANAGER_H
+
+#include "utils/macros.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace compiler {
+
+class Graph;
+
+enum class PassId : uint8_t {
+#define PASS_MACROS(ID, PassType, name) ID,
+#include "optimizations/passes.def"
+#undef PASS_MACROS
+};
+
+struct PassStatistics final {
+    PassId pass {};
+    std::chrono::nanoseconds time {0};
+    size_t insnsBefore {0};
+    size_t insnsAfter {0};
+    size_t blocksBefore {0};
+    size_t blocksAfter {0};
+    // Arena memory taken by the pass, nothing is returned to the arena until the graph dies.
+    size_t bytesAllocated {0};
+};
+
+// Runs a pipeline of passes over the graph and collects statistics for every pass.
+class PassManager final {
+public:
+    NO_COPY_SEMANTIC(PassManager);
+    NO_MOVE_SEMANTIC(PassManager);
+
+    explicit PassManager(Graph *graph) : graph_(graph) {}
+    ~PassManager() = default;
+
+    static std::string_view GetPassName(PassId pass);
+
+    // Comma-separated pass names, e.g. "peepholes,check-elim".
+    // Returns false and keeps the current pipeline if some pass is unknown, its name is stored to `unknownPass`
+    // if given, as a view into `pipeline`.
+    bool SetPipeline(std::string_view pipeline, std::string_view *unknownPass = nullptr);
+
+    void AddPass(PassId pass)
+    {
+        pipeline_.push_back(pass);
+    }
+
+    // Remaining passes are skipped once passes of the pipeline took longer than the budget.
+    void SetTimeBudget(std::chrono::nanoseconds budget)
+    {
+        timeBudget_ = budget;
+    }
+
+    // Returns false if the pipeline was interrupted by the budget.
+    bool Run();
+
+    bool IsBudgetExceeded() const
+    {
+        return budgetExceeded_;
+    }
+
+    // One entry for each pass which was run.
+    const std::vector<PassStatistics> &GetStatistics() const
+    {
+        return statistics_;
+    }
+
+    std::chrono::nanoseconds GetTotalTime() const;
+
+    void DumpStatistics(std::stringstream &ss) const;
+    void DumpStatisticsJson(std::stringstream &ss) const;
+
+private:
+    void RunPass(PassId pass);
+    size_t CountInsns() const;
+
+private:
+    Graph *graph_ {nullptr};
+
+    std::vector<PassId> pipeline_;
+    std::chrono::nanoseconds timeBudget_ {std::chrono::nanoseconds::max()};
+
+    std::vector<PassStatistics> statistics_;
+    bool budgetExceeded_ {false};
+};
+
+}  // namespace compiler
+
+#endif  // OPTIMIZATIONS_PASS_MANAGER_H
@@ -1,5 +1,4 @@
 #include "optimizations/peepholes.h"
-#include "analysis/dominator_tree.h"
 #include "ir/instructions.h"
 #include "ir/helpers.h"
 
@@ -7,8 +6,7 @@ namespace compiler {
 
 void Peepholes::Run()
 {
-    DominatorTree tree(graph_);
-    tree.Build();
+    graph_->GetAnalysisManager()->Run(AnalysisType::RPO);
 
     auto &blocks = graph_->GetRpoVector();
     for (auto *block : blocks) {
@@ -19,20 +17,22 @@ void Peepholes::Run()
             return false;
         });
     }
+
+    graph_->GetAnalysisManager()->Invalidate(PRESERVED_ANALYSES);
 }
 
 void Peepholes::VisitMul(Instruction *insn)
 {
-    if (ConstantFoldingMul(insn)) {
+    if (ConstantFolding(insn)) {
         return;
     }
 
-    if (insn->GetInputs()->GetInput(0)->IsConst()) {
-        insn->GetInputs()->SwapInputs();
+    if (insn->GetInput(0)->IsConst()) {
+        insn->SwapInputs();
     }
 
-    auto *input0 = insn->GetInputs()->GetInput(0);
-    auto *input1 = insn->GetInputs()->GetInput(1);
+    auto *input0 = insn->GetInput(0);
+    auto *input1 = insn->GetInput(1);
 
     if (input1->IsConst()) {
         auto *constInput1 = input1->AsConst();
@@ -46,26 +46,7 @@ void Peepholes::VisitMul(Instruction *insn)
             // ...
             // 3.u64 mul v2, v0
             // 4.u64 add v2, v0
-            auto &currInsnUsers = insn->GetUsers();
-            auto userIt = currInsnUsers.begin();
-            while (userIt != currInsnUsers.end()) {
-                auto *user = *userIt;
-                bool needRemoveUser = false;
-
-                if (user->GetInputs()->GetInput(0) == insn) {
-                    user->GetInputs()->SetInput(input0, 0);
-                    needRemoveUser = true;
-                }
-                if (user->GetInputs()->GetInput(1) == insn) {
-                    user->GetInputs()->SetInput(input0, 1);
-                    needRemoveUser = true;
-                }
-                if (needRemoveUser) {
-                    userIt = insn->RemoveUser(userIt);
-                } else {
-                    ++userIt;
-                }
-            }
+            insn->ReplaceInputsForUsers(input0);
         } else if (constInput1->IsEqualTo(2)) {
             // 0.u64 Constant 2
             // 1. ...
@@ -84,12 +65,12 @@ void Peepholes::VisitMul(Instruction *insn)
 
 void Peepholes::VisitAshr(Instruction *insn)
 {
-    if (ConstantFoldingAshr(insn)) {
+    if (ConstantFolding(insn)) {
         return;
     }
 
-    auto *input0 = insn->GetInputs()->GetInput(0);
-    auto *input1 = insn->GetInputs()->GetInput(1);
+    auto *input0 = insn->GetInput(0);
+    auto *input1 = insn->GetInput(1);
 
     if (input1->IsConst()) {
         auto *input1AsConst = input1->AsConst();
@@ -118,9 +99,9 @@ void Peepholes::VisitAshr(Instruction *insn)
         // 3. ashr v2, v0   <-- this insn will be deleted by dead code elimination if it has no more users
         // 5.u64 Constant zzz (xxx + yyy = v0 + v1)
         // 4. ashr v2, v5
-        if (input0->GetOpcode() == Opcode::ASHR && input0->GetInputs()->GetInput(1)->IsConst()) {
-            auto *input0FromPrevInsn = input0->GetInputs()->GetInput(0);
-            auto *input1FromPrevInsnAsConst = input0->GetInputs()->GetInput(1)->AsConst();
+        if (input0->GetOpcode() == Opcode::ASHR && input0->GetInput(1)->IsConst()) {
+            auto *input0FromPrevInsn = input0->GetInput(0);
+            auto *input1FromPrevInsnAsConst = input0->GetInput(1)->AsConst();
 
             if (input1FromPrevInsnAsConst->GetType() == input1AsConst->GetType()) {
                 auto newConstType = input1AsConst->GetType();
@@ -131,12 +112,8 @@ void Peepholes::VisitAshr(Instruction *insn)
 
                 insn->GetParentBB()->InsertInstruction(insn, newConstInsn);
 
-                input0->RemoveUser(insn);
-                input0FromPrevInsn->AddUser(insn);
-                newConstInsn->AddUser(insn);
-
-                insn->GetInputs()->SetInput(input0FromPrevInsn, 0);
-                insn->GetInputs()->SetInput(newConstInsn, 1);
+                insn->SetInput(input0FromPrevInsn, 0);
+                insn->SetInput(newConstInsn, 1);
                 return;
             }
         }
@@ -145,16 +122,16 @@ void Peepholes::VisitAshr(Instruction *insn)
 
 void Peepholes::VisitOr(Instruction *insn)
 {
-    if (ConstantFoldingOr(insn)) {
+    if (ConstantFolding(insn)) {
         return;
     }
 
-    if (insn->GetInputs()->GetInput(0)->IsConst()) {
-        insn->GetInputs()->SwapInputs();
+    if (insn->GetInput(0)->IsConst()) {
+        insn->SwapInputs();
     }
 
-    auto *input0 = insn->GetInputs()->GetInput(0);
-    auto *input1 = insn->GetInputs()->GetInput(1);
+    auto *input0 = insn->GetInput(0);
+    auto *input1 = insn->GetInput(1);
 
     if (input1->IsConst()) {
         auto *input1AsConst = input1->AsConst();
@@ -182,15 +159,48 @@ void Peepholes::VisitOr(Instruction *insn)
     }
 }
 
+// Other arithmetic is only folded.
+void Peepholes::VisitAdd(Instruction *insn)
+{
+    ConstantFolding(insn);
+}
+
+void Peepholes::VisitSub(Instruction *insn)
+{
+    ConstantFolding(insn);
+}
+
+void Peepholes::VisitDiv(Instruction *insn)
+{
+    ConstantFolding(insn);
+}
+
+void Peepholes::VisitRem(Instruction *insn)
+{
+    ConstantFolding(insn);
+}
+
+void Peepholes::VisitAnd(Instruction *insn)
+{
+    ConstantFolding(insn);
+}
+
+void Peepholes::VisitXor(Instruction *insn)
+{
+    ConstantFolding(insn);
+}
+
+void Peepholes::VisitShr(Instruction *insn)
+{
+    ConstantFolding(insn);
+}
+
+void Peepholes::VisitShl(Instruction *insn)
+{
+    ConstantFolding(insn);
+}
+
 void Peepholes::VisitUndefined([[maybe_unused]] Instruction *insn) {}
-void Peepholes::VisitAdd([[maybe_unused]] Instruction *insn) {}
-void Peepholes::VisitSub([[maybe_unused]] Instruction *insn) {}
-void Peepholes::VisitDiv([[maybe_unused]] Instruction *insn) {}
-void Peepholes::VisitRem([[maybe_unused]] Instruction *insn) {}
-void Peepholes::VisitAnd([[maybe_unused]] Instruction *insn) {}
-void Peepholes::VisitXor([[maybe_unused]] Instruction *insn) {}
-void Peepholes::VisitShr([[maybe_unused]] Instruction *insn) {}
-void Peepholes::VisitShl([[maybe_unused]] Instruction *insn) {}
 void Peepholes::VisitJmp([[maybe_unused]] Instruction *insn) {}
 void Peepholes::VisitBeq([[maybe_unused]] Instruction *insn) {}
 void Peepholes::VisitBne([[maybe_unused]] Instruction *insn) {}
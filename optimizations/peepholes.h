@@ -16,7 +16,10 @@ public:
 
     void Run();
 
-#define OPCODE_MACROS(_, instrType) void Visit##instrType(Instruction *insn);
+    // Instructions are rewritten inside their blocks, CFG is kept.
+    static constexpr AnalysisSet PRESERVED_ANALYSES = CFG_ANALYSES;
+
+#define OPCODE_MACROS(instr, instrType, inputsCount) void Visit##instrType(Instruction *insn);
 #include "ir/instruction_type.def"
 #undef OPCODE_MACROS
 
@@ -25,15 +28,14 @@ private:
 
     using VisitMethodType = void (compiler::Peepholes::*)(Instruction *insn);
 
-#define OPCODE_MACROS(_, instrType) &Peepholes::Visit##instrType,
-    std::array<VisitMethodType, 26U> opcodeToVisitTable_ {
+#define OPCODE_MACROS(instr, instrType, inputsCount) &Peepholes::Visit##instrType,
+    std::array<VisitMethodType, OPCODES_COUNT> opcodeToVisitTable_ {
 #include "ir/instruction_type.def"
     };
 #undef OPCODE_MACROS
 
-    bool ConstantFoldingMul(Instruction *insn);
-    bool ConstantFoldingOr(Instruction *insn);
-    bool ConstantFoldingAshr(Instruction *insn);
+    // Replaces the arithmetic, bitwise or shift instruction over constants with its value.
+    bool ConstantFolding(Instruction *insn);
 };
 
 }  // namespace compiler
@@ -0,0 +1,312 @@
+#include "optimizations/sccp.h"
+#include "ir/instructions.h"
+#include "optimizations/constant_folding.h"
+
+namespace compiler {
+
+static bool IsIntegerType(DataType type)
+{
+    switch (type) {
+        case DataType::I8:
+        case DataType::U8:
+        case DataType::I16:
+        case DataType::U16:
+        case DataType::I32:
+        case DataType::U32:
+        case DataType::I64:
+        case DataType::U64:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool IsUnsignedType(DataType type)
+{
+    return type == DataType::U8 || type == DataType::U16 || type == DataType::U32 || type == DataType::U64;
+}
+
+static bool IsBranchTaken(const Instruction *branch, int64_t lhs, int64_t rhs)
+{
+    switch (branch->GetOpcode()) {
+        case Opcode::BEQ:
+            return lhs == rhs;
+        case Opcode::BNE:
+            return lhs != rhs;
+        case Opcode::BGT:
+            if (IsUnsignedType(branch->GetInput(0)->GetResultType())) {
+                return static_cast<uint64_t>(lhs) > static_cast<uint64_t>(rhs);
+            }
+            return lhs > rhs;
+        default:
+            UNREACHABLE();
+    }
+}
+
+// Puts the constant in place of the instruction, after the phis if the instruction is a phi.
+static void ReplaceWithConstant(Graph *graph, Instruction *insn, int64_t value)
+{
+    auto *constant = CreateFoldedConstant(graph, insn->GetResultType(), static_cast<uint64_t>(value));
+
+    auto *prev = insn->GetPrev();
+    if (insn->IsPhi()) {
+        prev = insn;
+        while (prev->GetNext() != nullptr && prev->GetNext()->IsPhi()) {
+            prev = prev->GetNext();
+        }
+    }
+
+    auto *block = insn->GetParentBB();
+    block->InsertInstruction(prev, constant);
+    insn->ReplaceInputsForUsers(constant);
+    block->Remove(insn);
+}
+
+void Sccp::Run()
+{
+    values_ = InsnSideTable<LatticeValue>(graph_);
+    blocks_ = BlockSideTable<BlockState>(graph_);
+
+    Propagate();
+
+    bool isChanged = ReplaceConstants();
+    if (FoldBranches()) {
+        graph_->RemoveUnreachableBlocks();
+        isChanged = true;
+    }
+
+    if (isChanged) {
+        graph_->GetAnalysisManager()->Invalidate(PRESERVED_ANALYSES);
+    }
+}
+
+void Sccp::Propagate()
+{
+    VisitBlock(graph_->GetStartBlock());
+
+    // Instructions are visited only in executable blocks, the rest are visited once their block becomes executable.
+    while (!blockWorklist_.empty() || !insnWorklist_.empty()) {
+        if (!blockWorklist_.empty()) {
+            auto *block = blockWorklist_.back();
+            blockWorklist_.pop_back();
+            VisitBlock(block);
+            continue;
+        }
+
+        auto *insn = insnWorklist_.back();
+        insnWorklist_.pop_back();
+        if (blocks_[insn->GetParentBB()].isExecutable) {
+            VisitInsn(insn);
+        }
+    }
+}
+
+void Sccp::AddEdge(BasicBlock *from, BasicBlock *to)
+{
+    const auto &successors = from->GetSuccessors();
+    auto &edges = blocks_[from].edges;
+    bool isAdded = false;
+    for (size_t idx = 0; idx < successors.size(); ++idx) {
+        if (successors[idx] == to && !edges[idx]) {
+            edges[idx] = true;
+            isAdded = true;
+        }
+    }
+    if (isAdded) {
+        blockWorklist_.push_back(to);
+    }
+}
+
+bool Sccp::IsEdgeExecutable(BasicBlock *from, BasicBlock *to)
+{
+    const auto &successors = from->GetSuccessors();
+    const auto &edges = blocks_[from].edges;
+    for (size_t idx = 0; idx < successors.size(); ++idx) {
+        if (successors[idx] == to && edges[idx]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Called for each new executable edge to the block, only phis may change when the block is already executable.
+void Sccp::VisitBlock(BasicBlock *block)
+{
+    if (blocks_[block].isExecutable) {
+        for (auto *phi = block->GetFirstInsn(); phi != nullptr && phi->IsPhi(); phi = phi->GetNext()) {
+            VisitInsn(phi);
+        }
+        return;
+    }
+
+    blocks_[block].isExecutable = true;
+    for (auto *insn = block->GetFirstInsn(); insn != nullptr; insn = insn->GetNext()) {
+        VisitInsn(insn);
+    }
+
+    // Control leaves the block through every successor, unless the branch is resolved.
+    auto *last = block->GetLastInsn();
+    if (last == nullptr || !last->IsBranch()) {
+        for (auto *succ : block->GetSuccessors()) {
+            AddEdge(block, succ);
+        }
+    }
+}
+
+void Sccp::VisitInsn(Instruction *insn)
+{
+    if (insn->IsBranch()) {
+        VisitBranch(insn);
+        return;
+    }
+    if (!insn->HasResult()) {
+        return;
+    }
+
+    auto &current = values_[insn];
+    if (current.kind == LatticeValue::Kind::OVERDEFINED) {
+        return;
+    }
+    auto value = Evaluate(insn);
+    if (value == current) {
+        return;
+    }
+
+    current = value;
+    for (auto *user : insn->GetUsers()) {
+        insnWorklist_.push_back(user);
+    }
+}
+
+void Sccp::VisitBranch(Instruction *branch)
+{
+    auto lhs = values_[branch->GetInput(0)];
+    auto rhs = values_[branch->GetInput(1)];
+    if (lhs.kind == LatticeValue::Kind::UNDEFINED || rhs.kind == LatticeValue::Kind::UNDEFINED) {
+        return;
+    }
+
+    auto *block = branch->GetParentBB();
+    auto *ifTrueBB = static_cast<BranchInsn *>(branch)->GetTrueBranchBB();
+    auto *ifFalseBB = static_cast<BranchInsn *>(branch)->GetFalseBranchBB();
+    if (lhs.IsConstant() && rhs.IsConstant()) {
+        AddEdge(block, IsBranchTaken(branch, lhs.value, rhs.value) ? ifTrueBB : ifFalseBB);
+        return;
+    }
+    AddEdge(block, ifTrueBB);
+    AddEdge(block, ifFalseBB);
+}
+
+Sccp::LatticeValue Sccp::Evaluate(Instruction *insn)
+{
+    auto type = insn->GetResultType();
+    if (!IsIntegerType(type)) {
+        return LatticeValue::Overdefined();
+    }
+
+    switch (insn->GetOpcode()) {
+        case Opcode::CONSTANT: {
+            auto value = GetConstantOperand(insn->AsConst(), type);
+            if (!value) {
+                return LatticeValue::Overdefined();
+            }
+            return {LatticeValue::Kind::CONSTANT, static_cast<int64_t>(*value)};
+        }
+        case Opcode::PHI:
+            return EvaluatePhi(insn);
+        case Opcode::ADD:
+        case Opcode::SUB:
+        case Opcode::MUL:
+        case Opcode::DIV:
+        case Opcode::REM:
+        case Opcode::AND:
+        case Opcode::OR:
+        case Opcode::XOR:
+        case Opcode::ASHR:
+        case Opcode::SHR:
+        case Opcode::SHL: {
+            auto lhs = values_[insn->GetInput(0)];
+            auto rhs = values_[insn->GetInput(1)];
+            if (lhs.kind == LatticeValue::Kind::OVERDEFINED || rhs.kind == LatticeValue::Kind::OVERDEFINED) {
+                return LatticeValue::Overdefined();
+            }
+            if (!lhs.IsConstant() || !rhs.IsConstant()) {
+                return {};
+            }
+            auto result = FoldBinaryOperation(insn->GetOpcode(), type, static_cast<uint64_t>(lhs.value),
+                                              static_cast<uint64_t>(rhs.value));
+            if (!result) {
+                return LatticeValue::Overdefined();
+            }
+            return {LatticeValue::Kind::CONSTANT, static_cast<int64_t>(*result)};
+        }
+        default:
+            return LatticeValue::Overdefined();
+    }
+}
+
+// Meet of the values coming along executable edges.
+Sccp::LatticeValue Sccp::EvaluatePhi(Instruction *phi)
+{
+    auto *block = phi->GetParentBB();
+    LatticeValue result;
+    for (const auto &dependency : static_cast<PhiInsn *>(phi)->GetDependencies()) {
+        if (!IsEdgeExecutable(dependency.block, block)) {
+            continue;
+        }
+        const auto &value = values_[dependency.value];
+        if (value.kind == LatticeValue::Kind::UNDEFINED) {
+            continue;
+        }
+        if (result.kind != LatticeValue::Kind::UNDEFINED && result != value) {
+            return LatticeValue::Overdefined();
+        }
+        result = value;
+    }
+    return result;
+}
+
+bool Sccp::ReplaceConstants()
+{
+    bool isChanged = false;
+    for (auto *block : graph_->GetBlocks()) {
+        if (!blocks_[block].isExecutable) {
+            continue;
+        }
+        block->EnumerateInsns([this, &isChanged](Instruction *insn) {
+            if (insn->GetOpcode() != Opcode::CONSTANT && !insn->GetUsers().empty() && values_[insn].IsConstant()) {
+                ReplaceWithConstant(graph_, insn, values_[insn].value);
+                isChanged = true;
+            }
+            return false;
+        });
+    }
+    return isChanged;
+}
+
+// Branches with a single executable edge become jumps along it.
+bool Sccp::FoldBranches()
+{
+    bool isChanged = false;
+    for (auto *block : graph_->GetBlocks()) {
+        auto *branch = block->GetLastInsn();
+        if (!blocks_[block].isExecutable || branch == nullptr || !branch->IsBranch()) {
+            continue;
+        }
+
+        auto *ifTrueBB = static_cast<BranchInsn *>(branch)->GetTrueBranchBB();
+        auto *ifFalseBB = static_cast<BranchInsn *>(branch)->GetFalseBranchBB();
+        bool isTrueTaken = IsEdgeExecutable(block, ifTrueBB);
+        if (ifTrueBB == ifFalseBB || isTrueTaken == IsEdgeExecutable(block, ifFalseBB)) {
+            continue;
+        }
+
+        block->Remove(branch);
+        block->PushInstruction(graph_->CreateInsn<JmpInsn>(isTrueTaken ? ifTrueBB : ifFalseBB));
+        block->RemoveSuccessor(isTrueTaken ? ifFalseBB : ifTrueBB);
+        isChanged = true;
+    }
+    return isChanged;
+}
+
+}  // namespace compiler
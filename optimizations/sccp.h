@@ -0,0 +1,86 @@
+#ifndef OPTIMIZATIONS_SCCP_H
+#define OPTIMIZATIONS_SCCP_H
+
+#include "utils/macros.h"
+#include "ir/graph.h"
+#include "ir/side_table.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace compiler {
+
+// Sparse conditional constant propagation (Wegman and Zadeck). Integer values are evaluated over the lattice
+// undefined > constant > overdefined, blocks are visited only once an edge to them is found executable, and phis
+// merge only the values coming along executable edges. So constants propagate through loops and through
+// branches which are resolved by constants.
+//
+// Afterwards values known to be constant are replaced with constants, resolved branches become jumps
+// and blocks which are not reachable anymore are removed.
+class Sccp final {
+public:
+    NO_COPY_SEMANTIC(Sccp);
+    NO_MOVE_SEMANTIC(Sccp);
+
+    Sccp(Graph *graph) : graph_(graph) {}
+    ~Sccp() = default;
+
+    void Run();
+
+    // Branches and blocks are removed.
+    static constexpr AnalysisSet PRESERVED_ANALYSES {};
+
+private:
+    struct LatticeValue {
+        enum class Kind { UNDEFINED, CONSTANT, OVERDEFINED };
+
+        Kind kind {Kind::UNDEFINED};
+        // Value extended from the width of the type, as in ConstantInsn.
+        int64_t value {0};
+
+        static LatticeValue Overdefined()
+        {
+            return {Kind::OVERDEFINED};
+        }
+
+        bool IsConstant() const
+        {
+            return kind == Kind::CONSTANT;
+        }
+
+        bool operator==(const LatticeValue &other) const = default;
+    };
+
+    struct BlockState {
+        bool isExecutable {false};
+        // Executable edges to the successors, by their positions in the successors list.
+        std::array<bool, 2U> edges {};
+    };
+
+    void Propagate();
+    void AddEdge(BasicBlock *from, BasicBlock *to);
+    bool IsEdgeExecutable(BasicBlock *from, BasicBlock *to);
+    void VisitBlock(BasicBlock *block);
+    void VisitInsn(Instruction *insn);
+    void VisitBranch(Instruction *branch);
+    LatticeValue Evaluate(Instruction *insn);
+    LatticeValue EvaluatePhi(Instruction *phi);
+
+    bool ReplaceConstants();
+    bool FoldBranches();
+
+private:
+    Graph *graph_ {nullptr};
+
+    InsnSideTable<LatticeValue> values_;
+    BlockSideTable<BlockState> blocks_;
+
+    // Targets of the edges which became executable.
+    std::vector<BasicBlock *> blockWorklist_;
+    std::vector<Instruction *> insnWorklist_;
+};
+
+}  // namespace compiler
+
+#endif  // OPTIMIZATIONS_SCCP_H
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "analysis/alias_analysis.h"
+#include "ir/ir_builder-inl.h"
+
+namespace compiler::tests {
+
+TEST(AliasAnalysis, Arrays)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *param0 = builder.CreateParameterInsn(0, DataType::REF);
+    auto *param1 = builder.CreateParameterInsn(1, DataType::REF);
+    auto *zero = builder.CreateInt32ConstantInsn(0);
+    auto *value = builder.CreateInt32ConstantInsn(7);
+    auto *arr0 = builder.CreateNewArrInsn(DataType::I32, 8);
+    auto *arr1 = builder.CreateNewArrInsn(DataType::I32, 8);
+    auto *checked = builder.CreateNullcheckInsn(arr0);
+
+    auto *store0 = builder.CreateStoreArrayInsn(DataType::I32, arr0, zero, value);
+    auto *load0 = builder.CreateLoadArrayInsn(DataType::I32, checked, zero);
+    auto *load1 = builder.CreateLoadArrayInsn(DataType::I32, arr1, zero);
+    auto *loadParam0 = builder.CreateLoadArrayInsn(DataType::I32, param0, zero);
+    auto *loadParam1 = builder.CreateLoadArrayInsn(DataType::I32, param1, zero);
+    auto *loadF64 = builder.CreateLoadArrayInsn(DataType::F64, param0, zero);
+    // Array loaded from another array may be any of the arrays.
+    auto *loadedRef = builder.CreateLoadArrayInsn(DataType::REF, param1, zero);
+    auto *loadLoaded = builder.CreateLoadArrayInsn(DataType::I32, loadedRef, zero);
+    builder.CreateRetInsn(DataType::I32, load0);
+
+    const auto &aliases = graph.GetAnalysisManager()->GetAliasAnalysis();
+
+    ASSERT_EQ(aliases.CheckAlias(store0, load0), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(store0, load1), AliasResult::NO_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(store0, loadParam0), AliasResult::NO_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(loadParam0, loadParam1), AliasResult::NO_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(loadParam0, loadF64), AliasResult::NO_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(store0, loadLoaded), AliasResult::MAY_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(loadParam0, loadLoaded), AliasResult::MAY_ALIAS);
+}
+
+TEST(AliasAnalysis, ConstantOffsets)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *arr = builder.CreateParameterInsn(0, DataType::REF);
+    auto *idx = builder.CreateParameterInsn(1, DataType::I32);
+    auto *other = builder.CreateParameterInsn(2, DataType::I32);
+    auto *len = builder.CreateParameterInsn(3, DataType::I32);
+    auto *one = builder.CreateInt32ConstantInsn(1);
+    auto *two = builder.CreateInt32ConstantInsn(2);
+    auto *three = builder.CreateInt32ConstantInsn(3);
+
+    auto *next = builder.CreateAddInsn(DataType::I32, idx, one);
+    auto *nextSwapped = builder.CreateAddInsn(DataType::I32, one, idx);
+    auto *checked = builder.CreateBoundsCheckInsn(arr, nextSwapped, len);
+    auto *prev = builder.CreateSubInsn(DataType::I32, next, two);
+
+    auto *store = builder.CreateStoreArrayInsn(DataType::I32, arr, idx, one);
+    auto *loadNext = builder.CreateLoadArrayInsn(DataType::I32, arr, next);
+    auto *loadChecked = builder.CreateLoadArrayInsn(DataType::I32, arr, checked);
+    auto *loadPrev = builder.CreateLoadArrayInsn(DataType::I32, arr, prev);
+    auto *loadOther = builder.CreateLoadArrayInsn(DataType::I32, arr, other);
+    auto *load2 = builder.CreateLoadArrayInsn(DataType::I32, arr, two);
+    auto *load3 = builder.CreateLoadArrayInsn(DataType::I32, arr, three);
+    builder.CreateRetInsn(DataType::I32, loadNext);
+
+    const auto &aliases = graph.GetAnalysisManager()->GetAliasAnalysis();
+
+    ASSERT_EQ(aliases.CheckAlias(store, loadNext), AliasResult::NO_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(loadNext, loadChecked), AliasResult::MUST_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(store, loadPrev), AliasResult::NO_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(store, loadOther), AliasResult::MAY_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(load2, load3), AliasResult::NO_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(store, load2), AliasResult::MAY_ALIAS);
+}
+
+/*
+    for (int32_t i = 0; i < n; ++i) {
+        a[2 * i] = a[2 * i + 1];
+    }
+    a[i] = a[i_last + 1];
+
+    In the loop the variables are compared within an iteration; after the loop `i` is the value of the next
+    iteration, so it equals the last increment.
+*/
+TEST(AliasAnalysis, InductionVariables)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *headerBB = builder.CreateBB();
+    auto *bodyBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *arr = builder.CreateParameterInsn(0, DataType::REF);
+    auto *len = builder.CreateParameterInsn(1, DataType::I32);
+    auto *zero = builder.CreateInt32ConstantInsn(0);
+    auto *one = builder.CreateInt32ConstantInsn(1);
+    auto *two = builder.CreateInt32ConstantInsn(2);
+    builder.CreateJmpInsn(headerBB);
+
+    builder.SetBasicBlockScope(headerBB);
+    auto *idx = builder.CreatePhiInsn(DataType::I32);
+    builder.CreateBgtInsn(len, idx, bodyBB, exitBB);
+
+    builder.SetBasicBlockScope(bodyBB);
+    auto *even = builder.CreateMulInsn(DataType::I32, idx, two);
+    auto *evenCopy = builder.CreateMulInsn(DataType::I32, two, idx);
+    auto *odd = builder.CreateAddInsn(DataType::I32, evenCopy, one);
+    auto *load = builder.CreateLoadArrayInsn(DataType::I32, arr, odd);
+    auto *store = builder.CreateStoreArrayInsn(DataType::I32, arr, even, load);
+    auto *inc = builder.CreateAddInsn(DataType::I32, idx, one);
+    builder.CreateJmpInsn(headerBB);
+
+    idx->ResolveDependency(zero, entryBB);
+    idx->ResolveDependency(inc, bodyBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    auto *loadAfter = builder.CreateLoadArrayInsn(DataType::I32, arr, inc);
+    auto *storeAfter = builder.CreateStoreArrayInsn(DataType::I32, arr, idx, loadAfter);
+    builder.CreateRetInsn(DataType::I32, loadAfter);
+
+    const auto &aliases = graph.GetAnalysisManager()->GetAliasAnalysis();
+
+    ASSERT_EQ(aliases.CheckAlias(load, store), AliasResult::NO_ALIAS);
+    ASSERT_EQ(aliases.CheckAlias(loadAfter, storeAfter), AliasResult::MAY_ALIAS);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "analysis/analysis_manager.h"
+#include "ir/ir_builder-inl.h"
+#include "optimizations/check_elimination.h"
+#include "optimizations/peepholes.h"
+
+namespace compiler::tests {
+
+/*
+    Graph:
+
+        A
+       / \
+      B   C
+       \ /
+        D
+*/
+static void BuildDiamond(Graph *graph)
+{
+    IrBuilder builder(graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *c = builder.CreateBB();
+    auto *d = builder.CreateBB();
+
+    a->AddSuccessor(b);
+    a->AddSuccessor(c);
+    b->AddSuccessor(d);
+    c->AddSuccessor(d);
+
+    b->AddPredecessor(a);
+    c->AddPredecessor(a);
+    d->AddPredecessor(b);
+    d->AddPredecessor(c);
+
+    builder.SetBasicBlockScope(a);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    builder.CreateMulInsn(DataType::I64, param, one);
+}
+
+TEST(AnalysisManager, Caching)
+{
+    Graph graph;
+    BuildDiamond(&graph);
+    auto *analyses = graph.GetAnalysisManager();
+
+    ASSERT_FALSE(analyses->IsValid(AnalysisType::RPO));
+    analyses->Run(AnalysisType::LOOP_TREE);
+    analyses->Run(AnalysisType::DOMINATOR_TREE);
+    analyses->Run(AnalysisType::LOOP_TREE);
+
+    ASSERT_TRUE(analyses->IsValid(AnalysisType::RPO));
+    ASSERT_TRUE(analyses->IsValid(AnalysisType::DOMINATOR_TREE));
+    ASSERT_TRUE(analyses->IsValid(AnalysisType::LOOP_TREE));
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::RPO), 1);
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::DOMINATOR_TREE), 1);
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::LOOP_TREE), 1);
+    ASSERT_EQ(graph.GetRpoVector().size(), 4);
+}
+
+TEST(AnalysisManager, Invalidation)
+{
+    Graph graph;
+    BuildDiamond(&graph);
+    auto *analyses = graph.GetAnalysisManager();
+
+    analyses->Run(AnalysisType::LOOP_TREE);
+    analyses->Invalidate({AnalysisType::RPO, AnalysisType::LOOP_TREE});
+
+    // Loop tree is preserved, but it is built on top of the dropped dominator tree.
+    ASSERT_TRUE(analyses->IsValid(AnalysisType::RPO));
+    ASSERT_FALSE(analyses->IsValid(AnalysisType::DOMINATOR_TREE));
+    ASSERT_FALSE(analyses->IsValid(AnalysisType::LOOP_TREE));
+
+    analyses->Run(AnalysisType::LOOP_TREE);
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::RPO), 1);
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::DOMINATOR_TREE), 2);
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::LOOP_TREE), 2);
+
+    analyses->Invalidate();
+    ASSERT_FALSE(analyses->IsValid(AnalysisType::RPO));
+    ASSERT_FALSE(analyses->IsValid(AnalysisType::DOMINATOR_TREE));
+    ASSERT_FALSE(analyses->IsValid(AnalysisType::LOOP_TREE));
+}
+
+TEST(AnalysisManager, PassesPreserveAnalyses)
+{
+    Graph graph;
+    BuildDiamond(&graph);
+    auto *analyses = graph.GetAnalysisManager();
+
+    for (size_t idx = 0; idx < 3; ++idx) {
+        Peepholes peepholes(&graph);
+        peepholes.Run();
+        CheckElimination checkElimination(&graph);
+        checkElimination.Run();
+    }
+
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::RPO), 1);
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::DOMINATOR_TREE), 1);
+}
+
+}  // namespace compiler::tests
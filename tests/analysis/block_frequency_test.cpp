@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "analysis/block_frequency.h"
+#include "ir/ir_builder-inl.h"
+
+namespace compiler::tests {
+
+/*
+    Graph:
+
+    A--->B--->D--->F
+    |         ^
+    +--->C----+    E (unreachable)
+*/
+TEST(BlockFrequency, Diamond)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *c = builder.CreateBB();
+    auto *d = builder.CreateBB();
+    auto *e = builder.CreateBB();
+
+    builder.SetBasicBlockScope(a);
+    auto *param = builder.CreateParameterInsn(0);
+    builder.CreateBeqInsn(param, param, b, c);
+    builder.SetBasicBlockScope(b);
+    builder.CreateJmpInsn(d);
+    builder.SetBasicBlockScope(c);
+    builder.CreateJmpInsn(d);
+    builder.SetBasicBlockScope(e);
+    builder.CreateJmpInsn(d);
+    builder.SetBasicBlockScope(d);
+    builder.CreateRetInsn(DataType::U32, param);
+
+    const auto &frequency = graph.GetAnalysisManager()->GetBlockFrequency();
+
+    ASSERT_DOUBLE_EQ(frequency.GetProbability(a, b), 0.5);
+    ASSERT_DOUBLE_EQ(frequency.GetProbability(b, d), 1.0);
+    ASSERT_DOUBLE_EQ(frequency.GetFrequency(a), 1.0);
+    ASSERT_DOUBLE_EQ(frequency.GetFrequency(c), 0.5);
+    ASSERT_DOUBLE_EQ(frequency.GetFrequency(d), 1.0);
+    ASSERT_DOUBLE_EQ(frequency.GetFrequency(e), 0.0);
+}
+
+/*
+    Graph:
+
+    A--->B--->C--->D--->E--->G
+         ^    ^    |    |
+         |    +----+    |
+         |              |
+         +------F<------+
+
+    B exits the outer loop, D is the latch of the inner loop C, E is the latch of the outer loop B.
+*/
+TEST(BlockFrequency, NestedLoops)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *c = builder.CreateBB();
+    auto *d = builder.CreateBB();
+    auto *e = builder.CreateBB();
+    auto *f = builder.CreateBB();
+    auto *g = builder.CreateBB();
+
+    builder.SetBasicBlockScope(a);
+    auto *param = builder.CreateParameterInsn(0);
+    builder.CreateJmpInsn(b);
+    builder.SetBasicBlockScope(b);
+    builder.CreateBeqInsn(param, param, g, c);
+    builder.SetBasicBlockScope(c);
+    builder.CreateJmpInsn(d);
+    builder.SetBasicBlockScope(d);
+    builder.CreateBeqInsn(param, param, c, e);
+    builder.SetBasicBlockScope(e);
+    builder.CreateBeqInsn(param, param, f, g);
+    builder.SetBasicBlockScope(f);
+    builder.CreateJmpInsn(b);
+    builder.SetBasicBlockScope(g);
+    builder.CreateRetInsn(DataType::U32, param);
+
+    const auto &frequency = graph.GetAnalysisManager()->GetBlockFrequency();
+
+    // Inner loop iterates 1 / (1 - 0.88) times per entry.
+    auto innerScale = 1.0 / (1.0 - BlockFrequency::LOOP_BRANCH_PROBABILITY);
+    // Outer loop comes back through C, the inner loop, and the exit branch of E which is unlikely.
+    auto outerCyclic = (1.0 - BlockFrequency::LOOP_EXIT_PROBABILITY) * (1.0 - BlockFrequency::LOOP_EXIT_PROBABILITY);
+    auto outerScale = 1.0 / (1.0 - outerCyclic);
+
+    ASSERT_DOUBLE_EQ(frequency.GetProbability(d, c), BlockFrequency::LOOP_BRANCH_PROBABILITY);
+    ASSERT_DOUBLE_EQ(frequency.GetProbability(b, g), BlockFrequency::LOOP_EXIT_PROBABILITY);
+    ASSERT_DOUBLE_EQ(frequency.GetFrequency(b), outerScale);
+    ASSERT_DOUBLE_EQ(frequency.GetFrequency(c), outerScale * 0.8 * innerScale);
+    ASSERT_DOUBLE_EQ(frequency.GetFrequency(e), outerScale * 0.8);
+    ASSERT_DOUBLE_EQ(frequency.GetFrequency(g), 1.0);
+}
+
+// Measured counts take place of the heuristics, zero counts are ignored.
+TEST(BlockFrequency, EdgeCounts)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *loopBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    builder.CreateJmpInsn(loopBB);
+    builder.SetBasicBlockScope(loopBB);
+    builder.CreateBeqInsn(param, param, loopBB, exitBB);
+    builder.SetBasicBlockScope(exitBB);
+    builder.CreateRetInsn(DataType::U32, param);
+
+    auto *analysisManager = graph.GetAnalysisManager();
+    ASSERT_DOUBLE_EQ(analysisManager->GetBlockFrequency().GetFrequency(loopBB),
+                     1.0 / (1.0 - BlockFrequency::LOOP_BRANCH_PROBABILITY));
+
+    loopBB->SetEdgeCounts(999U, 1U);
+    analysisManager->Invalidate();
+    ASSERT_DOUBLE_EQ(analysisManager->GetBlockFrequency().GetProbability(loopBB, exitBB), 0.001);
+    ASSERT_NEAR(analysisManager->GetBlockFrequency().GetFrequency(loopBB), 1000.0, 1e-6);
+
+    loopBB->SetEdgeCounts(0U, 0U);
+    analysisManager->Invalidate();
+    ASSERT_DOUBLE_EQ(analysisManager->GetBlockFrequency().GetProbability(loopBB, loopBB),
+                     BlockFrequency::LOOP_BRANCH_PROBABILITY);
+}
+
+}  // namespace compiler::tests
@@ -188,4 +188,131 @@ TEST(DominatorTree, TEST_3)
     ASSERT_EQ(i->GetImmediateDominator(), b);
 }
 
+// Same graph as in TEST_1.
+TEST(DominatorTree, DominanceQueries)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *c = builder.CreateBB();
+    auto *d = builder.CreateBB();
+    auto *e = builder.CreateBB();
+    auto *f = builder.CreateBB();
+    auto *g = builder.CreateBB();
+    auto *unreachable = builder.CreateBB();
+
+    a->AddSuccessor(b);
+    b->AddSuccessor(c);
+    b->AddSuccessor(f);
+    c->AddSuccessor(d);
+    f->AddSuccessor(e);
+    f->AddSuccessor(g);
+    g->AddSuccessor(d);
+    e->AddSuccessor(d);
+    unreachable->AddSuccessor(d);
+
+    DominatorTree tree(&graph);
+    tree.Build();
+
+    // Only immediately dominated blocks are kept as children.
+    ASSERT_EQ(a->GetDominatedBlocks().size(), 1U);
+    ASSERT_EQ(b->GetDominatedBlocks().size(), 3U);
+    ASSERT_EQ(f->GetDominatedBlocks().size(), 2U);
+    ASSERT_TRUE(d->GetDominatedBlocks().empty());
+
+    std::array<BasicBlock *, 7U> blocks {a, b, c, d, e, f, g};
+    for (auto *block : blocks) {
+        ASSERT_TRUE(a->IsDominatesOver(block));
+        ASSERT_TRUE(block->IsDominatesOver(block));
+    }
+    ASSERT_TRUE(b->IsDominatesOver(d));
+    ASSERT_TRUE(f->IsDominatesOver(e));
+    ASSERT_TRUE(f->IsDominatesOver(g));
+    ASSERT_FALSE(f->IsDominatesOver(d));
+    ASSERT_FALSE(c->IsDominatesOver(d));
+    ASSERT_FALSE(e->IsDominatesOver(g));
+    ASSERT_FALSE(d->IsDominatesOver(b));
+
+    ASSERT_FALSE(a->IsDominatesOver(unreachable));
+    ASSERT_FALSE(unreachable->IsDominatesOver(d));
+
+    // Rebuilding gives the same tree.
+    tree.Build();
+    ASSERT_EQ(b->GetDominatedBlocks().size(), 3U);
+    ASSERT_TRUE(f->IsDominatesOver(g));
+}
+
+/*
+    Graph:            Dominator tree:
+        A                   A
+       / \                / | \
+      B<->C              B  C  E
+      |   |              |
+      D   |              D
+       \  |
+         E
+*/
+TEST(DominatorTree, IrreducibleLoop)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *c = builder.CreateBB();
+    auto *d = builder.CreateBB();
+    auto *e = builder.CreateBB();
+
+    a->AddSuccessor(b);
+    a->AddSuccessor(c);
+    b->AddSuccessor(c);
+    b->AddSuccessor(d);
+    c->AddSuccessor(b);
+    c->AddSuccessor(e);
+    d->AddSuccessor(e);
+
+    DominatorTree tree(&graph);
+    tree.Build();
+
+    ASSERT_EQ(a->GetImmediateDominator(), nullptr);
+    ASSERT_EQ(b->GetImmediateDominator(), a);
+    ASSERT_EQ(c->GetImmediateDominator(), a);
+    ASSERT_EQ(d->GetImmediateDominator(), b);
+    ASSERT_EQ(e->GetImmediateDominator(), a);
+    ASSERT_FALSE(b->IsDominatesOver(c));
+    ASSERT_FALSE(c->IsDominatesOver(b));
+    ASSERT_TRUE(b->IsDominatesOver(d));
+}
+
+/*
+    A --> B --> C, then the edge B --> C is removed.
+
+    C is not reachable anymore and keeps no immediate dominator from the previous build.
+*/
+TEST(DominatorTree, Rebuild)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *c = builder.CreateBB();
+
+    a->AddSuccessor(b);
+    b->AddSuccessor(c);
+
+    DominatorTree(&graph).Build();
+    ASSERT_EQ(c->GetImmediateDominator(), b);
+
+    b->RemoveSuccessor(c);
+    graph.GetAnalysisManager()->Invalidate();
+    DominatorTree(&graph).Build();
+
+    ASSERT_EQ(b->GetImmediateDominator(), a);
+    ASSERT_EQ(c->GetImmediateDominator(), nullptr);
+    ASSERT_FALSE(b->IsDominatesOver(c));
+}
+
 }  // namespace compiler::tests
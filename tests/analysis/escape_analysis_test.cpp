@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "analysis/escape_analysis.h"
+#include "ir/ir_builder-inl.h"
+
+namespace compiler::tests {
+
+TEST(EscapeAnalysis, Uses)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *param = builder.CreateParameterInsn(0, DataType::REF);
+    auto *zero = builder.CreateInt32ConstantInsn(0);
+    auto *len = builder.CreateInt32ConstantInsn(4);
+
+    // Only reads and writes of elements.
+    auto *local = builder.CreateNewArrInsn(DataType::I32, 4);
+    auto *checked = builder.CreateNullcheckInsn(local);
+    auto *idx = builder.CreateBoundsCheckInsn(checked, zero, len);
+    builder.CreateStoreArrayInsn(DataType::I32, checked, idx, zero);
+    auto *value = builder.CreateLoadArrayInsn(DataType::I32, local, zero);
+
+    auto *argument = builder.CreateNewArrInsn(DataType::I32, 4);
+    builder.CreateCallStaticInsn(DataType::VOID, 1, {{argument, DataType::REF}});
+
+    auto *stored = builder.CreateNewArrInsn(DataType::I32, 4);
+    builder.CreateStoreArrayInsn(DataType::REF, param, zero, stored);
+
+    auto *returned = builder.CreateNewArrInsn(DataType::I32, 4);
+    auto *call = builder.CreateCallStaticInsn(DataType::REF, 2, {{returned, DataType::REF}});
+    builder.CreateRetInsn(DataType::REF, returned);
+
+    const auto &escape = graph.GetAnalysisManager()->GetEscapeAnalysis();
+
+    ASSERT_EQ(escape.GetEscapeState(local), EscapeState::NO_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(checked), EscapeState::NO_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(argument), EscapeState::ARG_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(stored), EscapeState::GLOBAL_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(returned), EscapeState::GLOBAL_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(param), EscapeState::GLOBAL_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(call), EscapeState::GLOBAL_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(value), EscapeState::GLOBAL_ESCAPE);
+}
+
+/*
+    Arrays stored into a local array escape only through it:
+
+    inner = new int[4]; outer = new int[][1]; outer[0] = inner;
+    local = new int[4]; localBox = new int[][1]; localBox[0] = local;
+    if (p) { other = new int[][1]; } else { other = outer; }
+    call(other);
+    nested = new int[4]; box = new int[][1]; box[0] = nested;
+    return box[0];
+*/
+TEST(EscapeAnalysis, Elements)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *thenBB = builder.CreateBB();
+    auto *elseBB = builder.CreateBB();
+    auto *joinBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I32);
+    auto *zero = builder.CreateInt32ConstantInsn(0);
+    auto *inner = builder.CreateNewArrInsn(DataType::I32, 4);
+    auto *outer = builder.CreateNewArrInsn(DataType::REF, 1);
+    builder.CreateStoreArrayInsn(DataType::REF, outer, zero, inner);
+    auto *local = builder.CreateNewArrInsn(DataType::I32, 4);
+    auto *localBox = builder.CreateNewArrInsn(DataType::REF, 1);
+    builder.CreateStoreArrayInsn(DataType::REF, localBox, zero, local);
+    builder.CreateBeqInsn(param, zero, thenBB, elseBB);
+
+    builder.SetBasicBlockScope(thenBB);
+    auto *fresh = builder.CreateNewArrInsn(DataType::REF, 1);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(elseBB);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(joinBB);
+    auto *other = builder.CreatePhiInsn(DataType::REF);
+    other->ResolveDependency(fresh, thenBB);
+    other->ResolveDependency(outer, elseBB);
+    builder.CreateCallStaticInsn(DataType::VOID, 1, {{other, DataType::REF}});
+
+    auto *nested = builder.CreateNewArrInsn(DataType::I32, 4);
+    auto *box = builder.CreateNewArrInsn(DataType::REF, 1);
+    builder.CreateStoreArrayInsn(DataType::REF, box, zero, nested);
+    auto *loaded = builder.CreateLoadArrayInsn(DataType::REF, box, zero);
+    builder.CreateRetInsn(DataType::REF, loaded);
+
+    const auto &escape = graph.GetAnalysisManager()->GetEscapeAnalysis();
+
+    ASSERT_EQ(escape.GetEscapeState(local), EscapeState::NO_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(localBox), EscapeState::NO_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(outer), EscapeState::ARG_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(fresh), EscapeState::ARG_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(inner), EscapeState::ARG_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(nested), EscapeState::GLOBAL_ESCAPE);
+    ASSERT_EQ(escape.GetEscapeState(box), EscapeState::NO_ESCAPE);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include "ir/ir_builder-inl.h"
+
+#include <vector>
+
+namespace compiler::tests {
+
+/*
+    for (int64_t i = 0; i < 10; ++i) { j = i * 4 + 8; }
+
+    BB_0:
+        v0 = Constant 0, v1 = Constant 1, v2 = Constant 10, v3 = Constant 4, v4 = Constant 8
+    BB_1 (header):
+        i = Phi v0:BB_0, inc:BB_2
+        bgt v2, i, BB_2, BB_3
+    BB_2:
+        mul = mul i, v3
+        j = add mul, v4
+        inc = add i, v1
+    BB_3:
+        ret i
+*/
+TEST(InductionAnalysis, CountedLoop)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *headerBB = builder.CreateBB();
+    auto *bodyBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    auto *limit = builder.CreateInt64ConstantInsn(10);
+    auto *four = builder.CreateInt64ConstantInsn(4);
+    auto *eight = builder.CreateInt64ConstantInsn(8);
+    builder.CreateJmpInsn(headerBB);
+
+    builder.SetBasicBlockScope(headerBB);
+    auto *idx = builder.CreatePhiInsn(DataType::I64);
+    builder.CreateBgtInsn(limit, idx, bodyBB, exitBB);
+
+    builder.SetBasicBlockScope(bodyBB);
+    auto *mul = builder.CreateMulInsn(DataType::I64, idx, four);
+    auto *derived = builder.CreateAddInsn(DataType::I64, mul, eight);
+    auto *inc = builder.CreateAddInsn(DataType::I64, idx, one);
+    builder.CreateJmpInsn(headerBB);
+
+    idx->ResolveDependency(zero, entryBB);
+    idx->ResolveDependency(inc, bodyBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    builder.CreateRetInsn(DataType::I64, idx);
+
+    graph.GetAnalysisManager()->Run(AnalysisType::INDUCTION_VARIABLES);
+    auto *loop = headerBB->GetLoop();
+
+    ASSERT_EQ(loop->GetInductionVariables().size(), 4U);
+    const auto *basic = loop->GetInductionVariable(idx);
+    ASSERT_NE(basic, nullptr);
+    ASSERT_TRUE(basic->IsBasic());
+    ASSERT_EQ(basic->init, zero);
+    ASSERT_EQ(basic->step, 1);
+
+    const auto *variable = loop->GetInductionVariable(derived);
+    ASSERT_NE(variable, nullptr);
+    ASSERT_FALSE(variable->IsBasic());
+    ASSERT_EQ(variable->basis, idx);
+    ASSERT_EQ(variable->scale, 4);
+    ASSERT_EQ(variable->offset, 8);
+    ASSERT_EQ(variable->step, 4);
+    ASSERT_EQ(loop->GetInductionVariable(inc)->offset, 1);
+
+    ASSERT_TRUE(loop->GetBound().has_value());
+    ASSERT_EQ(loop->GetBound()->counter, idx);
+    ASSERT_EQ(loop->GetBound()->bound, limit);
+    ASSERT_EQ(loop->GetBound()->cc, ConditionCode::LT);
+    ASSERT_EQ(loop->GetBound()->exitingBlock, headerBB);
+    ASSERT_EQ(loop->GetTripCount(), 10U);
+}
+
+/*
+    int32_t i = 100;
+    do { i -= 3; } while (i > 0);
+
+    The test is at the latch and compares the updated value.
+*/
+TEST(InductionAnalysis, DecrementingLatchTest)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *loopBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *zero = builder.CreateConstantInsn(int32_t {0}, DataType::I32);
+    auto *three = builder.CreateConstantInsn(int32_t {3}, DataType::I32);
+    auto *start = builder.CreateConstantInsn(int32_t {100}, DataType::I32);
+    builder.CreateJmpInsn(loopBB);
+
+    builder.SetBasicBlockScope(loopBB);
+    auto *idx = builder.CreatePhiInsn(DataType::I32);
+    auto *dec = builder.CreateSubInsn(DataType::I32, idx, three);
+    builder.CreateBgtInsn(dec, zero, loopBB, exitBB);
+
+    idx->ResolveDependency(start, entryBB);
+    idx->ResolveDependency(dec, loopBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    builder.CreateRetInsn(DataType::I32, dec);
+
+    graph.GetAnalysisManager()->Run(AnalysisType::INDUCTION_VARIABLES);
+    auto *loop = loopBB->GetLoop();
+
+    ASSERT_EQ(loop->GetInductionVariable(idx)->step, -3);
+    ASSERT_EQ(loop->GetBound()->counter, dec);
+    ASSERT_EQ(loop->GetBound()->cc, ConditionCode::GT);
+    // Values 97, 94, ..., 1 pass the test, 33 of them jump back.
+    ASSERT_EQ(loop->GetTripCount(), 33U);
+}
+
+/*
+    for (int32_t i = 0; i <= limit; i += step) {}
+
+    Bound of the first loop is a parameter, the counter of the second one wraps around instead of exceeding INT32_MAX.
+*/
+TEST(InductionAnalysis, UnknownTripCount)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *zero = builder.CreateConstantInsn(int32_t {0}, DataType::I32);
+    auto *one = builder.CreateConstantInsn(int32_t {1}, DataType::I32);
+    auto *maxValue = builder.CreateConstantInsn(int32_t {INT32_MAX}, DataType::I32);
+
+    std::vector<BasicBlock *> headers;
+    auto *prevBB = entryBB;
+    for (auto *limit : {static_cast<Instruction *>(param), maxValue}) {
+        auto *headerBB = builder.CreateBB();
+        auto *bodyBB = builder.CreateBB();
+        auto *exitBB = builder.CreateBB();
+
+        builder.SetBasicBlockScope(prevBB);
+        builder.CreateJmpInsn(headerBB);
+
+        builder.SetBasicBlockScope(headerBB);
+        auto *idx = builder.CreatePhiInsn(DataType::I32);
+        builder.CreateBgtInsn(idx, limit, exitBB, bodyBB);
+
+        builder.SetBasicBlockScope(bodyBB);
+        auto *inc = builder.CreateAddInsn(DataType::I32, idx, one);
+        builder.CreateJmpInsn(headerBB);
+
+        idx->ResolveDependency(zero, prevBB);
+        idx->ResolveDependency(inc, bodyBB);
+        headers.push_back(headerBB);
+        prevBB = exitBB;
+    }
+    builder.SetBasicBlockScope(prevBB);
+    builder.CreateRetInsn(DataType::I32, zero);
+
+    graph.GetAnalysisManager()->Run(AnalysisType::INDUCTION_VARIABLES);
+
+    for (auto *headerBB : headers) {
+        auto *loop = headerBB->GetLoop();
+        ASSERT_TRUE(loop->GetBound().has_value());
+        ASSERT_EQ(loop->GetBound()->cc, ConditionCode::LE);
+        ASSERT_FALSE(loop->GetTripCount().has_value());
+    }
+}
+
+/*
+    for (i = 0; i != 10; i += step) { if (p == i) break; }
+
+    Phi incremented by a parameter is not an induction variable, a loop with two exits has no bound.
+*/
+TEST(InductionAnalysis, NoBound)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *headerBB = builder.CreateBB();
+    auto *bodyBB = builder.CreateBB();
+    auto *latchBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    auto *limit = builder.CreateInt64ConstantInsn(10);
+    builder.CreateJmpInsn(headerBB);
+
+    builder.SetBasicBlockScope(headerBB);
+    auto *idx = builder.CreatePhiInsn(DataType::I64);
+    auto *sum = builder.CreatePhiInsn(DataType::I64);
+    builder.CreateBneInsn(idx, limit, bodyBB, exitBB);
+
+    builder.SetBasicBlockScope(bodyBB);
+    builder.CreateBeqInsn(param, idx, exitBB, latchBB);
+
+    builder.SetBasicBlockScope(latchBB);
+    auto *inc = builder.CreateAddInsn(DataType::I64, idx, one);
+    auto *acc = builder.CreateAddInsn(DataType::I64, sum, param);
+    builder.CreateJmpInsn(headerBB);
+
+    idx->ResolveDependency(zero, entryBB);
+    idx->ResolveDependency(inc, latchBB);
+    sum->ResolveDependency(zero, entryBB);
+    sum->ResolveDependency(acc, latchBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    builder.CreateRetInsn(DataType::I64, sum);
+
+    graph.GetAnalysisManager()->Run(AnalysisType::INDUCTION_VARIABLES);
+    auto *loop = headerBB->GetLoop();
+
+    ASSERT_NE(loop->GetInductionVariable(idx), nullptr);
+    ASSERT_EQ(loop->GetInductionVariable(sum), nullptr);
+    ASSERT_EQ(loop->GetInductionVariable(acc), nullptr);
+    ASSERT_FALSE(loop->GetBound().has_value());
+    ASSERT_FALSE(loop->GetTripCount().has_value());
+}
+
+}  // namespace compiler::tests
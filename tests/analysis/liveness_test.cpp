@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "analysis/liveness.h"
+#include "ir/ir_builder-inl.h"
+
+#include <vector>
+
+namespace compiler::tests {
+
+static std::vector<std::pair<uint32_t, uint32_t>> GetRanges(const Liveness &liveness, const Instruction *insn)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for (auto range : liveness.GetInterval(insn).GetRanges()) {
+        ranges.emplace_back(range.begin, range.end);
+    }
+    return ranges;
+}
+
+/*
+    Factorial, the loop body goes after the exit in RPO:
+
+    BB_0:                                   [0, 8)
+        0.u32 Parameter 0
+        2.u64 Constant 1
+        4.u32 Constant 2
+        6. jmp BB_1
+    BB_1:                                   [8, 14)
+        8p.u64 Phi v1:BB_0, v7:BB_2
+        10p.u32 Phi v2:BB_0, v8:BB_2
+        12. bgt v0, v5, BB_2, BB_3
+    BB_2:                                   [14, 20)
+        14.u64 mul v4, v5
+        16.u32 add v5, v1
+        18. jmp BB_1
+    BB_3:                                   [20, 22)
+        20.u64 ret v4
+*/
+TEST(Liveness, LoopFactorial)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *bb0 = builder.CreateBB();
+    auto *bb1 = builder.CreateBB();
+    auto *bb3 = builder.CreateBB();
+    auto *bb2 = builder.CreateBB();
+
+    builder.SetBasicBlockScope(bb0);
+    auto *v0 = builder.CreateParameterInsn(0);
+    auto *v1 = builder.CreateInt64ConstantInsn(1);
+    auto *v2 = builder.CreateInt64ConstantInsn(2);
+    builder.CreateJmpInsn(bb1);
+
+    builder.SetBasicBlockScope(bb1);
+    auto *v4 = builder.CreatePhiInsn(DataType::U64);
+    auto *v5 = builder.CreatePhiInsn(DataType::U32);
+    builder.CreateBgtInsn(v0, v5, bb2, bb3);
+
+    builder.SetBasicBlockScope(bb2);
+    auto *v7 = builder.CreateMulInsn(DataType::U64, v4, v5);
+    auto *v8 = builder.CreateAddInsn(DataType::U32, v5, v1);
+    builder.CreateJmpInsn(bb1);
+
+    v4->ResolveDependency(v1, bb0);
+    v4->ResolveDependency(v7, bb2);
+    v5->ResolveDependency(v2, bb0);
+    v5->ResolveDependency(v8, bb2);
+
+    builder.SetBasicBlockScope(bb3);
+    auto *v10 = builder.CreateRetInsn(DataType::U64, v4);
+
+    auto &liveness = graph.GetAnalysisManager()->GetLiveness();
+
+    ASSERT_THAT(liveness.GetLinearOrder(), ::testing::ElementsAre(bb0, bb1, bb2, bb3));
+    ASSERT_EQ(liveness.GetLinearNumber(v7), 14);
+    ASSERT_EQ(liveness.GetLinearNumber(v10), 20);
+    ASSERT_EQ(liveness.GetBlockRange(bb2).begin, 14);
+    ASSERT_EQ(liveness.GetBlockRange(bb2).end, 20);
+
+    // Values used in the loop are live through it.
+    ASSERT_THAT(GetRanges(liveness, v0), ::testing::ElementsAre(std::make_pair(0, 20)));
+    ASSERT_THAT(GetRanges(liveness, v1), ::testing::ElementsAre(std::make_pair(2, 20)));
+    // Phi input is live at the end of the predecessor.
+    ASSERT_THAT(GetRanges(liveness, v2), ::testing::ElementsAre(std::make_pair(4, 8)));
+    ASSERT_THAT(GetRanges(liveness, v8), ::testing::ElementsAre(std::make_pair(16, 20)));
+    // Result of the loop has a hole over the rest of the body.
+    ASSERT_THAT(GetRanges(liveness, v4), ::testing::ElementsAre(std::make_pair(8, 15), std::make_pair(20, 21)));
+    ASSERT_THAT(GetRanges(liveness, v5), ::testing::ElementsAre(std::make_pair(8, 17)));
+    ASSERT_THAT(GetRanges(liveness, v7), ::testing::ElementsAre(std::make_pair(14, 20)));
+
+    ASSERT_TRUE(liveness.GetInterval(v4).IsLiveAt(14));
+    ASSERT_FALSE(liveness.GetInterval(v4).IsLiveAt(16));
+    ASSERT_TRUE(liveness.GetInterval(v4).IsLiveAt(20));
+
+    ASSERT_TRUE(liveness.GetLiveIn(bb0).empty());
+    ASSERT_THAT(liveness.GetLiveIn(bb1), ::testing::UnorderedElementsAre(v0, v1));
+    ASSERT_THAT(liveness.GetLiveIn(bb2), ::testing::UnorderedElementsAre(v0, v1, v4, v5));
+    ASSERT_THAT(liveness.GetLiveIn(bb3), ::testing::UnorderedElementsAre(v4));
+}
+
+/*
+    Nested loops stay contiguous:
+
+    A -> B -> C -> D -> E -> F
+         ^    ^    |    |
+         |    +----+    |
+         +--------------+
+*/
+TEST(Liveness, NestedLoopsOrder)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *f = builder.CreateBB();
+    auto *c = builder.CreateBB();
+    auto *e = builder.CreateBB();
+    auto *d = builder.CreateBB();
+
+    builder.SetBasicBlockScope(a);
+    auto *v0 = builder.CreateParameterInsn(0);
+    builder.CreateJmpInsn(b);
+    builder.SetBasicBlockScope(b);
+    builder.CreateJmpInsn(c);
+    builder.SetBasicBlockScope(c);
+    builder.CreateJmpInsn(d);
+    builder.SetBasicBlockScope(d);
+    builder.CreateBgtInsn(v0, v0, c, e);
+    builder.SetBasicBlockScope(e);
+    builder.CreateBgtInsn(v0, v0, b, f);
+    builder.SetBasicBlockScope(f);
+    builder.CreateRetInsn(DataType::U64, v0);
+
+    auto &liveness = graph.GetAnalysisManager()->GetLiveness();
+
+    ASSERT_THAT(liveness.GetLinearOrder(), ::testing::ElementsAre(a, b, c, d, e, f));
+    ASSERT_THAT(GetRanges(liveness, v0), ::testing::ElementsAre(std::make_pair(0, 13)));
+}
+
+}  // namespace compiler::tests
@@ -312,6 +312,32 @@ TEST(LoopAnalyzer, TEST_5)
     ASSERT_THAT(bLoop->GetBlocks(), ::testing::UnorderedElementsAre(b, g, h, j));
     ASSERT_THAT(cLoop->GetBlocks(), ::testing::UnorderedElementsAre(c, d));
     ASSERT_THAT(eLoop->GetBlocks(), ::testing::UnorderedElementsAre(e, f));
+
+    ASSERT_EQ(rootLoop->GetDepth(), 0);
+    ASSERT_EQ(bLoop->GetDepth(), 1);
+    ASSERT_EQ(cLoop->GetDepth(), 2);
+    ASSERT_EQ(eLoop->GetDepth(), 2);
+
+    ASSERT_TRUE(rootLoop->Contains(k));
+    ASSERT_TRUE(bLoop->Contains(d));
+    ASSERT_TRUE(bLoop->Contains(eLoop));
+    ASSERT_FALSE(bLoop->Contains(a));
+    ASSERT_FALSE(cLoop->Contains(e));
+    ASSERT_FALSE(cLoop->Contains(bLoop));
+
+    // Exits of inner loops stay in the outer one.
+    ASSERT_EQ(cLoop->GetExitEdges().size(), 1);
+    ASSERT_EQ(cLoop->GetExitEdges()[0].from, d);
+    ASSERT_EQ(cLoop->GetExitEdges()[0].to, e);
+    ASSERT_THAT(eLoop->GetExitBlocks(), ::testing::ElementsAre(g));
+    ASSERT_EQ(bLoop->GetExitEdges().size(), 1);
+    ASSERT_EQ(bLoop->GetExitEdges()[0].from, g);
+    ASSERT_THAT(bLoop->GetExitBlocks(), ::testing::ElementsAre(i));
+
+    // Header of C is entered from B and J, D which enters E has another successor.
+    ASSERT_EQ(bLoop->GetPreheader(), a);
+    ASSERT_EQ(cLoop->GetPreheader(), nullptr);
+    ASSERT_EQ(eLoop->GetPreheader(), nullptr);
 }
 
 /*
@@ -383,4 +409,33 @@ TEST(LoopAnalyzer, TEST_6)
     ASSERT_EQ(cLoop->GetOuterLoop(), rootLoop);
 }
 
+// Single loop over a long chain of blocks, both latch search and loop population go deep.
+TEST(LoopAnalyzer, DEEP_LOOP)
+{
+    constexpr size_t BLOCKS_NUM = 300000;
+
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *header = builder.CreateBB();
+    auto *prev = header;
+    for (size_t idx = 1; idx < BLOCKS_NUM; ++idx) {
+        auto *block = builder.CreateBB();
+        Link(prev, block);
+        prev = block;
+    }
+    Link(prev, header);
+
+    LoopAnalyzer loopAnalyzer(&graph);
+    loopAnalyzer.Run();
+
+    auto *rootLoop = graph.GetRootLoop();
+    ASSERT_EQ(rootLoop->GetInnerLoops().size(), 1);
+    auto *loop = rootLoop->GetInnerLoops()[0];
+    ASSERT_EQ(loop->GetHeader(), header);
+    ASSERT_EQ(loop->GetLatches().size(), 1);
+    ASSERT_EQ(loop->GetLatches()[0], prev);
+    ASSERT_EQ(loop->GetBlocks().size(), BLOCKS_NUM);
+}
+
 }  // namespace compiler::tests
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "analysis/control_dependence.h"
+#include "analysis/post_dominator_tree.h"
+#include "ir/ir_builder.h"
+
+namespace compiler::tests {
+
+/*
+    Graph:            Post-dominator tree:
+
+        A                  [exit]
+        |                    |
+        B<---+               F
+       / \   |               |
+      C   D  |               E
+       \ /   |             / | \
+        E----+            B  C  D
+        |                 |
+        F                 A
+*/
+TEST(PostDominatorTree, LoopWithExit)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *c = builder.CreateBB();
+    auto *d = builder.CreateBB();
+    auto *e = builder.CreateBB();
+    auto *f = builder.CreateBB();
+
+    a->AddSuccessor(b);
+    b->AddSuccessor(c);
+    b->AddSuccessor(d);
+    c->AddSuccessor(e);
+    d->AddSuccessor(e);
+    e->AddSuccessor(b);
+    e->AddSuccessor(f);
+
+    auto &tree = graph.GetAnalysisManager()->GetPostDominatorTree();
+
+    ASSERT_EQ(tree.GetImmediatePostDominator(a), b);
+    ASSERT_EQ(tree.GetImmediatePostDominator(b), e);
+    ASSERT_EQ(tree.GetImmediatePostDominator(c), e);
+    ASSERT_EQ(tree.GetImmediatePostDominator(d), e);
+    ASSERT_EQ(tree.GetImmediatePostDominator(e), f);
+    ASSERT_EQ(tree.GetImmediatePostDominator(f), nullptr);
+    ASSERT_THAT(tree.GetPostDominatedBlocks(e), ::testing::UnorderedElementsAre(b, c, d));
+
+    ASSERT_TRUE(tree.IsPostDominatesOver(f, a));
+    ASSERT_TRUE(tree.IsPostDominatesOver(e, a));
+    ASSERT_TRUE(tree.IsPostDominatesOver(b, b));
+    ASSERT_FALSE(tree.IsPostDominatesOver(c, b));
+    ASSERT_FALSE(tree.IsPostDominatesOver(a, b));
+
+    auto &controlDependence = graph.GetAnalysisManager()->GetControlDependence();
+
+    ASSERT_TRUE(controlDependence.GetControllingBlocks(a).empty());
+    ASSERT_THAT(controlDependence.GetControllingBlocks(b), ::testing::ElementsAre(e));
+    ASSERT_THAT(controlDependence.GetControllingBlocks(c), ::testing::ElementsAre(b));
+    ASSERT_THAT(controlDependence.GetControllingBlocks(d), ::testing::ElementsAre(b));
+    ASSERT_THAT(controlDependence.GetControllingBlocks(e), ::testing::ElementsAre(e));
+    ASSERT_TRUE(controlDependence.GetControllingBlocks(f).empty());
+
+    ASSERT_THAT(controlDependence.GetDependentBlocks(b), ::testing::UnorderedElementsAre(c, d));
+    ASSERT_THAT(controlDependence.GetDependentBlocks(e), ::testing::UnorderedElementsAre(b, e));
+}
+
+/*
+    Graph:
+
+        A
+       / \
+      B   X<-+
+          |  |
+          +--+
+*/
+TEST(PostDominatorTree, InfiniteLoop)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *a = builder.CreateBB();
+    auto *b = builder.CreateBB();
+    auto *x = builder.CreateBB();
+
+    a->AddSuccessor(b);
+    a->AddSuccessor(x);
+    x->AddSuccessor(x);
+
+    auto *analyses = graph.GetAnalysisManager();
+    auto &tree = analyses->GetPostDominatorTree();
+
+    ASSERT_FALSE(tree.IsInTree(x));
+    ASSERT_TRUE(tree.IsInTree(a));
+    ASSERT_EQ(tree.GetImmediatePostDominator(a), b);
+    ASSERT_TRUE(tree.IsPostDominatesOver(b, a));
+    ASSERT_FALSE(tree.IsPostDominatesOver(b, x));
+
+    auto &controlDependence = analyses->GetControlDependence();
+    ASSERT_TRUE(controlDependence.GetDependentBlocks(a).empty());
+    ASSERT_TRUE(controlDependence.GetControllingBlocks(x).empty());
+
+    analyses->GetControlDependence();
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::POST_DOMINATOR_TREE), 1);
+    ASSERT_EQ(analyses->GetRunsCount(AnalysisType::CONTROL_DEPENDENCE), 1);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include "analysis/range_analysis.h"
+#include "ir/ir_builder-inl.h"
+
+namespace compiler::tests {
+
+static void ExpectRange(const ValueRange &range, int64_t min, int64_t max)
+{
+    ASSERT_FALSE(range.IsEmpty());
+    ASSERT_EQ(range.GetMin(), min);
+    ASSERT_EQ(range.GetMax(), max);
+}
+
+TEST(RangeAnalysis, Arithmetic)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *param = builder.CreateParameterInsn(0);
+    auto *c10 = builder.CreateInt64ConstantInsn(10);
+    auto *c3 = builder.CreateInt64ConstantInsn(3);
+    auto *c8 = builder.CreateInt64ConstantInsn(8);
+    auto *sub = builder.CreateSubInsn(DataType::I64, c3, c10);
+    auto *mul = builder.CreateMulInsn(DataType::I64, sub, c3);
+    auto *rem = builder.CreateRemInsn(DataType::I64, param, c8);
+    auto *shr = builder.CreateShrInsn(DataType::I64, param, c8);
+    auto *add = builder.CreateAddInsn(DataType::I64, rem, mul);
+    auto *overflow = builder.CreateMulInsn(DataType::I32, param, param);
+    builder.CreateRetInsn(DataType::I64, add);
+
+    const auto &ranges = graph.GetAnalysisManager()->GetRangeAnalysis();
+
+    ExpectRange(ranges.GetRange(param), 0, UINT32_MAX);
+    ExpectRange(ranges.GetRange(sub), -7, -7);
+    ExpectRange(ranges.GetRange(mul), -21, -21);
+    ExpectRange(ranges.GetRange(rem), 0, 7);
+    ExpectRange(ranges.GetRange(shr), 0, UINT32_MAX >> 8U);
+    ExpectRange(ranges.GetRange(add), -21, -14);
+    // The product wraps around in 32 bits.
+    ExpectRange(ranges.GetRange(overflow), INT32_MIN, INT32_MAX);
+}
+
+/*
+    for (int64_t i = 0; i < 100; ++i) {}
+
+    BB_0:
+        v0 = Constant 0, v1 = Constant 1, v2 = Constant 100
+    BB_1 (header):
+        i = Phi v0:BB_0, inc:BB_2
+        bgt v2, i, BB_2, BB_3
+    BB_2:
+        inc = add i, v1
+    BB_3:
+        ret i
+*/
+TEST(RangeAnalysis, CountedLoop)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *headerBB = builder.CreateBB();
+    auto *bodyBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    auto *limit = builder.CreateInt64ConstantInsn(100);
+    builder.CreateJmpInsn(headerBB);
+
+    builder.SetBasicBlockScope(headerBB);
+    auto *idx = builder.CreatePhiInsn(DataType::I64);
+    builder.CreateBgtInsn(limit, idx, bodyBB, exitBB);
+
+    builder.SetBasicBlockScope(bodyBB);
+    auto *inc = builder.CreateAddInsn(DataType::I64, idx, one);
+    builder.CreateJmpInsn(headerBB);
+
+    idx->ResolveDependency(zero, entryBB);
+    idx->ResolveDependency(inc, bodyBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    builder.CreateRetInsn(DataType::I64, idx);
+
+    const auto &ranges = graph.GetAnalysisManager()->GetRangeAnalysis();
+
+    ExpectRange(ranges.GetRange(idx), 0, 100);
+    ExpectRange(ranges.GetRange(idx, bodyBB), 0, 99);
+    ExpectRange(ranges.GetRange(idx, exitBB), 100, 100);
+    ExpectRange(ranges.GetRange(inc), 1, 100);
+
+    ASSERT_TRUE(ranges.IsLess(idx, limit, bodyBB));
+    ASSERT_FALSE(ranges.IsLess(idx, limit, headerBB));
+}
+
+// Unbounded counter is widened instead of iterating up to the bound of its type.
+TEST(RangeAnalysis, Widening)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *headerBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *zero = builder.CreateConstantInsn(int32_t {0}, DataType::I32);
+    auto *two = builder.CreateConstantInsn(int32_t {2}, DataType::I32);
+    builder.CreateJmpInsn(headerBB);
+
+    builder.SetBasicBlockScope(headerBB);
+    auto *counter = builder.CreatePhiInsn(DataType::I32);
+    auto *next = builder.CreateAddInsn(DataType::I32, counter, two);
+    builder.CreateBeqInsn(param, zero, exitBB, headerBB);
+
+    counter->ResolveDependency(zero, entryBB);
+    counter->ResolveDependency(next, headerBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    builder.CreateRetInsn(DataType::I32, counter);
+
+    const auto &ranges = graph.GetAnalysisManager()->GetRangeAnalysis();
+
+    // Overflow of the increment wraps the counter around.
+    ExpectRange(ranges.GetRange(counter), INT32_MIN, INT32_MAX);
+    ExpectRange(ranges.GetRange(param, exitBB), 0, 0);
+    ExpectRange(ranges.GetRange(param, headerBB), 0, UINT32_MAX);
+}
+
+TEST(RangeAnalysis, EqualityRefinement)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *equalBB = builder.CreateBB();
+    auto *notEqualBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *zero = builder.CreateConstantInsn(uint32_t {0}, DataType::U32);
+    builder.CreateBneInsn(param, zero, notEqualBB, equalBB);
+
+    builder.SetBasicBlockScope(equalBB);
+    builder.CreateRetInsn(DataType::U32, param);
+
+    builder.SetBasicBlockScope(notEqualBB);
+    builder.CreateRetInsn(DataType::U32, param);
+
+    const auto &ranges = graph.GetAnalysisManager()->GetRangeAnalysis();
+
+    ExpectRange(ranges.GetRange(param, equalBB), 0, 0);
+    ExpectRange(ranges.GetRange(param, notEqualBB), 1, UINT32_MAX);
+}
+
+}  // namespace compiler::tests
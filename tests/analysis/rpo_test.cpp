@@ -41,4 +41,29 @@ TEST(RPO, TEST_1)
     }
 }
 
+// Deep enough to overflow the machine stack with a recursive traversal.
+TEST(RPO, DEEP_CHAIN)
+{
+    constexpr size_t BLOCKS_NUM = 300000;
+
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    std::vector<BasicBlock *> chain;
+    chain.reserve(BLOCKS_NUM);
+    for (size_t idx = 0; idx < BLOCKS_NUM; ++idx) {
+        auto *block = builder.CreateBB();
+        if (!chain.empty()) {
+            chain.back()->AddSuccessor(block);
+        }
+        chain.push_back(block);
+    }
+
+    RPO rpo(&graph);
+    rpo.SetMarker(graph.CreateNewMarker());
+    auto rpoVec = rpo.Run();
+
+    ASSERT_EQ(rpoVec, chain);
+}
+
 }  // namespace compiler::tests
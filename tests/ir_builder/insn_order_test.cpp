@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "ir/ir_builder-inl.h"
+
+#include <vector>
+
+namespace compiler::tests {
+
+TEST(InsnOrder, PushedInstructions)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *v0 = builder.CreateInt64ConstantInsn(1);
+    auto *v1 = builder.CreateInt64ConstantInsn(2);
+    auto *v2 = builder.CreateAddInsn(DataType::I64, v0, v1);
+
+    ASSERT_TRUE(v0->DominatedOver(v1));
+    ASSERT_TRUE(v0->DominatedOver(v2));
+    ASSERT_TRUE(v1->DominatedOver(v2));
+    ASSERT_FALSE(v2->DominatedOver(v0));
+    ASSERT_FALSE(v1->DominatedOver(v1));
+}
+
+// Repeated insertion at the same place exhausts the gap and forces renumbering.
+TEST(InsnOrder, InsertionsExhaustGap)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *first = builder.CreateInt64ConstantInsn(0);
+    auto *last = builder.CreateInt64ConstantInsn(1);
+
+    std::vector<Instruction *> inserted;
+    for (int idx = 0; idx < 100; ++idx) {
+        auto *insn = graph.CreateInsn<ConstantInsn>(static_cast<int64_t>(idx + 2), DataType::I64);
+        // Every new instruction goes right after `first`, so it precedes all previously inserted ones.
+        entryBB->InsertInstruction(first, insn);
+        inserted.push_back(insn);
+    }
+
+    auto *head = graph.CreateInsn<ConstantInsn>(static_cast<int64_t>(-1), DataType::I64);
+    entryBB->InsertInstruction(nullptr, head);
+
+    ASSERT_TRUE(head->DominatedOver(first));
+    ASSERT_TRUE(first->DominatedOver(inserted.back()));
+    for (size_t idx = 1; idx < inserted.size(); ++idx) {
+        ASSERT_TRUE(inserted[idx]->DominatedOver(inserted[idx - 1]));
+        ASSERT_FALSE(inserted[idx - 1]->DominatedOver(inserted[idx]));
+    }
+    ASSERT_TRUE(inserted.front()->DominatedOver(last));
+    ASSERT_EQ(inserted.front()->GetParentBB(), entryBB);
+}
+
+}  // namespace compiler::tests
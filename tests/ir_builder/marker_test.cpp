@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "ir/ir_builder-inl.h"
+
+#include <vector>
+
+namespace compiler::tests {
+
+TEST(Marker, ManyLiveMarkers)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *bb0 = builder.CreateBB();
+    auto *bb1 = builder.CreateBB();
+    builder.SetBasicBlockScope(bb0);
+    auto *v0 = builder.CreateInt64ConstantInsn(1);
+
+    constexpr size_t MARKERS_NUM = 32U;
+    std::vector<Marker> markers;
+    for (size_t idx = 0; idx < MARKERS_NUM; ++idx) {
+        markers.push_back(graph.CreateNewMarker());
+        if (idx % 2 == 0) {
+            bb0->SetMarker(markers.back());
+            v0->SetMarker(markers.back());
+        } else {
+            bb1->SetMarker(markers.back());
+        }
+    }
+
+    for (size_t idx = 0; idx < MARKERS_NUM; ++idx) {
+        ASSERT_EQ(bb0->IsMarked(markers[idx]), idx % 2 == 0);
+        ASSERT_EQ(bb1->IsMarked(markers[idx]), idx % 2 != 0);
+        ASSERT_EQ(v0->IsMarked(markers[idx]), idx % 2 == 0);
+    }
+
+    bb0->EraseMarker(markers[0]);
+    ASSERT_FALSE(bb0->IsMarked(markers[0]));
+    ASSERT_TRUE(v0->IsMarked(markers[0]));
+    ASSERT_TRUE(bb0->IsMarked(markers[2]));
+
+    for (auto marker : markers) {
+        graph.EraseMarker(marker);
+    }
+}
+
+TEST(Marker, ReusedSlotIsClean)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *bb0 = builder.CreateBB();
+    builder.SetBasicBlockScope(bb0);
+    auto *v0 = builder.CreateInt64ConstantInsn(1);
+
+    auto oldMarker = graph.CreateNewMarker();
+    bb0->SetMarker(oldMarker);
+    v0->SetMarker(oldMarker);
+    graph.EraseMarker(oldMarker);
+
+    auto newMarker = graph.CreateNewMarker();
+    ASSERT_EQ(newMarker.GetSlot(), oldMarker.GetSlot());
+    ASSERT_FALSE(bb0->IsMarked(newMarker));
+    ASSERT_FALSE(v0->IsMarked(newMarker));
+    graph.EraseMarker(newMarker);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "ir/ir_builder-inl.h"
+#include "ir/side_table.h"
+
+#include <vector>
+
+namespace compiler::tests {
+
+TEST(SideTable, RenumberIds)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *bb0 = builder.CreateBB();
+    auto *bb1 = builder.CreateBB();
+    bb0->AddSuccessor(bb1);
+
+    builder.SetBasicBlockScope(bb1);
+    auto *v0 = builder.CreateInt64ConstantInsn(1);
+    builder.SetBasicBlockScope(bb0);
+    auto *v1 = builder.CreateInt64ConstantInsn(2);
+    auto *v2 = builder.CreateAddInsn(DataType::I64, v1, v1);
+    auto *v3 = builder.CreateAddInsn(DataType::I64, v1, v1);
+    bb0->Remove(v2);
+
+    ASSERT_EQ(graph.GetInstructions().size(), 4);
+    graph.RenumberIds();
+
+    // Removed instruction is dropped, the rest are numbered in layout order.
+    ASSERT_EQ(graph.GetInstructions().size(), 3);
+    ASSERT_EQ(v1->GetId(), 0);
+    ASSERT_EQ(v3->GetId(), 1);
+    ASSERT_EQ(v0->GetId(), 2);
+    ASSERT_EQ(bb0->GetId(), 0);
+    ASSERT_EQ(bb1->GetId(), 1);
+}
+
+TEST(SideTable, Access)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *bb0 = builder.CreateBB();
+    builder.SetBasicBlockScope(bb0);
+    auto *v0 = builder.CreateInt64ConstantInsn(1);
+
+    BlockSideTable<int> blocksTable(&graph, -1);
+    InsnSideTable<int> insnsTable(&graph, -1);
+    ASSERT_EQ(blocksTable.size(), 1);
+    ASSERT_EQ(insnsTable.size(), 1);
+    ASSERT_EQ(blocksTable[bb0], -1);
+
+    insnsTable[v0] = 10;
+
+    // Objects created after the table get the default value.
+    auto *bb1 = builder.CreateBB();
+    builder.SetBasicBlockScope(bb1);
+    auto *v1 = builder.CreateInt64ConstantInsn(2);
+    ASSERT_EQ(blocksTable[bb1], -1);
+    ASSERT_EQ(insnsTable[v1], -1);
+    ASSERT_EQ(insnsTable[v0], 10);
+    ASSERT_EQ(insnsTable.size(), 2);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include "ir/ir_builder-inl.h"
+
+#include <vector>
+
+namespace compiler::tests {
+
+static std::vector<PhiInsn *> GetPhis(BasicBlock *block)
+{
+    std::vector<PhiInsn *> phis;
+    for (auto *insn = block->GetFirstInsn(); insn != nullptr && insn->IsPhi(); insn = insn->GetNext()) {
+        phis.push_back(static_cast<PhiInsn *>(insn));
+    }
+    return phis;
+}
+
+static size_t CountPhis(const Graph &graph)
+{
+    size_t count = 0;
+    for (auto *block : graph.GetBlocks()) {
+        count += GetPhis(block).size();
+    }
+    return count;
+}
+
+/*
+    The same function as in IR_BUILDER.LoopFactorial, built from variables:
+
+    uint64_t fact(uint32_t n) {
+        uint64_t res = 1U;
+        for (uint32_t idx = 2U; idx <= n; ++idx) {
+            res *= idx;
+        }
+        return res;
+    }
+
+    Only `res` and `idx` get phis in the loop header, the phi of `n` merges only itself and is removed.
+*/
+TEST(SSA_BUILDER, LoopFactorial)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *headerBB = builder.CreateBB();
+    auto *bodyBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    auto nVar = builder.CreateVariable(DataType::U32);
+    auto resVar = builder.CreateVariable(DataType::U64);
+    auto idxVar = builder.CreateVariable(DataType::U32);
+
+    builder.SetBasicBlockScope(entryBB);
+    builder.SealBlock(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    auto *two = builder.CreateInt64ConstantInsn(2);
+    builder.WriteVariable(nVar, param);
+    builder.WriteVariable(resVar, one);
+    builder.WriteVariable(idxVar, two);
+    builder.CreateJmpInsn(headerBB);
+
+    // The back edge is not created yet, so the header stays unsealed.
+    builder.SetBasicBlockScope(headerBB);
+    auto *idx = builder.ReadVariable(idxVar);
+    auto *cmp = builder.CreateBgtInsn(idx, builder.ReadVariable(nVar), exitBB, bodyBB);
+
+    builder.SetBasicBlockScope(bodyBB);
+    builder.SealBlock(bodyBB);
+    auto *mul = builder.CreateMulInsn(DataType::U64, builder.ReadVariable(resVar), builder.ReadVariable(idxVar));
+    auto *add = builder.CreateAddInsn(DataType::U32, builder.ReadVariable(idxVar), one);
+    builder.WriteVariable(resVar, mul);
+    builder.WriteVariable(idxVar, add);
+    builder.CreateJmpInsn(headerBB);
+    builder.SealBlock(headerBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    builder.SealBlock(exitBB);
+    auto *ret = builder.CreateRetInsn(DataType::U64, builder.ReadVariable(resVar));
+
+    auto phis = GetPhis(headerBB);
+    ASSERT_EQ(phis.size(), 2U);
+    ASSERT_EQ(CountPhis(graph), 2U);
+
+    auto *idxPhi = phis[0];
+    auto *resPhi = phis[1];
+    ASSERT_EQ(idxPhi->GetResultType(), DataType::U32);
+    ASSERT_EQ(resPhi->GetResultType(), DataType::U64);
+
+    ASSERT_EQ(cmp->GetInput(0), idxPhi);
+    ASSERT_EQ(cmp->GetInput(1), param);
+    ASSERT_EQ(mul->GetInput(0), resPhi);
+    ASSERT_EQ(mul->GetInput(1), idxPhi);
+    ASSERT_EQ(add->GetInput(0), idxPhi);
+    ASSERT_EQ(ret->GetInput(0), resPhi);
+
+    const auto &idxDeps = idxPhi->GetDependencies();
+    ASSERT_EQ(idxDeps.size(), 2U);
+    ASSERT_EQ(idxDeps[0].value, two);
+    ASSERT_EQ(idxDeps[0].block, entryBB);
+    ASSERT_EQ(idxDeps[1].value, add);
+    ASSERT_EQ(idxDeps[1].block, bodyBB);
+
+    const auto &resDeps = resPhi->GetDependencies();
+    ASSERT_EQ(resDeps.size(), 2U);
+    ASSERT_EQ(resDeps[0].value, one);
+    ASSERT_EQ(resDeps[1].value, mul);
+}
+
+/*
+    if (p > 0) { x = c1; y = c1 } else { x = c2; y = c1 }
+    return x + y;
+
+    Only `x` needs a phi in the join block.
+*/
+TEST(SSA_BUILDER, Diamond)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *thenBB = builder.CreateBB();
+    auto *elseBB = builder.CreateBB();
+    auto *joinBB = builder.CreateBB();
+
+    auto xVar = builder.CreateVariable(DataType::I64);
+    auto yVar = builder.CreateVariable(DataType::I64);
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *c1 = builder.CreateInt64ConstantInsn(1);
+    auto *c2 = builder.CreateInt64ConstantInsn(2);
+    builder.CreateBgtInsn(param, zero, thenBB, elseBB);
+
+    builder.SetBasicBlockScope(thenBB);
+    builder.WriteVariable(xVar, c1);
+    builder.WriteVariable(yVar, c1);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(elseBB);
+    builder.WriteVariable(xVar, c2);
+    builder.WriteVariable(yVar, c1);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SealAllBlocks();
+
+    builder.SetBasicBlockScope(joinBB);
+    auto *sum = builder.CreateAddInsn(DataType::I64, builder.ReadVariable(xVar), builder.ReadVariable(yVar));
+    builder.CreateRetInsn(DataType::I64, sum);
+
+    auto phis = GetPhis(joinBB);
+    ASSERT_EQ(phis.size(), 1U);
+    ASSERT_EQ(sum->GetInput(0), phis[0]);
+    ASSERT_EQ(sum->GetInput(1), c1);
+
+    const auto &deps = phis[0]->GetDependencies();
+    ASSERT_EQ(deps.size(), 2U);
+    ASSERT_EQ(deps[0].value, c1);
+    ASSERT_EQ(deps[0].block, thenBB);
+    ASSERT_EQ(deps[1].value, c2);
+    ASSERT_EQ(deps[1].block, elseBB);
+}
+
+// Variable which is only read inside of nested loops gets no phis, the chain of trivial phis collapses.
+TEST(SSA_BUILDER, NestedLoopsInvariant)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *outerBB = builder.CreateBB();
+    auto *innerBB = builder.CreateBB();
+    auto *latchBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    auto var = builder.CreateVariable(DataType::I64);
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    builder.WriteVariable(var, param);
+    builder.CreateJmpInsn(outerBB);
+
+    builder.SetBasicBlockScope(outerBB);
+    builder.CreateJmpInsn(innerBB);
+
+    builder.SetBasicBlockScope(innerBB);
+    auto *value = builder.ReadVariable(var);
+    auto *branch = builder.CreateBgtInsn(value, param, latchBB, innerBB);
+
+    builder.SetBasicBlockScope(latchBB);
+    builder.CreateBgtInsn(builder.ReadVariable(var), param, exitBB, outerBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    auto *ret = builder.CreateRetInsn(DataType::I64, builder.ReadVariable(var));
+
+    ASSERT_NE(CountPhis(graph), 0U);
+    builder.SealAllBlocks();
+
+    ASSERT_EQ(CountPhis(graph), 0U);
+    ASSERT_EQ(branch->GetInput(0), param);
+    ASSERT_EQ(ret->GetInput(0), param);
+}
+
+TEST(SSA_BUILDER, UndefinedValue)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto var = builder.CreateVariable(DataType::I64);
+
+    builder.SetBasicBlockScope(entryBB);
+    builder.SealBlock(entryBB);
+    auto *value = builder.ReadVariable(var);
+    builder.CreateRetInsn(DataType::I64, value);
+
+    ASSERT_EQ(value->GetOpcode(), Opcode::UNDEFINED);
+    ASSERT_EQ(entryBB->GetFirstInsn(), value);
+}
+
+// Lookup through a long chain of diamonds is iterative and doesn't depend on the stack depth.
+TEST(SSA_BUILDER, LongChain)
+{
+    constexpr size_t DIAMONDS_NUM = 10000;
+
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto var = builder.CreateVariable(DataType::I64);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0);
+    builder.WriteVariable(var, param);
+
+    auto *currBB = entryBB;
+    for (size_t idx = 0; idx < DIAMONDS_NUM; ++idx) {
+        auto *thenBB = builder.CreateBB();
+        auto *elseBB = builder.CreateBB();
+        auto *joinBB = builder.CreateBB();
+
+        builder.SetBasicBlockScope(currBB);
+        builder.CreateBgtInsn(param, param, thenBB, elseBB);
+        builder.SetBasicBlockScope(thenBB);
+        builder.CreateJmpInsn(joinBB);
+        builder.SetBasicBlockScope(elseBB);
+        builder.CreateJmpInsn(joinBB);
+        currBB = joinBB;
+    }
+    builder.SealAllBlocks();
+
+    builder.SetBasicBlockScope(currBB);
+    auto *value = builder.ReadVariable(var);
+    builder.CreateRetInsn(DataType::I64, value);
+
+    ASSERT_EQ(value, param);
+    ASSERT_EQ(CountPhis(graph), 0U);
+}
+
+}  // namespace compiler::tests
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include "ir/ir_builder-inl.h"
+
+namespace compiler::tests {
+
+TEST(UseList, UsesKnowOperandIndex)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *v0 = builder.CreateInt64ConstantInsn(1);
+    auto *v1 = builder.CreateInt64ConstantInsn(2);
+    auto *v2 = builder.CreateAddInsn(DataType::I64, v0, v1);
+    auto *v3 = builder.CreateSubInsn(DataType::I64, v1, v1);
+
+    ASSERT_EQ(v0->GetUsers().size(), 1U);
+    ASSERT_EQ(v1->GetUsers().size(), 3U);
+
+    auto *use = v1->GetUsers().GetFirst();
+    ASSERT_EQ(use->GetUser(), v2);
+    ASSERT_EQ(use->GetIndex(), 1U);
+
+    use = use->GetNext();
+    ASSERT_EQ(use->GetUser(), v3);
+    ASSERT_EQ(use->GetIndex(), 0U);
+
+    use = use->GetNext();
+    ASSERT_EQ(use->GetUser(), v3);
+    ASSERT_EQ(use->GetIndex(), 1U);
+    ASSERT_EQ(use->GetNext(), nullptr);
+}
+
+TEST(UseList, SetInputMovesUse)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *v0 = builder.CreateInt64ConstantInsn(1);
+    auto *v1 = builder.CreateInt64ConstantInsn(2);
+    auto *v2 = builder.CreateAddInsn(DataType::I64, v0, v0);
+
+    v2->SetInput(v1, 1);
+
+    ASSERT_EQ(v0->GetUsers().size(), 1U);
+    ASSERT_EQ(v0->GetUsers().GetFirst()->GetIndex(), 0U);
+    ASSERT_EQ(v1->GetUsers().size(), 1U);
+    ASSERT_EQ(v1->GetUsers().front(), v2);
+
+    v2->SwapInputs();
+    ASSERT_EQ(v2->GetInput(0), v1);
+    ASSERT_EQ(v2->GetInput(1), v0);
+    ASSERT_EQ(v0->GetUsers().GetFirst()->GetIndex(), 1U);
+    ASSERT_EQ(v1->GetUsers().GetFirst()->GetIndex(), 0U);
+
+    entryBB->Remove(v2);
+    ASSERT_TRUE(v0->GetUsers().empty());
+    ASSERT_TRUE(v1->GetUsers().empty());
+}
+
+TEST(UseList, OperandsCountFollowsOpcode)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *v0 = builder.CreateInt64ConstantInsn(1);
+    auto *v1 = builder.CreateInt64ConstantInsn(2);
+    auto *v2 = builder.CreateAddInsn(DataType::I64, v0, v1);
+    auto *v3 = builder.CreateRetInsn(DataType::I64, v2);
+    auto *v4 = builder.CreatePhiInsn(DataType::I64);
+
+    ASSERT_EQ(v0->GetInputsCount(), GetOpcodeInputsCount(Opcode::CONSTANT));
+    ASSERT_EQ(v2->GetInputsCount(), GetOpcodeInputsCount(Opcode::ADD));
+    ASSERT_EQ(v3->GetInputsCount(), GetOpcodeInputsCount(Opcode::RET));
+    ASSERT_TRUE(v4->HasDynamicInputs());
+    ASSERT_EQ(v4->GetInputsCount(), 0U);
+
+    // Operand slots are placed in the instruction itself.
+    auto *slot = &v2->GetInputs()[0];
+    auto *insnBegin = reinterpret_cast<uint8_t *>(v2);
+    ASSERT_GE(reinterpret_cast<uint8_t *>(slot), insnBegin);
+    ASSERT_LT(reinterpret_cast<uint8_t *>(slot), insnBegin + sizeof(AddInsn));
+}
+
+TEST(UseList, GrowingOperandStorageKeepsLinks)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *phiBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    std::vector<Instruction *> values;
+    for (int idx = 0; idx < 100; ++idx) {
+        values.push_back(builder.CreateInt64ConstantInsn(idx));
+    }
+
+    builder.SetBasicBlockScope(phiBB);
+    auto *phi = builder.CreatePhiInsn(DataType::I64);
+    for (auto *value : values) {
+        phi->ResolveDependency(value, entryBB);
+    }
+
+    ASSERT_EQ(phi->GetInputsCount(), values.size());
+    for (size_t idx = 0; idx < values.size(); ++idx) {
+        auto &users = values[idx]->GetUsers();
+        ASSERT_EQ(users.size(), 1U);
+        ASSERT_EQ(users.front(), phi);
+        ASSERT_EQ(users.GetFirst()->GetIndex(), idx);
+        ASSERT_EQ(users.GetFirst(), users.GetLast());
+    }
+
+    // The phi merges values[1] already, so the last slot takes the place of the dropped one.
+    values[0]->ReplaceInputsForUsers(values[1]);
+    ASSERT_TRUE(values[0]->GetUsers().empty());
+    ASSERT_EQ(values[1]->GetUsers().size(), 1U);
+    ASSERT_EQ(phi->GetInputsCount(), values.size() - 1U);
+    ASSERT_EQ(phi->GetInput(0), values.back());
+    ASSERT_EQ(values.back()->GetUsers().GetFirst()->GetIndex(), 0U);
+}
+
+// After the replacement the phi merges one value from two blocks, it stays in a single slot.
+TEST(UseList, ReplaceDuplicatePhiInputs)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *lhsBB = builder.CreateBB();
+    auto *rhsBB = builder.CreateBB();
+    auto *joinBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *lhs = builder.CreateAddInsn(DataType::I64, param, param);
+    auto *rhs = builder.CreateMulInsn(DataType::I64, param, param);
+    auto *other = builder.CreateSubInsn(DataType::I64, param, param);
+    builder.CreateBgtInsn(param, param, lhsBB, rhsBB);
+
+    builder.SetBasicBlockScope(lhsBB);
+    builder.CreateJmpInsn(joinBB);
+    builder.SetBasicBlockScope(rhsBB);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(joinBB);
+    auto *phi = builder.CreatePhiInsn(DataType::I64);
+    phi->ResolveDependency(lhs, lhsBB);
+    phi->ResolveDependency(rhs, rhsBB);
+
+    // The phi merges `lhs` already, so the slot of `rhs` is dropped.
+    rhs->ReplaceInputsForUsers(lhs);
+    ASSERT_EQ(phi->GetInputsCount(), 1U);
+    ASSERT_EQ(phi->GetInput(0), lhs);
+    ASSERT_TRUE(rhs->GetUsers().empty());
+    ASSERT_EQ(lhs->GetUsers().size(), 1U);
+    ASSERT_EQ(phi->GetDependencies().size(), 2U);
+
+    lhs->ReplaceInputsForUsers(other);
+    ASSERT_TRUE(lhs->GetUsers().empty());
+    ASSERT_EQ(other->GetUsers().size(), 1U);
+    ASSERT_EQ(phi->GetInputsCount(), 1U);
+    ASSERT_EQ(phi->GetInput(0), other);
+    for (const auto &dependency : phi->GetDependencies()) {
+        ASSERT_EQ(dependency.value, other);
+    }
+
+    // The value still comes from the other predecessor.
+    phi->RemoveDependency(lhsBB);
+    ASSERT_EQ(phi->GetInputsCount(), 1U);
+    ASSERT_EQ(phi->GetInput(0), other);
+}
+
+}  // namespace compiler::tests
@@ -131,6 +131,7 @@ TEST(CheckElimination, NotAppliedNullcheckNotDominated)
     CompareInputs<2U>(v7, {v6, v1});
 }
 
+// Index of the following tests is unknown, so only dominating checks make checks redundant.
 TEST(CheckElimination, BoundsCheck)
 {
     Graph graph;
@@ -140,7 +141,7 @@ TEST(CheckElimination, BoundsCheck)
     /*
         entryBB:
             0.ref Parameter 0
-            1.u64 Constant 12
+            1.u32 Parameter 1
             2.u64 Constant 13
             3.u64 Constant 14
             4.u32 BoundsCheck v0, v1, v2
@@ -149,7 +150,7 @@ TEST(CheckElimination, BoundsCheck)
             7.ref StoreArray v0, v6, v3
             ===========================>
             0.ref Parameter 0
-            1.u64 Constant 12
+            1.u32 Parameter 1
             2.u64 Constant 13
             3.u64 Constant 14
             4.u32 BoundsCheck v0, v1, v2
@@ -160,7 +161,7 @@ TEST(CheckElimination, BoundsCheck)
     builder.SetBasicBlockScope(entryBB);
 
     auto *v0 = builder.CreateParameterInsn(0, DataType::REF);
-    auto *v1 = builder.CreateInt64ConstantInsn(12);
+    auto *v1 = builder.CreateParameterInsn(1);
     auto *v2 = builder.CreateInt64ConstantInsn(13);
     auto *v3 = builder.CreateInt64ConstantInsn(14);
     auto *v4 = builder.CreateBoundsCheckInsn(v0, v1, v2);
@@ -184,7 +185,7 @@ TEST(CheckElimination, BoundsCheckNotApplied)
     /*
         entryBB:
             0.ref Parameter 0
-            1.u64 Constant 12
+            1.u32 Parameter 1
             2.u64 Constant 20
             3.u64 Constant 30
             4.ref BoundsCheck v0, v1, v2
@@ -196,7 +197,7 @@ TEST(CheckElimination, BoundsCheckNotApplied)
     builder.SetBasicBlockScope(entryBB);
 
     auto *v0 = builder.CreateParameterInsn(0, DataType::REF);
-    auto *v1 = builder.CreateInt64ConstantInsn(12);
+    auto *v1 = builder.CreateParameterInsn(1);
     auto *v2 = builder.CreateInt64ConstantInsn(20);
     auto *v3 = builder.CreateInt64ConstantInsn(30);
     auto *v4 = builder.CreateBoundsCheckInsn(v0, v1, v2);
@@ -219,7 +220,7 @@ TEST(CheckElimination, BoundsCheckManyBB)
     /*
         BB_0:
             0.ref Parameter 0
-            1.u64 Constant 12
+            1.u32 Parameter 1
             2.u64 Constant 30
             3.u32 BoundsCheck v0, v1, v2
             4.u64 LoadArray v0, v3
@@ -237,7 +238,7 @@ TEST(CheckElimination, BoundsCheckManyBB)
         ================================>
         BB_0:
             0.ref Parameter 0
-            1.u64 Constant 12
+            1.u32 Parameter 1
             2.u64 Constant 30
             3.u32 BoundsCheck v0, v1, v2
             4.u64 LoadArray v0, v3
@@ -258,7 +259,7 @@ TEST(CheckElimination, BoundsCheckManyBB)
 
     builder.SetBasicBlockScope(bb0);
     auto *v0 = builder.CreateParameterInsn(0, DataType::REF);
-    auto *v1 = builder.CreateInt64ConstantInsn(12);
+    auto *v1 = builder.CreateParameterInsn(1);
     auto *v2 = builder.CreateInt64ConstantInsn(30);
     auto *v3 = builder.CreateBoundsCheckInsn(v0, v1, v2);
     auto *v4 = builder.CreateLoadArrayInsn(DataType::U64, v0, v3);
@@ -296,7 +297,7 @@ TEST(CheckElimination, BoundsCheckManyBBNotApplied)
     /*
         BB_0:
             0.ref Parameter 0
-            1.u64 Constant 12
+            1.u32 Parameter 1
             2.u64 Constant 30
             4. bgt v1, v2, BB_1, BB_2
         BB_1:
@@ -317,7 +318,7 @@ TEST(CheckElimination, BoundsCheckManyBBNotApplied)
 
     builder.SetBasicBlockScope(bb0);
     auto *v0 = builder.CreateParameterInsn(0, DataType::REF);
-    auto *v1 = builder.CreateInt64ConstantInsn(12);
+    auto *v1 = builder.CreateParameterInsn(1);
     auto *v2 = builder.CreateInt64ConstantInsn(30);
     [[maybe_unused]] auto *v4 = builder.CreateBgtInsn(v1, v2, bb1, bb2);
 
@@ -340,4 +341,114 @@ TEST(CheckElimination, BoundsCheckManyBBNotApplied)
     CompareInputs<2U>(v9, {v0, v8});
 }
 
+/*
+    for (i = 0; n > i; ++i) { a[i] = a[i]; }
+
+    BB_0:
+        0.ref Parameter 0
+        1.u32 Parameter 1              // n
+        2.i64 Constant 0
+        3.i64 Constant 1
+        4. jmp BB_1
+    BB_1:
+        5p.i64 Phi v2:BB_0, v10:BB_2
+        6. bgt v1, v5, BB_2, BB_3
+    BB_2:
+        7.u32 BoundsCheck v0, v5, v1   // removed, 0 <= i < n
+        8.u64 LoadArray v0, v7
+        9.u32 BoundsCheck v0, v5, v1   // removed
+        10.i64 add v5, v3
+        11.ref StoreArray v0, v9, v8
+        12. jmp BB_1
+    BB_3:
+        13. ret
+*/
+TEST(CheckElimination, BoundsCheckInCountedLoop)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+    CheckElimination checkElimination(&graph);
+
+    auto *bb0 = builder.CreateBB();
+    auto *bb1 = builder.CreateBB();
+    auto *bb2 = builder.CreateBB();
+    auto *bb3 = builder.CreateBB();
+
+    builder.SetBasicBlockScope(bb0);
+    auto *v0 = builder.CreateParameterInsn(0, DataType::REF);
+    auto *v1 = builder.CreateParameterInsn(1);
+    auto *v2 = builder.CreateInt64ConstantInsn(0);
+    auto *v3 = builder.CreateInt64ConstantInsn(1);
+    builder.CreateJmpInsn(bb1);
+
+    builder.SetBasicBlockScope(bb1);
+    auto *v5 = builder.CreatePhiInsn(DataType::I64);
+    builder.CreateBgtInsn(v1, v5, bb2, bb3);
+
+    builder.SetBasicBlockScope(bb2);
+    auto *v7 = builder.CreateBoundsCheckInsn(v0, v5, v1);
+    auto *v8 = builder.CreateLoadArrayInsn(DataType::U64, v0, v7);
+    auto *v9 = builder.CreateBoundsCheckInsn(v0, v5, v1);
+    auto *v10 = builder.CreateAddInsn(DataType::I64, v5, v3);
+    auto *v11 = builder.CreateStoreArrayInsn(DataType::U64, v0, v9, v8);
+    builder.CreateJmpInsn(bb1);
+
+    v5->ResolveDependency(v2, bb0);
+    v5->ResolveDependency(v10, bb2);
+
+    builder.SetBasicBlockScope(bb3);
+    builder.CreateRetInsn(DataType::VOID);
+
+    checkElimination.Run();
+
+    CompareInputs<2U>(v8, {v0, v5});
+    CompareInputs<3U>(v11, {v0, v5, v8});
+    ASSERT_TRUE(v7->GetUsers().empty());
+    ASSERT_TRUE(v9->GetUsers().empty());
+}
+
+/*
+    for (i = 0; i <= 10; ++i) { a[i]; }    // length of the array is 10
+
+    The index reaches the length at the last iteration, the check stays.
+*/
+TEST(CheckElimination, BoundsCheckInCountedLoopNotApplied)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+    CheckElimination checkElimination(&graph);
+
+    auto *bb0 = builder.CreateBB();
+    auto *bb1 = builder.CreateBB();
+    auto *bb2 = builder.CreateBB();
+    auto *bb3 = builder.CreateBB();
+
+    builder.SetBasicBlockScope(bb0);
+    auto *array = builder.CreateParameterInsn(0, DataType::REF);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    auto *length = builder.CreateInt64ConstantInsn(10);
+    builder.CreateJmpInsn(bb1);
+
+    builder.SetBasicBlockScope(bb1);
+    auto *idx = builder.CreatePhiInsn(DataType::I64);
+    builder.CreateBgtInsn(idx, length, bb3, bb2);
+
+    builder.SetBasicBlockScope(bb2);
+    auto *check = builder.CreateBoundsCheckInsn(array, idx, length);
+    auto *load = builder.CreateLoadArrayInsn(DataType::U64, array, check);
+    auto *next = builder.CreateAddInsn(DataType::I64, idx, one);
+    builder.CreateJmpInsn(bb1);
+
+    idx->ResolveDependency(zero, bb0);
+    idx->ResolveDependency(next, bb2);
+
+    builder.SetBasicBlockScope(bb3);
+    builder.CreateRetInsn(DataType::VOID);
+
+    checkElimination.Run();
+
+    CompareInputs<2U>(load, {array, check});
+}
+
 }  // namespace compiler::tests
@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
 
+#include "optimizations/constant_folding.h"
 #include "optimizations/peepholes.h"
 #include "ir/ir_builder-inl.h"
+#include "utils/bit_utils.h"
+
+#include <cmath>
+#include <limits>
 
 namespace compiler::tests {
 
@@ -13,26 +18,29 @@ TEST(ConstantFolding, MUL_INT_CONST)
 
     /*
         entryBB:
+            p.i64 Parameter 0
             0.i64 Constant 2
             1.i64 Constant 120
             2.i64 mul v0, v1
-            3.i64 add v2, v0
-            4.i64 sub v2, v1
+            3.i64 add v2, p
+            4.i64 sub v2, p
             ==>
             0.i64 Constant 2
             1.i64 Constant 120
             5.i64 Constant 240
-            3.i64 add v5, v0
-            4.i64 sub v5, v1
+            3.i64 add v5, p
+            4.i64 sub v5, p
     */
     auto *entryBB = builder.CreateBB();
     builder.SetBasicBlockScope(entryBB);
 
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+
     auto *v0 = builder.CreateInt64ConstantInsn(2);
     auto *v1 = builder.CreateInt64ConstantInsn(120);
     auto *v2 = builder.CreateMulInsn(DataType::I64, v0, v1);
-    auto *v3 = builder.CreateAddInsn(DataType::I64, v2, v0);
-    auto *v4 = builder.CreateSubInsn(DataType::I64, v2, v1);
+    auto *v3 = builder.CreateAddInsn(DataType::I64, v2, param);
+    auto *v4 = builder.CreateSubInsn(DataType::I64, v2, param);
 
     peepholes.Run();
 
@@ -42,11 +50,11 @@ TEST(ConstantFolding, MUL_INT_CONST)
 
     ASSERT_TRUE(v4->GetUsers().empty());
 
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v5);
+    ASSERT_EQ(v3->GetInput(1), param);
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v5);
+    ASSERT_EQ(v4->GetInput(1), param);
 
     auto &v5users = v5->GetUsers();
     ASSERT_EQ(v5users.size(), 2);
@@ -68,14 +76,16 @@ TEST(ConstantFolding, MUL_FLOAT_CONST)
     auto *entryBB = builder.CreateBB();
     builder.SetBasicBlockScope(entryBB);
 
+    auto *param = builder.CreateParameterInsn(0, DataType::F32);
+
     float CONST_1 = 2.11;
     float CONST_2 = 1234.321;
 
     auto *v0 = builder.CreateFloat32ConstantInsn(CONST_1);
     auto *v1 = builder.CreateFloat32ConstantInsn(CONST_2);
     auto *v2 = builder.CreateMulInsn(DataType::F32, v0, v1);
-    auto *v3 = builder.CreateAddInsn(DataType::F32, v2, v0);
-    auto *v4 = builder.CreateSubInsn(DataType::F32, v2, v1);
+    auto *v3 = builder.CreateAddInsn(DataType::F32, v2, param);
+    auto *v4 = builder.CreateSubInsn(DataType::F32, v2, param);
 
     peepholes.Run();
 
@@ -85,11 +95,11 @@ TEST(ConstantFolding, MUL_FLOAT_CONST)
 
     ASSERT_TRUE(v4->GetUsers().empty());
 
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v5);
+    ASSERT_EQ(v3->GetInput(1), param);
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v5);
+    ASSERT_EQ(v4->GetInput(1), param);
 
     auto &v5users = v5->GetUsers();
     ASSERT_EQ(v5users.size(), 2);
@@ -111,14 +121,16 @@ TEST(ConstantFolding, MUL_DOUBLE_CONST)
     auto *entryBB = builder.CreateBB();
     builder.SetBasicBlockScope(entryBB);
 
+    auto *param = builder.CreateParameterInsn(0, DataType::F64);
+
     double CONST_1 = 24.11;
     double CONST_2 = 424.42;
 
     auto *v0 = builder.CreateFloat64ConstantInsn(CONST_1);
     auto *v1 = builder.CreateFloat64ConstantInsn(CONST_2);
     auto *v2 = builder.CreateMulInsn(DataType::F64, v0, v1);
-    auto *v3 = builder.CreateAddInsn(DataType::F64, v2, v0);
-    auto *v4 = builder.CreateSubInsn(DataType::F64, v2, v1);
+    auto *v3 = builder.CreateAddInsn(DataType::F64, v2, param);
+    auto *v4 = builder.CreateSubInsn(DataType::F64, v2, param);
 
     peepholes.Run();
 
@@ -128,11 +140,11 @@ TEST(ConstantFolding, MUL_DOUBLE_CONST)
 
     ASSERT_TRUE(v4->GetUsers().empty());
 
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v5);
+    ASSERT_EQ(v3->GetInput(1), param);
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v5);
+    ASSERT_EQ(v4->GetInput(1), param);
 
     auto &v5users = v5->GetUsers();
     ASSERT_EQ(v5users.size(), 2);
@@ -154,14 +166,16 @@ TEST(ConstantFolding, ASHR_INT64_CONST)
     auto *entryBB = builder.CreateBB();
     builder.SetBasicBlockScope(entryBB);
 
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+
     int64_t CONST_1 = -128;
     int64_t CONST_2 = 2;
 
     auto *v0 = builder.CreateInt64ConstantInsn(CONST_1);
     auto *v1 = builder.CreateInt64ConstantInsn(CONST_2);
     auto *v2 = builder.CreateAshrInsn(DataType::I64, v0, v1);
-    auto *v3 = builder.CreateAddInsn(DataType::I64, v2, v0);
-    auto *v4 = builder.CreateSubInsn(DataType::I64, v2, v1);
+    auto *v3 = builder.CreateAddInsn(DataType::I64, v2, param);
+    auto *v4 = builder.CreateSubInsn(DataType::I64, v2, param);
 
     peepholes.Run();
 
@@ -171,11 +185,11 @@ TEST(ConstantFolding, ASHR_INT64_CONST)
 
     ASSERT_TRUE(v4->GetUsers().empty());
 
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v5);
+    ASSERT_EQ(v3->GetInput(1), param);
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v5);
+    ASSERT_EQ(v4->GetInput(1), param);
 
     auto &v5users = v5->GetUsers();
     ASSERT_EQ(v5users.size(), 2);
@@ -197,14 +211,16 @@ TEST(ConstantFolding, ASHR_INT32_CONST)
     auto *entryBB = builder.CreateBB();
     builder.SetBasicBlockScope(entryBB);
 
+    auto *param = builder.CreateParameterInsn(0, DataType::I32);
+
     int32_t CONST_1 = -128;
     int32_t CONST_2 = 2;
 
     auto *v0 = builder.CreateInt32ConstantInsn(CONST_1);
     auto *v1 = builder.CreateInt32ConstantInsn(CONST_2);
     auto *v2 = builder.CreateAshrInsn(DataType::I32, v0, v1);
-    auto *v3 = builder.CreateAddInsn(DataType::I32, v2, v0);
-    auto *v4 = builder.CreateSubInsn(DataType::I32, v2, v1);
+    auto *v3 = builder.CreateAddInsn(DataType::I32, v2, param);
+    auto *v4 = builder.CreateSubInsn(DataType::I32, v2, param);
 
     peepholes.Run();
 
@@ -214,11 +230,11 @@ TEST(ConstantFolding, ASHR_INT32_CONST)
 
     ASSERT_TRUE(v4->GetUsers().empty());
 
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v5);
+    ASSERT_EQ(v3->GetInput(1), param);
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v5);
+    ASSERT_EQ(v4->GetInput(1), param);
 
     auto &v5users = v5->GetUsers();
     ASSERT_EQ(v5users.size(), 2);
@@ -240,14 +256,16 @@ TEST(ConstantFolding, OR_INT64_CONST)
     auto *entryBB = builder.CreateBB();
     builder.SetBasicBlockScope(entryBB);
 
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+
     int64_t CONST_1 = -128;
     int64_t CONST_2 = 2;
 
     auto *v0 = builder.CreateInt64ConstantInsn(CONST_1);
     auto *v1 = builder.CreateInt64ConstantInsn(CONST_2);
     auto *v2 = builder.CreateOrInsn(DataType::I64, v0, v1);
-    auto *v3 = builder.CreateAddInsn(DataType::I64, v2, v0);
-    auto *v4 = builder.CreateSubInsn(DataType::I64, v2, v1);
+    auto *v3 = builder.CreateAddInsn(DataType::I64, v2, param);
+    auto *v4 = builder.CreateSubInsn(DataType::I64, v2, param);
 
     peepholes.Run();
 
@@ -257,11 +275,11 @@ TEST(ConstantFolding, OR_INT64_CONST)
 
     ASSERT_TRUE(v4->GetUsers().empty());
 
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v5);
+    ASSERT_EQ(v3->GetInput(1), param);
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v5);
+    ASSERT_EQ(v4->GetInput(1), param);
 
     auto &v5users = v5->GetUsers();
     ASSERT_EQ(v5users.size(), 2);
@@ -283,14 +301,16 @@ TEST(ConstantFolding, OR_INT32_CONST)
     auto *entryBB = builder.CreateBB();
     builder.SetBasicBlockScope(entryBB);
 
+    auto *param = builder.CreateParameterInsn(0, DataType::I32);
+
     int32_t CONST_1 = -128;
     int32_t CONST_2 = 2;
 
     auto *v0 = builder.CreateInt32ConstantInsn(CONST_1);
     auto *v1 = builder.CreateInt32ConstantInsn(CONST_2);
     auto *v2 = builder.CreateOrInsn(DataType::I32, v0, v1);
-    auto *v3 = builder.CreateAddInsn(DataType::I32, v2, v0);
-    auto *v4 = builder.CreateSubInsn(DataType::I32, v2, v1);
+    auto *v3 = builder.CreateAddInsn(DataType::I32, v2, param);
+    auto *v4 = builder.CreateSubInsn(DataType::I32, v2, param);
 
     peepholes.Run();
 
@@ -300,11 +320,11 @@ TEST(ConstantFolding, OR_INT32_CONST)
 
     ASSERT_TRUE(v4->GetUsers().empty());
 
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v5);
+    ASSERT_EQ(v3->GetInput(1), param);
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v5);
+    ASSERT_EQ(v4->GetInput(1), param);
 
     auto &v5users = v5->GetUsers();
     ASSERT_EQ(v5users.size(), 2);
@@ -317,4 +337,90 @@ TEST(ConstantFolding, OR_INT32_CONST)
     }
 }
 
+static std::optional<uint64_t> Fold(Opcode opcode, DataType type, int64_t lhs, int64_t rhs)
+{
+    return FoldBinaryOperation(opcode, type, static_cast<uint64_t>(lhs), static_cast<uint64_t>(rhs));
+}
+
+TEST(ConstantFolding, INTEGER_SEMANTICS)
+{
+    // Results wrap around the width and are extended back with the sign or zeros.
+    ASSERT_EQ(Fold(Opcode::ADD, DataType::I8, INT8_MAX, 1), static_cast<uint64_t>(INT8_MIN));
+    ASSERT_EQ(Fold(Opcode::SUB, DataType::U8, 0, 1), UINT8_MAX);
+    ASSERT_EQ(Fold(Opcode::MUL, DataType::U16, UINT16_MAX, UINT16_MAX), 1U);
+    ASSERT_EQ(Fold(Opcode::MUL, DataType::I64, INT64_MAX, 2), static_cast<uint64_t>(-2));
+    ASSERT_EQ(Fold(Opcode::DIV, DataType::I32, INT32_MIN, -1), static_cast<uint64_t>(INT32_MIN));
+    ASSERT_EQ(Fold(Opcode::REM, DataType::I64, INT64_MIN, -1), 0U);
+    ASSERT_EQ(Fold(Opcode::DIV, DataType::U32, -2, 2), static_cast<uint64_t>(INT32_MAX));
+    ASSERT_EQ(Fold(Opcode::REM, DataType::I16, -7, 3), static_cast<uint64_t>(-1));
+    ASSERT_EQ(Fold(Opcode::XOR, DataType::I32, -1, 0xff), static_cast<uint64_t>(~0xff));
+
+    // Shift amounts are masked by the width.
+    ASSERT_EQ(Fold(Opcode::SHL, DataType::I32, 1, 33), 2U);
+    ASSERT_EQ(Fold(Opcode::SHL, DataType::I8, 1, 7), static_cast<uint64_t>(INT8_MIN));
+    ASSERT_EQ(Fold(Opcode::SHR, DataType::I32, -1, 28), 0xfU);
+    ASSERT_EQ(Fold(Opcode::ASHR, DataType::U8, UINT8_MAX, 4), UINT8_MAX);
+    ASSERT_EQ(Fold(Opcode::ASHR, DataType::I64, -256, 68), static_cast<uint64_t>(-16));
+
+    ASSERT_FALSE(Fold(Opcode::DIV, DataType::I32, 1, 0));
+    ASSERT_FALSE(Fold(Opcode::REM, DataType::U64, 1, 0));
+    ASSERT_FALSE(Fold(Opcode::BEQ, DataType::I32, 1, 1));
+    ASSERT_FALSE(Fold(Opcode::ADD, DataType::REF, 1, 1));
+}
+
+TEST(ConstantFolding, FLOAT_SEMANTICS)
+{
+    auto bits = [](double value) { return utils::bit_cast<uint64_t>(value); };
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    auto sum = FoldBinaryOperation(Opcode::ADD, DataType::F64, bits(nan), bits(1.0));
+    ASSERT_TRUE(sum && std::isnan(utils::bit_cast<double>(*sum)));
+    auto quotient = FoldBinaryOperation(Opcode::DIV, DataType::F64, bits(-1.0), bits(0.0));
+    ASSERT_EQ(quotient, bits(-std::numeric_limits<double>::infinity()));
+    auto rem = FoldBinaryOperation(Opcode::REM, DataType::F32, utils::bit_cast<uint32_t>(-7.5F),
+                                   utils::bit_cast<uint32_t>(2.0F));
+    ASSERT_EQ(rem, utils::bit_cast<uint32_t>(-1.5F));
+
+    ASSERT_FALSE(FoldBinaryOperation(Opcode::AND, DataType::F32, 0, 0));
+    ASSERT_FALSE(FoldBinaryOperation(Opcode::SHL, DataType::F64, 0, 0));
+}
+
+TEST(ConstantFolding, ALL_OPCODES)
+{
+    Graph graph;
+    Peepholes peepholes(&graph);
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *v0 = builder.CreateConstantInsn(int64_t {100}, DataType::I8);
+    auto *v1 = builder.CreateConstantInsn(int64_t {0}, DataType::I8);
+    auto *v2 = builder.CreateAddInsn(DataType::I8, v0, v0);
+    auto *v3 = builder.CreateAndInsn(DataType::I8, v2, v0);
+    auto *v4 = builder.CreateDivInsn(DataType::I8, v3, v1);
+    auto *v5 = builder.CreateFloat64ConstantInsn(0.5);
+    auto *v6 = builder.CreateSubInsn(DataType::F64, v5, v5);
+    builder.CreateCallStaticInsn(DataType::VOID, graph.GetMethodId(), {{v4, DataType::I8}, {v6, DataType::F64}});
+
+    peepholes.Run();
+
+    // 200 wraps around to -56, which has only the bit 64 in common with 100.
+    auto *v7 = v4->GetInput(0);
+    ASSERT_TRUE(v7->IsConst());
+    ASSERT_EQ(v7->AsConst()->GetAsI64(), 64);
+    ASSERT_EQ(v7->GetResultType(), DataType::I8);
+    ASSERT_TRUE(v2->GetUsers().empty());
+    ASSERT_TRUE(v3->GetUsers().empty());
+
+    // Division by zero stays.
+    ASSERT_EQ(v4->GetInput(1), v1);
+    ASSERT_FALSE(v4->GetUsers().empty());
+
+    auto *v8 = v5->GetNext();
+    ASSERT_TRUE(v8->IsConst());
+    ASSERT_TRUE(v8->AsConst()->IsEqual(0.0));
+    ASSERT_TRUE(v6->GetUsers().empty());
+}
+
 }  // namespace compiler::tests
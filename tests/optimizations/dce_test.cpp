@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "tests/test_helper.h"
+
+#include "ir/ir_builder-inl.h"
+#include "optimizations/dead_code_elimination.h"
+
+namespace compiler::tests {
+
+/*
+    0.i64 Parameter 0
+    1.i64 Constant 2
+    2.i64 add v0, v1        unused
+    3.i64 mul v2, v0        unused
+    4.i64 sub v0, v1
+    5.i64 Ret v4
+*/
+TEST(DeadCodeElimination, Chain)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    builder.SetBasicBlockScope(builder.CreateBB());
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *two = builder.CreateInt64ConstantInsn(2);
+    auto *add = builder.CreateAddInsn(DataType::I64, param, two);
+    builder.CreateMulInsn(DataType::I64, add, param);
+    auto *sub = builder.CreateSubInsn(DataType::I64, param, two);
+    auto *ret = builder.CreateRetInsn(DataType::I64, sub);
+
+    DeadCodeElimination(&graph).Run();
+
+    ASSERT_EQ(graph.GetInstructions().size(), 4U);
+    ASSERT_EQ(param->GetUsers().size(), 1U);
+    CompareInputs<2U>(sub, {param, two});
+    ASSERT_EQ(ret->GetId(), 3U);
+}
+
+/*
+    BB_0: jmp BB_2
+    BB_1: v0 = add p, p; jmp BB_2       unreachable
+    BB_2: v1 = phi(p, BB_0; v0, BB_1); ret v1
+*/
+TEST(DeadCodeElimination, UnreachableBlocks)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *deadBB = builder.CreateBB();
+    auto *joinBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(deadBB);
+    auto *add = builder.CreateAddInsn(DataType::I64, param, param);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(joinBB);
+    auto *phi = builder.CreatePhiInsn(DataType::I64);
+    phi->ResolveDependency(param, entryBB);
+    phi->ResolveDependency(add, deadBB);
+    builder.CreateRetInsn(DataType::I64, phi);
+
+    ASSERT_EQ(graph.GetAliveBlockCount(), 3U);
+    DeadCodeElimination(&graph).Run();
+
+    ASSERT_EQ(graph.GetAliveBlockCount(), 2U);
+    ASSERT_EQ(joinBB->GetPredecessors().size(), 1U);
+    ASSERT_EQ(joinBB->GetId(), 1U);
+    ASSERT_EQ(phi->GetDependencies().size(), 1U);
+    CompareInputs<1U>(phi, {param});
+    ASSERT_EQ(param->GetUsers().size(), 1U);
+}
+
+/*
+    BB_0: jmp BB_1
+    BB_1: v0 = phi(c0, BB_0; v1, BB_1); v1 = add v0, c1; StoreArray a, i, v; bgt i, c0, BB_1, BB_2
+    BB_2: ret
+
+    The induction variable is only used by itself.
+*/
+TEST(DeadCodeElimination, PhiCycle)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *loopBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *arr = builder.CreateParameterInsn(0, DataType::REF);
+    auto *idx = builder.CreateParameterInsn(1, DataType::U32);
+    auto *value = builder.CreateParameterInsn(2, DataType::U32);
+    auto *zero = builder.CreateInt64ConstantInsn(0);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    builder.CreateJmpInsn(loopBB);
+
+    builder.SetBasicBlockScope(loopBB);
+    auto *phi = builder.CreatePhiInsn(DataType::I64);
+    auto *next = builder.CreateAddInsn(DataType::I64, phi, one);
+    phi->ResolveDependency(zero, entryBB);
+    phi->ResolveDependency(next, loopBB);
+    builder.CreateStoreArrayInsn(DataType::U32, arr, idx, value);
+    builder.CreateBgtInsn(idx, zero, loopBB, exitBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    builder.CreateRetInsn(DataType::VOID);
+
+    DeadCodeElimination(&graph).Run();
+
+    ASSERT_EQ(loopBB->GetFirstInsn()->GetOpcode(), Opcode::STOREARRAY);
+    ASSERT_TRUE(one->GetUsers().empty());
+    ASSERT_EQ(zero->GetUsers().size(), 1U);
+    ASSERT_EQ(graph.GetAliveBlockCount(), 3U);
+}
+
+}  // namespace compiler::tests
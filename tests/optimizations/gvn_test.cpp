@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include "tests/test_helper.h"
+
+#include "ir/ir_builder-inl.h"
+#include "optimizations/gvn.h"
+#include "optimizations/sccp.h"
+
+namespace compiler::tests {
+
+static size_t CountInsns(BasicBlock *block)
+{
+    size_t count = 0;
+    block->EnumerateInsns([&count](Instruction *) {
+        ++count;
+        return false;
+    });
+    return count;
+}
+
+/*
+    0.ref Parameter 0
+    1.u32 Parameter 1
+    2.i64 Constant 5
+    3.i64 Constant 5       -> v2
+    4.i32 Constant 5
+    5.i64 add v1, v2
+    6.i64 add v3, v1       -> v5
+    7.i64 sub v1, v2
+    8.i64 sub v2, v1
+    9.ref NullCheck v0
+   10.ref NullCheck v0     -> v9
+   11.i64 LoadArray v10, v6
+   12.i64 StoreArray v9, v7, v11
+   13.i32 StoreArray v9, v8, v4
+*/
+TEST(Gvn, Block)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *arr = builder.CreateParameterInsn(0, DataType::REF);
+    auto *param = builder.CreateParameterInsn(1, DataType::U32);
+    auto *c5 = builder.CreateInt64ConstantInsn(5);
+    auto *c5Copy = builder.CreateInt64ConstantInsn(5);
+    auto *c5I32 = builder.CreateConstantInsn(int64_t {5}, DataType::I32);
+    auto *add = builder.CreateAddInsn(DataType::I64, param, c5);
+    auto *addCopy = builder.CreateAddInsn(DataType::I64, c5Copy, param);
+    auto *sub = builder.CreateSubInsn(DataType::I64, param, c5);
+    auto *subSwapped = builder.CreateSubInsn(DataType::I64, c5, param);
+    auto *check = builder.CreateNullcheckInsn(arr);
+    auto *checkCopy = builder.CreateNullcheckInsn(arr);
+    auto *load = builder.CreateLoadArrayInsn(DataType::I64, checkCopy, addCopy);
+    builder.CreateStoreArrayInsn(DataType::I64, check, sub, load);
+    builder.CreateStoreArrayInsn(DataType::I32, check, subSwapped, c5I32);
+
+    Gvn(&graph).Run();
+
+    ASSERT_EQ(CountInsns(entryBB), 11U);
+    CompareInputs<2U>(load, {check, add});
+    CompareInputs<2U>(add, {param, c5});
+    ASSERT_TRUE(c5Copy->GetUsers().empty());
+    ASSERT_FALSE(subSwapped->GetUsers().empty());
+    ASSERT_FALSE(c5I32->GetUsers().empty());
+}
+
+/*
+    BB_0: v0 = add p, p; bgt p, p, BB_1, BB_2
+    BB_1: v1 = add p, p; v2 = mul v1, p
+    BB_2: v3 = mul v0, p
+    BB_3: v4 = mul v0, p
+
+    Only the duplicate in BB_1 is dominated by an equal value.
+*/
+TEST(Gvn, DominatorScopes)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *thenBB = builder.CreateBB();
+    auto *elseBB = builder.CreateBB();
+    auto *joinBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *sum = builder.CreateAddInsn(DataType::I64, param, param);
+    builder.CreateBgtInsn(param, param, thenBB, elseBB);
+
+    builder.SetBasicBlockScope(thenBB);
+    auto *sumCopy = builder.CreateAddInsn(DataType::I64, param, param);
+    auto *thenMul = builder.CreateMulInsn(DataType::I64, sumCopy, param);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(elseBB);
+    auto *elseMul = builder.CreateMulInsn(DataType::I64, sum, param);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(joinBB);
+    auto *phi = builder.CreatePhiInsn(DataType::I64);
+    phi->ResolveDependency(thenMul, thenBB);
+    phi->ResolveDependency(elseMul, elseBB);
+    auto *joinMul = builder.CreateMulInsn(DataType::I64, sum, param);
+    auto *result = builder.CreateAddInsn(DataType::I64, phi, joinMul);
+    builder.CreateRetInsn(DataType::I64, result);
+
+    Gvn(&graph).Run();
+
+    ASSERT_EQ(CountInsns(thenBB), 2U);
+    CompareInputs<2U>(thenMul, {sum, param});
+    ASSERT_EQ(CountInsns(elseBB), 2U);
+    CompareInputs<2U>(phi, {thenMul, elseMul});
+    CompareInputs<2U>(result, {phi, joinMul});
+}
+
+/*
+    BB_0:
+        v0 = LoadArray a, i
+        StoreArray b, i, v0     doesn't touch `a`
+        v1 = LoadArray a, i     -> v0
+        StoreArray a, j, v1     may overwrite a[i]
+        v2 = LoadArray a, i
+        bgt i, j, BB_1, BB_2
+    BB_1:
+        v3 = LoadArray a, i     -> v2, the only predecessor is BB_0
+        CallStatic
+        v4 = LoadArray a, i
+    BB_2:
+        v5 = LoadArray a, i     stores may happen in BB_1
+*/
+TEST(Gvn, Loads)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *bodyBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *arr = builder.CreateParameterInsn(0, DataType::REF);
+    auto *otherArr = builder.CreateParameterInsn(1, DataType::REF);
+    auto *idx = builder.CreateParameterInsn(2, DataType::U32);
+    auto *otherIdx = builder.CreateParameterInsn(3, DataType::U32);
+    auto *load0 = builder.CreateLoadArrayInsn(DataType::I64, arr, idx);
+    builder.CreateStoreArrayInsn(DataType::I64, otherArr, idx, load0);
+    auto *load1 = builder.CreateLoadArrayInsn(DataType::I64, arr, idx);
+    builder.CreateStoreArrayInsn(DataType::I64, arr, otherIdx, load1);
+    auto *load2 = builder.CreateLoadArrayInsn(DataType::I64, arr, idx);
+    builder.CreateBgtInsn(idx, otherIdx, bodyBB, exitBB);
+
+    builder.SetBasicBlockScope(bodyBB);
+    auto *load3 = builder.CreateLoadArrayInsn(DataType::I64, arr, idx);
+    builder.CreateCallStaticInsn(DataType::VOID, graph.GetMethodId(), {{load3, DataType::I64}});
+    auto *load4 = builder.CreateLoadArrayInsn(DataType::I64, arr, idx);
+    builder.CreateStoreArrayInsn(DataType::I64, otherArr, otherIdx, load4);
+    builder.CreateJmpInsn(exitBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    auto *load5 = builder.CreateLoadArrayInsn(DataType::I64, arr, idx);
+    auto *sum = builder.CreateAddInsn(DataType::I64, load2, load5);
+    builder.CreateRetInsn(DataType::I64, sum);
+
+    Gvn(&graph).Run();
+
+    ASSERT_TRUE(load1->GetUsers().empty());
+    ASSERT_TRUE(load3->GetUsers().empty());
+    ASSERT_EQ(CountInsns(entryBB), 9U);
+    ASSERT_EQ(CountInsns(bodyBB), 4U);
+    CompareInputs<2U>(sum, {load2, load5});
+}
+
+/*
+    BB_0: v0 = add c1, c2; bgt p, p, BB_1, BB_2
+    BB_1: v1 = add c1, c2       -> v0
+    BB_2:
+    BB_3: v2 = phi(v0, BB_1; v1, BB_2); ret v2
+
+    The phi merges v0 from both blocks in a single slot, which is replaced by the next pass.
+*/
+TEST(Gvn, PhiWithEqualInputs)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *thenBB = builder.CreateBB();
+    auto *elseBB = builder.CreateBB();
+    auto *joinBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    auto *two = builder.CreateInt64ConstantInsn(2);
+    auto *sum = builder.CreateAddInsn(DataType::I64, one, two);
+    builder.CreateBgtInsn(param, param, thenBB, elseBB);
+
+    builder.SetBasicBlockScope(thenBB);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(elseBB);
+    auto *sumCopy = builder.CreateAddInsn(DataType::I64, one, two);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(joinBB);
+    auto *phi = builder.CreatePhiInsn(DataType::I64);
+    phi->ResolveDependency(sum, thenBB);
+    phi->ResolveDependency(sumCopy, elseBB);
+    auto *ret = builder.CreateRetInsn(DataType::I64, phi);
+
+    Gvn(&graph).Run();
+
+    CompareInputs<1U>(phi, {sum});
+    ASSERT_TRUE(sumCopy->GetUsers().empty());
+
+    Sccp(&graph).Run();
+
+    auto *result = ret->GetInput(0);
+    ASSERT_TRUE(result->IsConst());
+    ASSERT_EQ(result->AsConst()->GetAsI64(), 3);
+    ASSERT_TRUE(sum->GetUsers().empty());
+}
+
+}  // namespace compiler::tests
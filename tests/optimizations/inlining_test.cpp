@@ -0,0 +1,305 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "tests/test_helper.h"
+
+#include "ir/ir_builder-inl.h"
+#include "ir/method_registry.h"
+#include "optimizations/inlining.h"
+
+namespace compiler::tests {
+
+static size_t CountCalls(const Graph &graph)
+{
+    size_t count = 0;
+    for (auto *block : graph.GetBlocks()) {
+        block->EnumerateInsns([&count](Instruction *insn) {
+            count += insn->IsCall() ? 1U : 0U;
+            return false;
+        });
+    }
+    return count;
+}
+
+// int64_t add(int64_t a, int64_t b) { return a + b; }
+static void BuildAdd(Graph *graph)
+{
+    IrBuilder builder(graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *lhs = builder.CreateParameterInsn(0, DataType::I64);
+    auto *rhs = builder.CreateParameterInsn(1, DataType::I64);
+    auto *sum = builder.CreateAddInsn(DataType::I64, lhs, rhs);
+    builder.CreateRetInsn(DataType::I64, sum);
+}
+
+/*
+    int64_t fact(int64_t n) {
+        if (n > 1) {
+            return n * fact(n - 1);
+        }
+        return 1;
+    }
+*/
+static void BuildFactorial(Graph *graph)
+{
+    IrBuilder builder(graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *recBB = builder.CreateBB();
+    auto *baseBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    builder.CreateBgtInsn(param, one, recBB, baseBB);
+
+    builder.SetBasicBlockScope(recBB);
+    auto *prev = builder.CreateSubInsn(DataType::I64, param, one);
+    auto *call = builder.CreateCallStaticInsn(DataType::I64, graph->GetMethodId(), {{prev, DataType::I64}});
+    auto *mul = builder.CreateMulInsn(DataType::I64, param, call);
+    builder.CreateRetInsn(DataType::I64, mul);
+
+    builder.SetBasicBlockScope(baseBB);
+    builder.CreateRetInsn(DataType::I64, one);
+}
+
+TEST(Inlining, Simple)
+{
+    MethodRegistry registry;
+    Graph callee;
+    BuildAdd(&callee);
+    registry.Register(&callee);
+
+    Graph graph;
+    registry.Register(&graph);
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *two = builder.CreateInt64ConstantInsn(2);
+    auto *call = builder.CreateCallStaticInsn(DataType::I64, callee.GetMethodId(),
+                                              {{param, DataType::I64}, {two, DataType::I64}});
+    auto *ret = builder.CreateRetInsn(DataType::I64, call);
+
+    Inlining(&graph).Run();
+
+    ASSERT_EQ(CountCalls(graph), 0U);
+    ASSERT_EQ(graph.GetBlocks().size(), 3U);
+    ASSERT_TRUE(entryBB->GetLastInsn()->IsJmp());
+
+    auto *sum = ret->GetInput(0);
+    ASSERT_EQ(sum->GetOpcode(), Opcode::ADD);
+    CompareInputs<2U>(sum, {param, two});
+    ASSERT_NE(ret->GetParentBB(), entryBB);
+    ASSERT_EQ(ret->GetParentBB()->GetPredecessors().size(), 1U);
+}
+
+/*
+    max(a, b):
+        BB_0: bgt a, b, BB_1, BB_2
+        BB_1: ret a
+        BB_2: ret b
+
+    Both returns jump to the rest of the call block, which merges the values.
+*/
+TEST(Inlining, MultipleReturns)
+{
+    MethodRegistry registry;
+    Graph callee;
+    {
+        IrBuilder builder(&callee);
+        auto *entryBB = builder.CreateBB();
+        auto *lhsBB = builder.CreateBB();
+        auto *rhsBB = builder.CreateBB();
+
+        builder.SetBasicBlockScope(entryBB);
+        auto *lhs = builder.CreateParameterInsn(0, DataType::I64);
+        auto *rhs = builder.CreateParameterInsn(1, DataType::I64);
+        builder.CreateBgtInsn(lhs, rhs, lhsBB, rhsBB);
+
+        builder.SetBasicBlockScope(lhsBB);
+        builder.CreateRetInsn(DataType::I64, lhs);
+        builder.SetBasicBlockScope(rhsBB);
+        builder.CreateRetInsn(DataType::I64, rhs);
+    }
+    registry.Register(&callee);
+
+    Graph graph;
+    registry.Register(&graph);
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+    auto *param0 = builder.CreateParameterInsn(0, DataType::I64);
+    auto *param1 = builder.CreateParameterInsn(1, DataType::I64);
+    auto *call = builder.CreateCallStaticInsn(DataType::I64, callee.GetMethodId(),
+                                              {{param0, DataType::I64}, {param1, DataType::I64}});
+    auto *ret = builder.CreateRetInsn(DataType::I64, call);
+
+    Inlining(&graph).Run();
+
+    ASSERT_EQ(CountCalls(graph), 0U);
+
+    auto *phi = ret->GetInput(0);
+    ASSERT_TRUE(phi->IsPhi());
+    ASSERT_EQ(phi->GetParentBB(), ret->GetParentBB());
+    ASSERT_EQ(phi->GetInputsCount(), 2U);
+    ASSERT_THAT((std::array {phi->GetInput(0), phi->GetInput(1)}), ::testing::UnorderedElementsAre(param0, param1));
+
+    const auto &deps = static_cast<PhiInsn *>(phi)->GetDependencies();
+    ASSERT_EQ(deps.size(), 2U);
+    ASSERT_THAT(phi->GetParentBB()->GetPredecessors(), ::testing::ElementsAre(deps[0].block, deps[1].block));
+}
+
+// Callee of the callee is inlined as well.
+TEST(Inlining, Nested)
+{
+    MethodRegistry registry;
+    Graph add;
+    BuildAdd(&add);
+    registry.Register(&add);
+
+    // int64_t inc(int64_t a) { return add(a, 1); }
+    Graph inc;
+    {
+        IrBuilder builder(&inc);
+        builder.SetBasicBlockScope(builder.CreateBB());
+        auto *param = builder.CreateParameterInsn(0, DataType::I64);
+        auto *one = builder.CreateInt64ConstantInsn(1);
+        auto *call = builder.CreateCallStaticInsn(DataType::I64, add.GetMethodId(),
+                                                  {{param, DataType::I64}, {one, DataType::I64}});
+        builder.CreateRetInsn(DataType::I64, call);
+    }
+    registry.Register(&inc);
+
+    Graph graph;
+    registry.Register(&graph);
+    IrBuilder builder(&graph);
+
+    builder.SetBasicBlockScope(builder.CreateBB());
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *call = builder.CreateCallStaticInsn(DataType::I64, inc.GetMethodId(), {{param, DataType::I64}});
+    auto *ret = builder.CreateRetInsn(DataType::I64, call);
+
+    Inlining(&graph).Run();
+
+    ASSERT_EQ(CountCalls(graph), 0U);
+    auto *sum = ret->GetInput(0);
+    ASSERT_EQ(sum->GetOpcode(), Opcode::ADD);
+    ASSERT_EQ(sum->GetInput(0), param);
+    ASSERT_TRUE(sum->GetInput(1)->IsConst());
+
+    // The callees are not changed.
+    ASSERT_EQ(CountCalls(inc), 1U);
+}
+
+// Recursive callee is inlined once, the call inside of it stays.
+TEST(Inlining, Recursion)
+{
+    MethodRegistry registry;
+    Graph fact;
+    BuildFactorial(&fact);
+    registry.Register(&fact);
+
+    Inlining(&fact).Run();
+    ASSERT_EQ(CountCalls(fact), 1U);
+    ASSERT_EQ(fact.GetBlocks().size(), 3U);
+
+    Graph graph;
+    registry.Register(&graph);
+    IrBuilder builder(&graph);
+
+    builder.SetBasicBlockScope(builder.CreateBB());
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *call = builder.CreateCallStaticInsn(DataType::I64, fact.GetMethodId(), {{param, DataType::I64}});
+    builder.CreateRetInsn(DataType::I64, call);
+
+    Inlining(&graph).Run();
+
+    ASSERT_EQ(CountCalls(graph), 1U);
+    ASSERT_TRUE(call->GetUsers().empty());
+}
+
+TEST(Inlining, CostModel)
+{
+    ASSERT_TRUE(Inlining::IsProfitable(Inlining::SMALL_METHOD_INSNS, 0.01, 0));
+    ASSERT_TRUE(Inlining::IsProfitable(Inlining::CALLEE_INSNS_LIMIT, 1.0, 0));
+    ASSERT_FALSE(Inlining::IsProfitable(Inlining::CALLEE_INSNS_LIMIT, 0.5, 0));
+    ASSERT_FALSE(Inlining::IsProfitable(Inlining::CALLEE_INSNS_LIMIT, 1.0, 1));
+
+    // Call sites in loops take larger callees, up to the bound of the scale.
+    ASSERT_TRUE(Inlining::IsProfitable(3U * Inlining::CALLEE_INSNS_LIMIT, 10.0, 0));
+    ASSERT_FALSE(Inlining::IsProfitable(5U * Inlining::CALLEE_INSNS_LIMIT, 100.0, 0));
+
+    ASSERT_FALSE(Inlining::IsProfitable(1U, 1.0, Inlining::MAX_DEPTH));
+}
+
+// Unknown methods are left as calls.
+TEST(Inlining, UnknownCallee)
+{
+    MethodRegistry registry;
+    Graph graph;
+    registry.Register(&graph);
+    IrBuilder builder(&graph);
+
+    builder.SetBasicBlockScope(builder.CreateBB());
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    builder.CreateCallStaticInsn(DataType::VOID, graph.GetMethodId() + 1000U, {{param, DataType::I64}});
+    builder.CreateRetInsn(DataType::VOID);
+
+    Inlining(&graph).Run();
+
+    ASSERT_EQ(CountCalls(graph), 1U);
+    ASSERT_EQ(graph.GetBlocks().size(), 1U);
+}
+
+/*
+    loop(a):
+        BB_0: jmp BB_1
+        BB_1: jmp BB_1
+        BB_2: ret a
+
+    The only return is unreachable, so the callee never returns and is not inlined.
+*/
+TEST(Inlining, UnreachableReturn)
+{
+    MethodRegistry registry;
+    Graph callee;
+    {
+        IrBuilder builder(&callee);
+        auto *entryBB = builder.CreateBB();
+        auto *loopBB = builder.CreateBB();
+        auto *retBB = builder.CreateBB();
+
+        builder.SetBasicBlockScope(entryBB);
+        auto *param = builder.CreateParameterInsn(0, DataType::I64);
+        builder.CreateJmpInsn(loopBB);
+
+        builder.SetBasicBlockScope(loopBB);
+        builder.CreateJmpInsn(loopBB);
+
+        builder.SetBasicBlockScope(retBB);
+        builder.CreateRetInsn(DataType::I64, param);
+    }
+    registry.Register(&callee);
+
+    Graph graph;
+    registry.Register(&graph);
+    IrBuilder builder(&graph);
+
+    builder.SetBasicBlockScope(builder.CreateBB());
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *call = builder.CreateCallStaticInsn(DataType::I64, callee.GetMethodId(), {{param, DataType::I64}});
+    auto *ret = builder.CreateRetInsn(DataType::I64, call);
+
+    Inlining(&graph).Run();
+
+    ASSERT_EQ(CountCalls(graph), 1U);
+    ASSERT_EQ(ret->GetInput(0), call);
+    ASSERT_EQ(graph.GetBlocks().size(), 1U);
+}
+
+}  // namespace compiler::tests
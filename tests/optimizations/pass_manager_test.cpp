@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "ir/ir_builder-inl.h"
+#include "optimizations/pass_manager.h"
+
+namespace compiler::tests {
+
+/*
+    entryBB:
+        0.ref Parameter 0
+        1.u64 Constant 12
+        2.ref Nullcheck v0
+        3.u64 LoadArray v2, v1
+        4.ref Nullcheck v0
+        5.ref StoreArray v4, v1, v3
+*/
+static void BuildRedundantChecks(Graph *graph)
+{
+    IrBuilder builder(graph);
+
+    auto *entryBB = builder.CreateBB();
+    builder.SetBasicBlockScope(entryBB);
+
+    auto *v0 = builder.CreateParameterInsn(0, DataType::REF);
+    auto *v1 = builder.CreateInt64ConstantInsn(12);
+    auto *v2 = builder.CreateNullcheckInsn(v0);
+    auto *v3 = builder.CreateLoadArrayInsn(DataType::U64, v2, v1);
+    auto *v4 = builder.CreateNullcheckInsn(v0);
+    builder.CreateStoreArrayInsn(DataType::U64, v4, v1, v3);
+}
+
+TEST(PassManager, Pipeline)
+{
+    Graph graph;
+    BuildRedundantChecks(&graph);
+
+    PassManager passManager(&graph);
+    ASSERT_TRUE(passManager.SetPipeline("peepholes,check-elim"));
+    ASSERT_TRUE(passManager.Run());
+    ASSERT_FALSE(passManager.IsBudgetExceeded());
+
+    auto &statistics = passManager.GetStatistics();
+    ASSERT_EQ(statistics.size(), 2);
+    ASSERT_EQ(statistics[0].pass, PassId::PEEPHOLES);
+    ASSERT_EQ(statistics[1].pass, PassId::CHECK_ELIMINATION);
+
+    ASSERT_EQ(statistics[1].insnsBefore, 6);
+    ASSERT_EQ(statistics[1].insnsAfter, 5);
+    ASSERT_EQ(statistics[1].blocksBefore, 1);
+    ASSERT_EQ(statistics[1].blocksAfter, 1);
+    ASSERT_EQ(passManager.GetTotalTime(), statistics[0].time + statistics[1].time);
+
+    std::stringstream text;
+    passManager.DumpStatistics(text);
+    ASSERT_NE(text.str().find("check-elim"), std::string::npos);
+    ASSERT_NE(text.str().find("       insns      blocks"), std::string::npos);
+    ASSERT_NE(text.str().find("      6 -> 5      1 -> 1"), std::string::npos);
+
+    std::stringstream json;
+    passManager.DumpStatisticsJson(json);
+    ASSERT_NE(json.str().find("{\"name\": \"peepholes\""), std::string::npos);
+    ASSERT_NE(json.str().find("\"insns_before\": 6, \"insns_after\": 5"), std::string::npos);
+    ASSERT_NE(json.str().find("\"budget_exceeded\": false"), std::string::npos);
+}
+
+TEST(PassManager, UnknownPass)
+{
+    Graph graph;
+    BuildRedundantChecks(&graph);
+
+    PassManager passManager(&graph);
+    ASSERT_TRUE(passManager.SetPipeline("check-elim"));
+    ASSERT_FALSE(passManager.SetPipeline("peepholes,unknown"));
+
+    std::string_view unknownPass;
+    ASSERT_FALSE(passManager.SetPipeline("peepholes,unknown,check-elim", &unknownPass));
+    ASSERT_EQ(unknownPass, "unknown");
+
+    // The previous pipeline is kept.
+    ASSERT_TRUE(passManager.Run());
+    ASSERT_EQ(passManager.GetStatistics().size(), 1);
+    ASSERT_EQ(passManager.GetStatistics()[0].pass, PassId::CHECK_ELIMINATION);
+}
+
+TEST(PassManager, Budget)
+{
+    Graph graph;
+    BuildRedundantChecks(&graph);
+
+    PassManager passManager(&graph);
+    ASSERT_TRUE(passManager.SetPipeline("peepholes,check-elim,peepholes"));
+    passManager.SetTimeBudget(std::chrono::nanoseconds(1));
+
+    // The budget is checked between passes, so the first one always runs.
+    ASSERT_FALSE(passManager.Run());
+    ASSERT_TRUE(passManager.IsBudgetExceeded());
+    ASSERT_EQ(passManager.GetStatistics().size(), 1);
+
+    std::stringstream json;
+    passManager.DumpStatisticsJson(json);
+    ASSERT_NE(json.str().find("\"budget_exceeded\": true"), std::string::npos);
+}
+
+}  // namespace compiler::tests
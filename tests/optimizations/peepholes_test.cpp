@@ -14,13 +14,13 @@ TEST(Peepholes, IDENTICAL_MUL_CONSTANT_ON_RIGHT_SIDE)
     /*
         entryBB:
             0.u64 Constant 1
-            1.u64 Constant 120
+            1.u64 Parameter 0
             2.u64 add v0, v1
             3.u64 mul v2, v0
             4.u64 add v3, v0
             ==>
             0.u64 Constant 1
-            1.u64 Constant 120
+            1.u64 Parameter 0
             2.u64 add v0, v1
             3.u64 mul v2, v0
             4.u64 add v2, v0
@@ -29,7 +29,7 @@ TEST(Peepholes, IDENTICAL_MUL_CONSTANT_ON_RIGHT_SIDE)
     builder.SetBasicBlockScope(entryBB);
 
     auto *v0 = builder.CreateInt64ConstantInsn(1);
-    auto *v1 = builder.CreateInt64ConstantInsn(120);
+    auto *v1 = builder.CreateParameterInsn(0, DataType::U64);
     auto *v2 = builder.CreateAddInsn(DataType::U64, v0, v1);
     auto *v3 = builder.CreateMulInsn(DataType::U64, v2, v0);
     auto *v4 = builder.CreateAddInsn(DataType::U64, v3, v0);
@@ -37,15 +37,15 @@ TEST(Peepholes, IDENTICAL_MUL_CONSTANT_ON_RIGHT_SIDE)
     peepholes.Run();
 
     // Ensure that inputs did not change
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v2);
+    ASSERT_EQ(v3->GetInput(1), v0);
 
     // Check that there are no users
     ASSERT_TRUE(v3->GetUsers().empty());
 
     // Ensure that add have no mul result as input
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v4->GetInput(0), v2);
+    ASSERT_EQ(v4->GetInput(1), v0);
 }
 
 TEST(Peepholes, IDENTICAL_MUL_CONSTANT_ON_LEFT_SIDE)
@@ -57,13 +57,13 @@ TEST(Peepholes, IDENTICAL_MUL_CONSTANT_ON_LEFT_SIDE)
     /*
         entryBB:
             0.u64 Constant 1
-            1.u64 Constant 120
+            1.u64 Parameter 0
             2.u64 add v0, v1
             3.u64 mul v0, v2
             4.u64 add v3, v0
             ==>
             0.u64 Constant 1
-            1.u64 Constant 120
+            1.u64 Parameter 0
             2.u64 add v0, v1
             3.u64 mul v2, v0
             4.u64 add v2, v0
@@ -72,7 +72,7 @@ TEST(Peepholes, IDENTICAL_MUL_CONSTANT_ON_LEFT_SIDE)
     builder.SetBasicBlockScope(entryBB);
 
     auto *v0 = builder.CreateInt64ConstantInsn(1);
-    auto *v1 = builder.CreateInt64ConstantInsn(120);
+    auto *v1 = builder.CreateParameterInsn(0, DataType::U64);
     auto *v2 = builder.CreateAddInsn(DataType::U64, v0, v1);
     auto *v3 = builder.CreateMulInsn(DataType::U64, v0, v2);
     auto *v4 = builder.CreateAddInsn(DataType::U64, v3, v0);
@@ -80,15 +80,15 @@ TEST(Peepholes, IDENTICAL_MUL_CONSTANT_ON_LEFT_SIDE)
     peepholes.Run();
 
     // Ensure that inputs CHANGED
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v2);
+    ASSERT_EQ(v3->GetInput(1), v0);
 
     // Check that there are no users
     ASSERT_TRUE(v3->GetUsers().empty());
 
     // Ensure that add have no mul result as input
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v4->GetInput(0), v2);
+    ASSERT_EQ(v4->GetInput(1), v0);
 }
 
 TEST(Peepholes, IDENTICAL_MUL_WITH_MANY_USERS)
@@ -100,7 +100,7 @@ TEST(Peepholes, IDENTICAL_MUL_WITH_MANY_USERS)
     /*
         entryBB:
             0.u64 Constant 1
-            1.u64 Constant 120
+            1.u64 Parameter 0
             2.u64 add v0, v1
             3.u64 mul v0, v2
             4.u64 add v3, v0
@@ -108,7 +108,7 @@ TEST(Peepholes, IDENTICAL_MUL_WITH_MANY_USERS)
             6.u64 add v1, v3
             ==>
             0.u64 Constant 1
-            1.u64 Constant 120
+            1.u64 Parameter 0
             2.u64 add v0, v1
             3.u64 mul v0, v2
             4.u64 add v2, v0
@@ -120,7 +120,7 @@ TEST(Peepholes, IDENTICAL_MUL_WITH_MANY_USERS)
     builder.SetBasicBlockScope(entryBB);
 
     auto *v0 = builder.CreateInt64ConstantInsn(1);
-    auto *v1 = builder.CreateInt64ConstantInsn(120);
+    auto *v1 = builder.CreateParameterInsn(0, DataType::U64);
     auto *v2 = builder.CreateAddInsn(DataType::U64, v0, v1);
     auto *v3 = builder.CreateMulInsn(DataType::U64, v0, v2);
     auto *v4 = builder.CreateAddInsn(DataType::U64, v3, v0);
@@ -130,21 +130,21 @@ TEST(Peepholes, IDENTICAL_MUL_WITH_MANY_USERS)
     peepholes.Run();
 
     // Ensure that inputs CHANGED
-    ASSERT_EQ(v3->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v3->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v3->GetInput(0), v2);
+    ASSERT_EQ(v3->GetInput(1), v0);
 
     // Check that there are no users
     ASSERT_TRUE(v3->GetUsers().empty());
 
     // Ensure that add have no mul result as input
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v4->GetInput(0), v2);
+    ASSERT_EQ(v4->GetInput(1), v0);
 
-    ASSERT_EQ(v5->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v5->GetInputs()->GetInput(1), v2);
+    ASSERT_EQ(v5->GetInput(0), v2);
+    ASSERT_EQ(v5->GetInput(1), v2);
 
-    ASSERT_EQ(v6->GetInputs()->GetInput(0), v1);
-    ASSERT_EQ(v6->GetInputs()->GetInput(1), v2);
+    ASSERT_EQ(v6->GetInput(0), v1);
+    ASSERT_EQ(v6->GetInput(1), v2);
 }
 
 TEST(Peepholes, MUL_BY_TWO)
@@ -183,15 +183,15 @@ TEST(Peepholes, MUL_BY_TWO)
     auto *v5 = entryBB->GetLastInsn()->GetPrev();
 
     ASSERT_TRUE(v5->GetOpcode() == Opcode::ADD);
-    ASSERT_EQ(v5->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v5->GetInputs()->GetInput(1), v2);
+    ASSERT_EQ(v5->GetInput(0), v2);
+    ASSERT_EQ(v5->GetInput(1), v2);
 
-    auto v5users = v5->GetUsers();
+    auto &v5users = v5->GetUsers();
     ASSERT_EQ(v5users.size(), 1);
     ASSERT_EQ(v5users.front(), v4);
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v4->GetInput(0), v5);
+    ASSERT_EQ(v4->GetInput(1), v0);
 }
 
 TEST(Peepholes, MUL_BY_TWO_MANY_USERS)
@@ -236,27 +236,28 @@ TEST(Peepholes, MUL_BY_TWO_MANY_USERS)
     auto *v7 = entryBB->GetLastInsn()->GetPrev()->GetPrev()->GetPrev();
 
     ASSERT_TRUE(v7->GetOpcode() == Opcode::ADD);
-    ASSERT_EQ(v7->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v7->GetInputs()->GetInput(1), v2);
+    ASSERT_EQ(v7->GetInput(0), v2);
+    ASSERT_EQ(v7->GetInput(1), v2);
 
-    auto v7users = v7->GetUsers();
-    ASSERT_EQ(v7users.size(), 3);
+    // v5 uses v7 in both operands, so it occupies two nodes of the use list.
+    auto &v7users = v7->GetUsers();
+    ASSERT_EQ(v7users.size(), 4);
 
-    std::array<Instruction *, 3U> expectedUsers = {v4, v5, v6};
+    std::array<Instruction *, 4U> expectedUsers = {v4, v5, v5, v6};
     size_t idx = 0;
     for (auto *it : v7users) {
         ASSERT_EQ(it, expectedUsers[idx]);
         ++idx;
     }
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v7);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v4->GetInput(0), v7);
+    ASSERT_EQ(v4->GetInput(1), v0);
 
-    ASSERT_EQ(v5->GetInputs()->GetInput(0), v7);
-    ASSERT_EQ(v5->GetInputs()->GetInput(1), v7);
+    ASSERT_EQ(v5->GetInput(0), v7);
+    ASSERT_EQ(v5->GetInput(1), v7);
 
-    ASSERT_EQ(v6->GetInputs()->GetInput(0), v7);
-    ASSERT_EQ(v6->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v6->GetInput(0), v7);
+    ASSERT_EQ(v6->GetInput(1), v1);
 }
 
 TEST(Peepholes, ASHR_WITH_ZERO)
@@ -268,7 +269,7 @@ TEST(Peepholes, ASHR_WITH_ZERO)
     /*
         entryBB:
             // 0.i64 Constant 0
-            // 1.i64 Constant 120
+            // 1.i64 Parameter 0
             // 2.i64 add v0, v1
             // 3.i64 ashr v2, v0
             // 4.i64 sub v3, v1
@@ -276,7 +277,7 @@ TEST(Peepholes, ASHR_WITH_ZERO)
             // 6.i64 sub v5, v3
             // ==>
             // 0.i64 Constant 0
-            // 1.i64 Constant 120
+            // 1.i64 Parameter 0
             // 2.i64 add v0, v1
             // 4.i64 sub v2, v1
             // 5.i64 sub v4, v2
@@ -286,7 +287,7 @@ TEST(Peepholes, ASHR_WITH_ZERO)
     builder.SetBasicBlockScope(entryBB);
 
     auto *v0 = builder.CreateInt64ConstantInsn(0);
-    auto *v1 = builder.CreateInt64ConstantInsn(120);
+    auto *v1 = builder.CreateParameterInsn(0, DataType::I64);
     auto *v2 = builder.CreateAddInsn(DataType::I64, v0, v1);
     auto *v3 = builder.CreateAshrInsn(DataType::I64, v2, v0);
     auto *v4 = builder.CreateSubInsn(DataType::I64, v3, v1);
@@ -295,18 +296,18 @@ TEST(Peepholes, ASHR_WITH_ZERO)
 
     peepholes.Run();
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v2);
+    ASSERT_EQ(v4->GetInput(1), v1);
 
-    ASSERT_EQ(v5->GetInputs()->GetInput(0), v4);
-    ASSERT_EQ(v5->GetInputs()->GetInput(1), v2);
+    ASSERT_EQ(v5->GetInput(0), v4);
+    ASSERT_EQ(v5->GetInput(1), v2);
 
-    ASSERT_EQ(v6->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v6->GetInputs()->GetInput(1), v2);
+    ASSERT_EQ(v6->GetInput(0), v5);
+    ASSERT_EQ(v6->GetInput(1), v2);
 
     ASSERT_EQ(v3->GetUsers().size(), 0);
 
-    auto v2users = v2->GetUsers();
+    auto &v2users = v2->GetUsers();
     ASSERT_EQ(v2users.size(), 3);
 
     std::array<Instruction *, 3U> expectedUsers = {v4, v5, v6};
@@ -316,14 +317,14 @@ TEST(Peepholes, ASHR_WITH_ZERO)
         ++idx;
     }
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v2);
+    ASSERT_EQ(v4->GetInput(1), v1);
 
-    ASSERT_EQ(v5->GetInputs()->GetInput(0), v4);
-    ASSERT_EQ(v5->GetInputs()->GetInput(1), v2);
+    ASSERT_EQ(v5->GetInput(0), v4);
+    ASSERT_EQ(v5->GetInput(1), v2);
 
-    ASSERT_EQ(v6->GetInputs()->GetInput(0), v5);
-    ASSERT_EQ(v6->GetInputs()->GetInput(1), v2);
+    ASSERT_EQ(v6->GetInput(0), v5);
+    ASSERT_EQ(v6->GetInput(1), v2);
 }
 
 TEST(Peepholes, SEVERAL_ASHR_WITH_CONST)
@@ -336,14 +337,14 @@ TEST(Peepholes, SEVERAL_ASHR_WITH_CONST)
         entryBB:
             0.i64 Constant 12
             1.i64 Constant 10
-            2.i64 Constant 0
+            2.i64 Parameter 0
             3.i64 add v0, v2
             4.i64 ashr v3, v0
             5.i64 ashr v4, v1
             ==>
             0.i64 Constant 12
             1.i64 Constant 10
-            2.i64 Constant 0
+            2.i64 Parameter 0
             3.i64 add v0, v2
             4.i64 ashr v3, v0
             6.i64 Constant (v0 + v1)
@@ -354,7 +355,7 @@ TEST(Peepholes, SEVERAL_ASHR_WITH_CONST)
 
     auto *v0 = builder.CreateInt64ConstantInsn(12);
     auto *v1 = builder.CreateInt64ConstantInsn(10);
-    auto *v2 = builder.CreateInt64ConstantInsn(0);
+    auto *v2 = builder.CreateParameterInsn(0, DataType::I64);
 
     auto *v3 = builder.CreateAddInsn(DataType::I64, v0, v2);
     auto *v4 = builder.CreateAshrInsn(DataType::I64, v3, v0);
@@ -364,8 +365,8 @@ TEST(Peepholes, SEVERAL_ASHR_WITH_CONST)
 
     auto *v6 = entryBB->GetLastInsn();
 
-    ASSERT_EQ(v5->GetInputs()->GetInput(0), v3);
-    ASSERT_EQ(v5->GetInputs()->GetInput(1), v6);
+    ASSERT_EQ(v5->GetInput(0), v3);
+    ASSERT_EQ(v5->GetInput(1), v6);
 
     ASSERT_EQ(v6->GetUsers().size(), 1);
     ASSERT_EQ(v6->GetUsers().front(), v5);
@@ -393,13 +394,13 @@ TEST(Peepholes, OR_WITH_ZERO)
     /*
         entryBB:
             // 0.i64 Constant 0
-            // 1.i64 Constant 42
+            // 1.i64 Parameter 0
             // 2.i64 add v0, v1
             // 3.i64 or v2, v0
             // 4.i64 sub v3, v1
             ==>
             // 0.i64 Constant 0
-            // 1.i64 Constant 42
+            // 1.i64 Parameter 0
             // 2.i64 add v0, v1
             // 4.i64 sub v2, v1
     */
@@ -407,15 +408,15 @@ TEST(Peepholes, OR_WITH_ZERO)
     builder.SetBasicBlockScope(entryBB);
 
     auto *v0 = builder.CreateInt64ConstantInsn(0);
-    auto *v1 = builder.CreateInt64ConstantInsn(42);
+    auto *v1 = builder.CreateParameterInsn(0, DataType::I64);
     auto *v2 = builder.CreateAddInsn(DataType::I64, v0, v1);
     auto *v3 = builder.CreateOrInsn(DataType::I64, v2, v0);
     auto *v4 = builder.CreateSubInsn(DataType::I64, v3, v1);
 
     peepholes.Run();
 
-    ASSERT_EQ(v4->GetInputs()->GetInput(0), v2);
-    ASSERT_EQ(v4->GetInputs()->GetInput(1), v1);
+    ASSERT_EQ(v4->GetInput(0), v2);
+    ASSERT_EQ(v4->GetInput(1), v1);
 
     ASSERT_TRUE(v3->GetUsers().empty());
 
@@ -484,14 +485,13 @@ TEST(Peepholes, MUL_BY_TWO_WITH_PHI_USER)
     // mul x * 2 replaced by add x + x
     auto *v12 = bb1->GetFirstInsn();
     ASSERT_EQ(v12->GetOpcode(), Opcode::ADD);
-    ASSERT_EQ(v12->GetInputs()->GetInput(0), v0);
-    ASSERT_EQ(v12->GetInputs()->GetInput(1), v0);
+    ASSERT_EQ(v12->GetInput(0), v0);
+    ASSERT_EQ(v12->GetInput(1), v0);
 
     auto &v12users = v12->GetUsers();
     ASSERT_EQ(v12users.size(), 1);
     ASSERT_EQ(v12users.back(), v10);
 
-    auto &phiInputs = v10->GetInputs()->GetInputs();
     std::array<Instruction *, 2U> expectedPhiInputs = {v12, v6};
 
     auto findInExpectedArr = [&expectedPhiInputs](Instruction *it) {
@@ -503,8 +503,9 @@ TEST(Peepholes, MUL_BY_TWO_WITH_PHI_USER)
         return false;
     };
 
-    for (auto *it : phiInputs) {
-        ASSERT_TRUE(findInExpectedArr(it));
+    ASSERT_EQ(v10->GetInputsCount(), expectedPhiInputs.size());
+    for (auto &input : v10->GetInputs()) {
+        ASSERT_TRUE(findInExpectedArr(input.GetValue()));
     }
 }
 
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include "tests/test_helper.h"
+
+#include "ir/ir_builder-inl.h"
+#include "optimizations/sccp.h"
+
+namespace compiler::tests {
+
+static void AssertConstant(Instruction *insn, int64_t value)
+{
+    ASSERT_TRUE(insn->IsConst());
+    ASSERT_EQ(insn->AsConst()->GetAsI64(), value);
+}
+
+/*
+    BB_0: v0 = mul c3, c2; bgt v0, c5, BB_1, BB_2
+    BB_1: v1 = add p, c1; jmp BB_3
+    BB_2: v2 = sub p, c1; jmp BB_3
+    BB_3: v3 = phi(v1, BB_1; v2, BB_2); v4 = phi(v0, BB_1; c6, BB_2); ret ...
+
+    The branch is always taken, so both phis take values from BB_1 only.
+*/
+TEST(Sccp, ConstantBranch)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *thenBB = builder.CreateBB();
+    auto *elseBB = builder.CreateBB();
+    auto *joinBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *one = builder.CreateInt64ConstantInsn(1);
+    auto *two = builder.CreateInt64ConstantInsn(2);
+    auto *three = builder.CreateInt64ConstantInsn(3);
+    auto *five = builder.CreateInt64ConstantInsn(5);
+    auto *mul = builder.CreateMulInsn(DataType::I64, three, two);
+    builder.CreateBgtInsn(mul, five, thenBB, elseBB);
+
+    builder.SetBasicBlockScope(thenBB);
+    auto *add = builder.CreateAddInsn(DataType::I64, param, one);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(elseBB);
+    auto *sub = builder.CreateSubInsn(DataType::I64, param, one);
+    auto *seven = builder.CreateInt64ConstantInsn(7);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(joinBB);
+    auto *phi = builder.CreatePhiInsn(DataType::I64);
+    phi->ResolveDependency(add, thenBB);
+    phi->ResolveDependency(sub, elseBB);
+    auto *constPhi = builder.CreatePhiInsn(DataType::I64);
+    constPhi->ResolveDependency(mul, thenBB);
+    constPhi->ResolveDependency(seven, elseBB);
+    auto *sum = builder.CreateAddInsn(DataType::I64, phi, constPhi);
+    auto *ret = builder.CreateRetInsn(DataType::I64, sum);
+
+    Sccp(&graph).Run();
+
+    ASSERT_EQ(graph.GetAliveBlockCount(), 3U);
+    ASSERT_TRUE(entryBB->GetLastInsn()->IsJmp());
+    ASSERT_EQ(entryBB->GetSuccessors().size(), 1U);
+    ASSERT_EQ(entryBB->GetSuccessors()[0], thenBB);
+    ASSERT_EQ(joinBB->GetPredecessors().size(), 1U);
+    CompareInputs<1U>(phi, {add});
+    ASSERT_EQ(ret->GetInput(0), sum);
+    ASSERT_EQ(sum->GetInput(0), phi);
+    AssertConstant(sum->GetInput(1), 6);
+    ASSERT_TRUE(sum->GetInput(1)->GetPrev()->IsPhi());
+}
+
+/*
+    BB_0: jmp BB_1
+    BB_1: v0 = phi(c0, BB_0; v3, BB_2); v1 = phi(c1, BB_0; v2, BB_2); bgt v0, p, BB_2, BB_3
+    BB_2: v2 = mul v1, c1; v3 = add v0, c1; beq v2, c1, BB_1, BB_4
+    BB_3: ret v1
+    BB_4: ret v0
+
+    v1 stays 1 around the loop, so the exit from BB_2 is never taken.
+*/
+TEST(Sccp, Loop)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *headerBB = builder.CreateBB();
+    auto *bodyBB = builder.CreateBB();
+    auto *exitBB = builder.CreateBB();
+    auto *deadBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I32);
+    auto *zero = builder.CreateInt32ConstantInsn(0);
+    auto *one = builder.CreateInt32ConstantInsn(1);
+    builder.CreateJmpInsn(headerBB);
+
+    builder.SetBasicBlockScope(headerBB);
+    auto *idx = builder.CreatePhiInsn(DataType::I32);
+    auto *value = builder.CreatePhiInsn(DataType::I32);
+    builder.CreateBgtInsn(idx, param, bodyBB, exitBB);
+
+    builder.SetBasicBlockScope(bodyBB);
+    auto *nextValue = builder.CreateMulInsn(DataType::I32, value, one);
+    auto *nextIdx = builder.CreateAddInsn(DataType::I32, idx, one);
+    builder.CreateBeqInsn(nextValue, one, headerBB, deadBB);
+
+    builder.SetBasicBlockScope(exitBB);
+    auto *ret = builder.CreateRetInsn(DataType::I32, value);
+
+    builder.SetBasicBlockScope(deadBB);
+    builder.CreateRetInsn(DataType::I32, idx);
+
+    idx->ResolveDependency(zero, entryBB);
+    idx->ResolveDependency(nextIdx, bodyBB);
+    value->ResolveDependency(one, entryBB);
+    value->ResolveDependency(nextValue, bodyBB);
+
+    Sccp(&graph).Run();
+
+    ASSERT_EQ(graph.GetAliveBlockCount(), 4U);
+    AssertConstant(ret->GetInput(0), 1);
+    ASSERT_TRUE(bodyBB->GetLastInsn()->IsJmp());
+    ASSERT_EQ(bodyBB->GetSuccessors()[0], headerBB);
+    CompareInputs<2U>(idx, {zero, nextIdx});
+}
+
+// Division by zero is left to the runtime, shift amounts are masked by the width, narrow results wrap around.
+TEST(Sccp, Folding)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    builder.SetBasicBlockScope(builder.CreateBB());
+    auto *zero = builder.CreateInt32ConstantInsn(0);
+    auto *max = builder.CreateInt32ConstantInsn(INT32_MAX);
+    auto *width = builder.CreateInt32ConstantInsn(32);
+    auto *div = builder.CreateDivInsn(DataType::I32, max, zero);
+    auto *shl = builder.CreateShlInsn(DataType::I32, max, width);
+    auto *add = builder.CreateAddInsn(DataType::I32, max, max);
+    auto *shr = builder.CreateShrInsn(DataType::I32, add, builder.CreateInt32ConstantInsn(28));
+    auto *ashr = builder.CreateAshrInsn(DataType::I32, add, builder.CreateInt32ConstantInsn(28));
+    auto *call = builder.CreateCallStaticInsn(DataType::VOID, graph.GetMethodId(),
+                                              {{div, DataType::I32},
+                                               {shl, DataType::I32},
+                                               {shr, DataType::I32},
+                                               {ashr, DataType::I32}});
+    builder.CreateRetInsn(DataType::VOID);
+
+    Sccp(&graph).Run();
+
+    ASSERT_EQ(call->GetInput(0), div);
+    AssertConstant(call->GetInput(1), INT32_MAX);
+    AssertConstant(call->GetInput(2), 0xf);
+    AssertConstant(call->GetInput(3), -1);
+}
+
+/*
+    BB_0: v0 = mul c3, c2; v1 = add c4, c2; bgt p, p, BB_1, BB_2
+    BB_1: jmp BB_3
+    BB_2: jmp BB_3
+    BB_3: v2 = phi(v0, BB_1; v1, BB_2); ret v2
+
+    v1 is replaced with v0 beforehand, as a previous pass would do, so the phi merges v0 from both blocks.
+*/
+TEST(Sccp, PhiWithEqualInputs)
+{
+    Graph graph;
+    IrBuilder builder(&graph);
+
+    auto *entryBB = builder.CreateBB();
+    auto *thenBB = builder.CreateBB();
+    auto *elseBB = builder.CreateBB();
+    auto *joinBB = builder.CreateBB();
+
+    builder.SetBasicBlockScope(entryBB);
+    auto *param = builder.CreateParameterInsn(0, DataType::I64);
+    auto *two = builder.CreateInt64ConstantInsn(2);
+    auto *three = builder.CreateInt64ConstantInsn(3);
+    auto *four = builder.CreateInt64ConstantInsn(4);
+    auto *mul = builder.CreateMulInsn(DataType::I64, three, two);
+    auto *add = builder.CreateAddInsn(DataType::I64, four, two);
+    builder.CreateBgtInsn(param, param, thenBB, elseBB);
+
+    builder.SetBasicBlockScope(thenBB);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(elseBB);
+    builder.CreateJmpInsn(joinBB);
+
+    builder.SetBasicBlockScope(joinBB);
+    auto *phi = builder.CreatePhiInsn(DataType::I64);
+    phi->ResolveDependency(mul, thenBB);
+    phi->ResolveDependency(add, elseBB);
+    auto *ret = builder.CreateRetInsn(DataType::I64, phi);
+
+    add->ReplaceInputsForUsers(mul);
+    entryBB->Remove(add);
+    CompareInputs<1U>(phi, {mul});
+
+    Sccp(&graph).Run();
+
+    AssertConstant(ret->GetInput(0), 6);
+    ASSERT_TRUE(mul->GetUsers().empty());
+    ASSERT_TRUE(phi->GetUsers().empty());
+}
+
+}  // namespace compiler::tests
@@ -19,17 +19,10 @@ inline void CompareInputs(Instruction *insnToCheck, std::array<Instruction *, ex
 {
     ASSERT_NE(insnToCheck, nullptr);
 
-    if (insnToCheck->HasVectorInputs()) {
-        auto &inputs = insnToCheck->GetInputs()->AsVectorInputs()->GetInputs();
-        ASSERT_EQ(inputs.size(), expectedInputs.size());
-
-        for (size_t idx = 0; idx < inputs.size(); ++idx) {
-            ASSERT_EQ(inputs[idx]->GetId(), expectedInputs[idx]->GetId());
-        }
-    } else {
-        ASSERT_EQ(expectedInputs.size(), 2);
-        ASSERT_EQ(insnToCheck->GetInputs()->GetInput(0)->GetId(), expectedInputs[0]->GetId());
-        ASSERT_EQ(insnToCheck->GetInputs()->GetInput(1)->GetId(), expectedInputs[1]->GetId());
+    ASSERT_EQ(insnToCheck->GetInputsCount(), expectedInputs.size());
+
+    for (size_t idx = 0; idx < expectedInputs.size(); ++idx) {
+        ASSERT_EQ(insnToCheck->GetInput(idx)->GetId(), expectedInputs[idx]->GetId());
     }
 }
 
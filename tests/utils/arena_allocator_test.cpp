@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "utils/arena_allocator.h"
+#include "ir/ir_builder-inl.h"
+
+namespace utils::tests {
+
+TEST(ArenaAllocator, Alignment)
+{
+    ArenaAllocator allocator;
+
+    auto *byte = allocator.Alloc(1U, 1U);
+    auto *word = allocator.Alloc(sizeof(uint64_t), alignof(uint64_t));
+    auto *wide = allocator.Alloc(1U, 64U);
+
+    ASSERT_NE(byte, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(word) % alignof(uint64_t), 0U);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(wide) % 64U, 0U);
+    ASSERT_EQ(allocator.GetAllocatedSize(), 1U + sizeof(uint64_t) + 1U);
+}
+
+TEST(ArenaAllocator, BigAllocation)
+{
+    ArenaAllocator allocator;
+
+    constexpr size_t BIG_SIZE = 4U * ArenaPool::DEFAULT_CHUNK_SIZE;
+    auto *big = static_cast<uint8_t *>(allocator.Alloc(BIG_SIZE));
+    big[0] = 1U;
+    big[BIG_SIZE - 1] = 1U;
+
+    auto *small = allocator.New<uint64_t>(42U);
+    ASSERT_EQ(*small, 42U);
+}
+
+TEST(ArenaAllocator, ArenaContainers)
+{
+    ArenaAllocator allocator;
+
+    ArenaVector<int> vec(allocator.Adapter<int>());
+    ArenaList<int> list(allocator.Adapter<int>());
+    ArenaUnorderedMap<int, int> map(allocator.Adapter());
+
+    for (int idx = 0; idx < 1000; ++idx) {
+        vec.push_back(idx);
+        list.push_back(idx);
+        map.emplace(idx, idx * 2);
+    }
+
+    ASSERT_EQ(vec.size(), 1000U);
+    ASSERT_EQ(list.size(), 1000U);
+    ASSERT_EQ(map.at(500), 1000);
+    ASSERT_GT(allocator.GetAllocatedSize(), 1000U * sizeof(int));
+}
+
+TEST(ArenaAllocator, ChunksAreRecycledBetweenGraphs)
+{
+    auto &pool = ArenaPool::GetCurrent();
+
+    auto buildGraph = []() {
+        compiler::Graph graph;
+        compiler::IrBuilder builder(&graph);
+
+        auto *bb = builder.CreateBB();
+        builder.SetBasicBlockScope(bb);
+
+        auto *acc = builder.CreateInt64ConstantInsn(1);
+        for (int idx = 0; idx < 10000; ++idx) {
+            acc = builder.CreateAddInsn(compiler::DataType::I64, acc, acc);
+        }
+        builder.CreateRetInsn(compiler::DataType::I64, acc);
+    };
+
+    buildGraph();
+    size_t cachedAfterFirst = pool.GetCachedChunkCount();
+    ASSERT_GT(cachedAfterFirst, 0U);
+
+    // The second graph of the same size must be fully served from the pool.
+    buildGraph();
+    ASSERT_EQ(pool.GetCachedChunkCount(), cachedAfterFirst);
+}
+
+}  // namespace utils::tests
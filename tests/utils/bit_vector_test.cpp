@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "utils/bit_vector.h"
+
+#include <vector>
+
+namespace utils::tests {
+
+TEST(BitVector, SetResetTest)
+{
+    BitVector bits(130U);
+    ASSERT_EQ(bits.Count(), 0U);
+
+    bits.Set(0U);
+    bits.Set(64U);
+    bits.Set(129U);
+    ASSERT_TRUE(bits.Test(0U));
+    ASSERT_TRUE(bits.Test(64U));
+    ASSERT_TRUE(bits.Test(129U));
+    ASSERT_FALSE(bits.Test(63U));
+    ASSERT_EQ(bits.Count(), 3U);
+
+    bits.Reset(64U);
+    ASSERT_FALSE(bits.Test(64U));
+
+    std::vector<size_t> setBits;
+    bits.ForEachSetBit([&setBits](size_t idx) { setBits.push_back(idx); });
+    ASSERT_EQ(setBits, (std::vector<size_t> {0U, 129U}));
+
+    bits.Clear();
+    ASSERT_EQ(bits.Count(), 0U);
+}
+
+TEST(BitVector, Union)
+{
+    BitVector lhs(100U);
+    BitVector rhs(100U);
+    lhs.Set(1U);
+    rhs.Set(1U);
+
+    ASSERT_FALSE(lhs.Union(rhs));
+
+    rhs.Set(99U);
+    ASSERT_TRUE(lhs.Union(rhs));
+    ASSERT_TRUE(lhs.Test(99U));
+    ASSERT_EQ(lhs.Count(), 2U);
+}
+
+}  // namespace utils::tests
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "utils/small_vector.h"
+
+namespace utils::tests {
+
+TEST(SmallVector, InlineStorage)
+{
+    ArenaAllocator allocator;
+    SmallVector<uint64_t, 4U> vec(&allocator);
+
+    for (uint64_t idx = 0; idx < 4U; ++idx) {
+        vec.push_back(idx * 2U);
+    }
+
+    ASSERT_TRUE(vec.IsInline());
+    ASSERT_EQ(vec.size(), 4U);
+    ASSERT_EQ(vec[3], 6U);
+    ASSERT_EQ(allocator.GetAllocatedSize(), 0U);
+}
+
+TEST(SmallVector, SpillToArena)
+{
+    ArenaAllocator allocator;
+    SmallVector<uint64_t, 2U> vec(&allocator);
+
+    for (uint64_t idx = 0; idx < 100U; ++idx) {
+        vec.emplace_back(idx);
+    }
+
+    ASSERT_FALSE(vec.IsInline());
+    ASSERT_EQ(vec.size(), 100U);
+    ASSERT_GE(vec.capacity(), 100U);
+    ASSERT_NE(allocator.GetAllocatedSize(), 0U);
+
+    uint64_t expected = 0;
+    for (auto value : vec) {
+        ASSERT_EQ(value, expected++);
+    }
+}
+
+TEST(SmallVector, Reserve)
+{
+    ArenaAllocator allocator;
+    SmallVector<uint64_t, 2U> vec(&allocator);
+
+    vec.push_back(1U);
+    vec.reserve(10U);
+    ASSERT_FALSE(vec.IsInline());
+    ASSERT_EQ(vec.capacity(), 10U);
+    ASSERT_EQ(vec.back(), 1U);
+
+    auto *data = vec.data();
+    for (uint64_t idx = 1; idx < 10U; ++idx) {
+        vec.push_back(idx);
+    }
+    ASSERT_EQ(vec.data(), data);
+}
+
+}  // namespace utils::tests
@@ -0,0 +1,92 @@
+#include "utils/arena_allocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace utils {
+
+ArenaPool::~ArenaPool()
+{
+    while (freeChunks_ != nullptr) {
+        auto *next = freeChunks_->next;
+        std::free(freeChunks_);
+        freeChunks_ = next;
+    }
+}
+
+ArenaPool &ArenaPool::GetCurrent()
+{
+    thread_local ArenaPool pool;
+    return pool;
+}
+
+ArenaChunk *ArenaPool::AcquireChunk(size_t minSize)
+{
+    if (minSize <= DEFAULT_CHUNK_SIZE && freeChunks_ != nullptr) {
+        auto *chunk = freeChunks_;
+        freeChunks_ = chunk->next;
+        chunk->next = nullptr;
+        --cachedChunkCount_;
+        return chunk;
+    }
+
+    size_t chunkSize = std::max(minSize, DEFAULT_CHUNK_SIZE);
+    void *mem = std::malloc(sizeof(ArenaChunk) + chunkSize);
+    if (UNLIKELY(mem == nullptr)) {
+        std::cerr << "ArenaPool: out of memory" << std::endl;
+        std::abort();
+    }
+
+    auto *chunk = new (mem) ArenaChunk();
+    chunk->size = chunkSize;
+    return chunk;
+}
+
+void ArenaPool::ReleaseChunk(ArenaChunk *chunk)
+{
+    assert(chunk != nullptr);
+
+    // Only default-sized chunks are cached, oversized ones were requested for a single big allocation.
+    if (chunk->size != DEFAULT_CHUNK_SIZE) {
+        std::free(chunk);
+        return;
+    }
+
+    chunk->next = freeChunks_;
+    freeChunks_ = chunk;
+    ++cachedChunkCount_;
+}
+
+void ArenaAllocator::Reset()
+{
+    auto &pool = ArenaPool::GetCurrent();
+    while (chunks_ != nullptr) {
+        auto *next = chunks_->next;
+        pool.ReleaseChunk(chunks_);
+        chunks_ = next;
+    }
+
+    current_ = nullptr;
+    end_ = nullptr;
+    allocatedSize_ = 0;
+}
+
+void *ArenaAllocator::AllocSlow(size_t size, size_t align)
+{
+    assert(align != 0 && (align & (align - 1)) == 0);
+
+    // Data of a chunk is aligned to max_align_t, reserve extra space only for stricter alignments.
+    size_t extra = align > alignof(std::max_align_t) ? align : 0;
+    auto *chunk = ArenaPool::GetCurrent().AcquireChunk(size + extra);
+
+    chunk->next = chunks_;
+    chunks_ = chunk;
+
+    current_ = chunk->GetData();
+    end_ = current_ + chunk->size;
+
+    return Alloc(size, align);
+}
+
+}  // namespace utils
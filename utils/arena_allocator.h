@@ -0,0 +1,181 @@
+#ifndef UTILS_ARENA_ALLOCATOR_H
+#define UTILS_ARENA_ALLOCATOR_H
+
+#include "utils/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+struct alignas(std::max_align_t) ArenaChunk final {
+    ArenaChunk *next {nullptr};
+    size_t size {0};
+
+    uint8_t *GetData()
+    {
+        return reinterpret_cast<uint8_t *>(this + 1);
+    }
+};
+
+// Thread-local cache of arena chunks.
+// Chunks of the default size are never returned to the OS while the thread is alive,
+// so consecutive compilations on the same thread reuse the same memory.
+class ArenaPool final {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64U * 1024U;
+
+public:
+    NO_COPY_SEMANTIC(ArenaPool);
+    NO_MOVE_SEMANTIC(ArenaPool);
+
+    ArenaPool() = default;
+    ~ArenaPool();
+
+    static ArenaPool &GetCurrent();
+
+    ArenaChunk *AcquireChunk(size_t minSize);
+    void ReleaseChunk(ArenaChunk *chunk);
+
+    size_t GetCachedChunkCount() const
+    {
+        return cachedChunkCount_;
+    }
+
+private:
+    ArenaChunk *freeChunks_ {nullptr};
+    size_t cachedChunkCount_ {0};
+};
+
+template <typename T>
+class ArenaStdAllocator;
+
+// Bump-pointer allocator.
+// Memory is released only all at once, when the allocator is destroyed or reset.
+// Objects created with `New` are never destroyed individually, so everything they own must live in the arena too.
+class ArenaAllocator final {
+public:
+    static constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+public:
+    NO_COPY_SEMANTIC(ArenaAllocator);
+    NO_MOVE_SEMANTIC(ArenaAllocator);
+
+    ArenaAllocator() = default;
+    ~ArenaAllocator()
+    {
+        Reset();
+    }
+
+    void *Alloc(size_t size, size_t align = DEFAULT_ALIGNMENT)
+    {
+        auto curr = reinterpret_cast<uintptr_t>(current_);
+        auto aligned = (curr + align - 1) & ~(align - 1);
+
+        if (LIKELY(current_ != nullptr && aligned + size <= reinterpret_cast<uintptr_t>(end_))) {
+            current_ = reinterpret_cast<uint8_t *>(aligned + size);
+            allocatedSize_ += size;
+            return reinterpret_cast<void *>(aligned);
+        }
+        return AllocSlow(size, align);
+    }
+
+    template <typename T, typename... Args>
+    T *New(Args &&...args)
+    {
+        void *mem = Alloc(sizeof(T), alignof(T));
+        return new (mem) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T *AllocArray(size_t count)
+    {
+        return static_cast<T *>(Alloc(sizeof(T) * count, alignof(T)));
+    }
+
+    template <typename T = void>
+    ArenaStdAllocator<T> Adapter()
+    {
+        return ArenaStdAllocator<T>(this);
+    }
+
+    /// Return all chunks to the thread-local pool.
+    void Reset();
+
+    /// Number of bytes handed out by `Alloc` since construction or the last `Reset`.
+    size_t GetAllocatedSize() const
+    {
+        return allocatedSize_;
+    }
+
+private:
+    void *AllocSlow(size_t size, size_t align);
+
+private:
+    uint8_t *current_ {nullptr};
+    uint8_t *end_ {nullptr};
+
+    ArenaChunk *chunks_ {nullptr};
+
+    size_t allocatedSize_ {0};
+};
+
+// STL-compatible adapter over ArenaAllocator, deallocation is a no-op.
+template <typename T>
+class ArenaStdAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaStdAllocator(ArenaAllocator *arena) : arena_(arena) {}
+
+    template <typename U>
+    ArenaStdAllocator(const ArenaStdAllocator<U> &other) : arena_(other.GetArena())
+    {
+    }
+
+    T *allocate(size_t count)
+    {
+        return arena_->AllocArray<T>(count);
+    }
+
+    void deallocate([[maybe_unused]] T *ptr, [[maybe_unused]] size_t count) {}
+
+    ArenaAllocator *GetArena() const
+    {
+        return arena_;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaStdAllocator<U> &other) const
+    {
+        return arena_ == other.GetArena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaStdAllocator<U> &other) const
+    {
+        return arena_ != other.GetArena();
+    }
+
+private:
+    ArenaAllocator *arena_ {nullptr};
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaStdAllocator<T>>;
+
+template <typename T>
+using ArenaList = std::list<T, ArenaStdAllocator<T>>;
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+using ArenaUnorderedMap = std::unordered_map<K, V, Hash, KeyEqual, ArenaStdAllocator<std::pair<const K, V>>>;
+
+}  // namespace utils
+
+#endif  // UTILS_ARENA_ALLOCATOR_H
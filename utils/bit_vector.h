@@ -0,0 +1,99 @@
+#ifndef UTILS_BIT_VECTOR_H
+#define UTILS_BIT_VECTOR_H
+
+#include "utils/macros.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+// Fixed-size set of bits, set operations work on whole words.
+class BitVector final {
+public:
+    DEFAULT_COPY_SEMANTIC(BitVector);
+    DEFAULT_MOVE_SEMANTIC(BitVector);
+
+    BitVector() = default;
+    explicit BitVector(size_t size) : words_((size + WORD_BITS - 1) / WORD_BITS, 0), size_(size) {}
+    ~BitVector() = default;
+
+    void Set(size_t idx)
+    {
+        assert(idx < size_);
+        words_[idx / WORD_BITS] |= GetMask(idx);
+    }
+
+    void Reset(size_t idx)
+    {
+        assert(idx < size_);
+        words_[idx / WORD_BITS] &= ~GetMask(idx);
+    }
+
+    bool Test(size_t idx) const
+    {
+        assert(idx < size_);
+        return (words_[idx / WORD_BITS] & GetMask(idx)) != 0;
+    }
+
+    // Returns whether any bit was added.
+    bool Union(const BitVector &other)
+    {
+        assert(size_ == other.size_);
+        uint64_t added = 0;
+        for (size_t idx = 0; idx < words_.size(); ++idx) {
+            added |= other.words_[idx] & ~words_[idx];
+            words_[idx] |= other.words_[idx];
+        }
+        return added != 0;
+    }
+
+    void Clear()
+    {
+        std::fill(words_.begin(), words_.end(), 0);
+    }
+
+    size_t Count() const
+    {
+        size_t count = 0;
+        for (auto word : words_) {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        return count;
+    }
+
+    // Calls `callback(idx)` for set bits in increasing order.
+    template <typename Callback>
+    void ForEachSetBit(Callback callback) const
+    {
+        for (size_t wordIdx = 0; wordIdx < words_.size(); ++wordIdx) {
+            for (auto word = words_[wordIdx]; word != 0; word &= word - 1) {
+                callback(wordIdx * WORD_BITS + static_cast<size_t>(std::countr_zero(word)));
+            }
+        }
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+private:
+    static constexpr size_t WORD_BITS = 64U;
+
+    static uint64_t GetMask(size_t idx)
+    {
+        return uint64_t {1} << (idx % WORD_BITS);
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    size_t size_ {0};
+};
+
+}  // namespace utils
+
+#endif  // UTILS_BIT_VECTOR_H
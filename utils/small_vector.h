@@ -0,0 +1,159 @@
+#ifndef UTILS_SMALL_VECTOR_H
+#define UTILS_SMALL_VECTOR_H
+
+#include "utils/arena_allocator.h"
+#include "utils/macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace utils {
+
+// Vector which keeps up to `N` elements inside the object and moves them to the arena once they don't fit.
+// Elements are relocated with their move constructor, so it may be used for self-linking types.
+template <typename T, size_t N>
+class SmallVector final {
+    static_assert(N != 0, "use ArenaVector for empty inline storage");
+
+public:
+    NO_COPY_SEMANTIC(SmallVector);
+    NO_MOVE_SEMANTIC(SmallVector);
+
+    explicit SmallVector(ArenaAllocator *allocator) : allocator_(allocator) {}
+
+    ~SmallVector()
+    {
+        std::destroy_n(data_, size_);
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (UNLIKELY(size_ == capacity_)) {
+            Grow(capacity_ * 2U);
+        }
+        auto *elem = new (data_ + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return *elem;
+    }
+
+    void push_back(const T &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        assert(size_ != 0);
+        --size_;
+        data_[size_].~T();
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > capacity_) {
+            Grow(capacity);
+        }
+    }
+
+    T &operator[](size_t idx)
+    {
+        assert(idx < size_);
+        return data_[idx];
+    }
+
+    const T &operator[](size_t idx) const
+    {
+        assert(idx < size_);
+        return data_[idx];
+    }
+
+    T &back()
+    {
+        assert(size_ != 0);
+        return data_[size_ - 1];
+    }
+
+    T *data()
+    {
+        return data_;
+    }
+
+    const T *data() const
+    {
+        return data_;
+    }
+
+    T *begin()
+    {
+        return data_;
+    }
+
+    T *end()
+    {
+        return data_ + size_;
+    }
+
+    const T *begin() const
+    {
+        return data_;
+    }
+
+    const T *end() const
+    {
+        return data_ + size_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    bool IsInline() const
+    {
+        return data_ == reinterpret_cast<const T *>(inlineStorage_);
+    }
+
+private:
+    void Grow(size_t capacity)
+    {
+        auto *newData = allocator_->AllocArray<T>(capacity);
+        for (size_t idx = 0; idx < size_; ++idx) {
+            new (newData + idx) T(std::move(data_[idx]));
+            data_[idx].~T();
+        }
+        // Arena memory of the previous heap buffer is reclaimed together with the arena.
+        data_ = newData;
+        capacity_ = capacity;
+    }
+
+private:
+    ArenaAllocator *allocator_ {nullptr};
+    T *data_ {reinterpret_cast<T *>(inlineStorage_)};
+    size_t size_ {0};
+    size_t capacity_ {N};
+
+    alignas(T) std::byte inlineStorage_[N * sizeof(T)];
+};
+
+}  // namespace utils
+
+#endif  // UTILS_SMALL_VECTOR_H